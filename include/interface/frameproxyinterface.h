@@ -32,6 +32,11 @@ public:
 
     virtual void setRemoveableDeviceStatus(QString type, bool state) = 0;
     virtual bool getRemoveableDeviceStatus(QString type) const = 0;
+
+    // 声明页面可缓存，弹出时隐藏保留而不销毁，path 用于区分同一模块的不同页面
+    virtual void setPageCacheable(ModuleInterface *const, QWidget *const, const QString &) {}
+    // 取回缓存的页面，没有时返回 nullptr
+    virtual QWidget *takeCachedPage(ModuleInterface *const, const QString &) { return nullptr; }
 public:
     ModuleInterface *currModule() const { return m_currModule; }
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DCC_WIDGETS_LONGTEXTVIEW_H
+#define DCC_WIDGETS_LONGTEXTVIEW_H
+
+#include <QWidget>
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+class QTextLayout;
+class QTimer;
+
+namespace dcc {
+namespace widgets {
+
+/**
+ * @brief LongTextView 显示协议等长篇纯文本的只读控件，放在滚动区域中使用
+ *
+ * 高度由 heightForWidth() 给出。绘制时只排版可见区域及上下各一屏的段落，其余段落在空闲时分批排版，
+ * 尚未排版的段落按字符数估算高度；各宽度下的段落高度会被缓存，来回调整宽度时不需要重新排版全文。
+ * 支持鼠标选择、全选和复制。
+ */
+class LongTextView : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit LongTextView(QWidget *parent = nullptr);
+    ~LongTextView() override;
+
+    QString text() const { return m_text; }
+    void setText(const QString &text);
+
+    QString selectedText() const;
+    bool hasSelectedText() const { return m_selectionStart != m_selectionEnd; }
+    void selectAll();
+    void copy() const;
+
+    bool hasHeightForWidth() const override { return true; }
+    int heightForWidth(int width) const override;
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void changeEvent(QEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    struct Paragraph {
+        int start;
+        int length;
+        // 用于估算高度的窄字符和宽字符（CJK 等）数量
+        int narrowCount;
+        int wideCount;
+    };
+
+    int textWidth(int width) const;
+    int estimatedHeight(const Paragraph &paragraph, int textWidth) const;
+    int paragraphHeight(int index, int textWidth) const;
+    void updateOffsets();
+    QTextLayout *ensureLayout(int index, bool *heightChanged = nullptr);
+    void layoutRange(int top, int bottom);
+    void layoutPending();
+    void resetLayouts();
+    int paragraphAt(int y) const;
+    int positionAt(const QPoint &pos);
+    void setSelection(int start, int end);
+
+private:
+    QString m_text;
+    QVector<Paragraph> m_paragraphs;
+
+    // 以下为当前宽度下的排版结果，m_offsets 比段落数多一项，末项为总高度
+    int m_layoutWidth;
+    QVector<int> m_offsets;
+    QVector<QSharedPointer<QTextLayout>> m_layouts;
+    // 各宽度下已排版段落的准确高度，未排版的为 -1
+    QHash<int, QVector<int>> m_heightCache;
+
+    QTimer *m_idleTimer;
+    int m_nextPending;
+
+    int m_selectionStart;
+    int m_selectionEnd;
+    int m_selectionAnchor;
+    bool m_selecting;
+};
+
+} // namespace widgets
+} // namespace dcc
+
+#endif // DCC_WIDGETS_LONGTEXTVIEW_H
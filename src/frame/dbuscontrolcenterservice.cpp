@@ -40,6 +40,7 @@
 
 #include "modules/display/displaymodel.h"
 #include "modules/display/displayworker.h"
+#include "modules/common/dbustelemetry.h"
 
 #include <QtCore/QMetaObject>
 #include <QtCore/QByteArray>
@@ -53,6 +54,7 @@
 #include <qpa/qplatformwindow.h>
 #include <QScreen>
 #include <QString>
+#include <QJsonDocument>
 
 #include <unistd.h>
 
@@ -189,3 +191,22 @@ bool DBusControlCenterService::isModuleAvailable(const QString &m)
     return parent()->isModuleAvailable(m);
 }
 
+QString DBusControlCenterService::GetDBusStatistics()
+{
+    return QString::fromUtf8(QJsonDocument(dcc::DBusTelemetry::instance()->statistics()).toJson(QJsonDocument::Compact));
+}
+
+QString DBusControlCenterService::DumpDBusStatistics(const QString &fileName)
+{
+    return dcc::DBusTelemetry::instance()->dumpToFile(fileName);
+}
+
+void DBusControlCenterService::ResetDBusStatistics()
+{
+    dcc::DBusTelemetry::instance()->reset();
+}
+
+QString DBusControlCenterService::GetStartupStatistics()
+{
+    return QString::fromUtf8(QJsonDocument(parent()->preInitializeStatistics()).toJson(QJsonDocument::Compact));
+}
@@ -92,6 +92,13 @@ public Q_SLOTS: // METHODS
     void ToggleInLeft();
     bool isNetworkCanShowPassword();
     bool isModuleAvailable(const QString &m);
+    // D-Bus 调用耗时统计，返回 JSON 字符串
+    QString GetDBusStatistics();
+    // 将统计结果写入缓存目录下的 fileName，为空时使用默认文件名，返回实际写入的路径
+    QString DumpDBusStatistics(const QString &fileName);
+    void ResetDBusStatistics();
+    // 启动时各模块 preInitialize 的耗时，返回 JSON 字符串
+    QString GetStartupStatistics();
 
 Q_SIGNALS: // SIGNALS
     void rectChanged(const QRect &rect);
@@ -26,6 +26,7 @@
 #include "dbuscontrolcenterservice.h"
 #include "window/mainwindow.h"
 #include "window/accessible.h"
+#include "modules/common/dbustelemetry.h"
 
 #include <DApplication>
 #include <DDBusSender>
@@ -131,6 +132,9 @@ int main(int argc, char *argv[])
 
     QAccessible::installFactory(accessibleFactory);
 
+    // 工作线程中的 D-Bus 调用也会计入统计，单例需要先在主线程创建
+    dcc::DBusTelemetry::instance();
+
     QGSettings gs(ControlCenterGSettings, QByteArray(), app);
     auto w = gs.get(GSettinsWindowWidth).toInt();
     auto h = gs.get(GSettinsWindowHeight).toInt();
@@ -27,6 +27,7 @@
 #include "user.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
+#include "modules/common/dbustelemetry.h"
 
 #include <QFileDialog>
 #include <QtConcurrent>
@@ -51,6 +52,16 @@ const QString AccountsService("com.deepin.daemon.Accounts");
 const QString FingerPrintService("com.deepin.daemon.Authenticate");
 const QString DisplayManagerService("org.freedesktop.DisplayManager");
 
+const QString AccountsUserInterface("com.deepin.daemon.Accounts.User");
+const QString PropertiesInterface("org.freedesktop.DBus.Properties");
+
+// 首次打开用户列表时加载的用户数
+const int InitialUserCount = 50;
+// 每次异步请求的用户数
+const int UserBatchSize = 20;
+// 可见区域之后预先加载的用户数
+const int UserPrefetchCount = 30;
+
 const QString AutoLoginVisable = "auto-login-visable";
 const QString NoPasswordVisable = "nopasswd-login-visable";
 
@@ -63,6 +74,7 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
 #endif
     , m_dmInter(new DisplayManager(DisplayManagerService, "/org/freedesktop/DisplayManager", QDBusConnection::systemBus(), this))
     , m_userModel(userList)
+    , m_loadTarget(InitialUserCount)
 {
     struct passwd *pws;
     pws = getpwuid(getuid());
@@ -79,9 +91,30 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
 #ifdef DCC_ENABLE_ADDOMAIN
     m_notifyInter->setSync(false);
 #endif
-    QDBusInterface interface(AccountsService, "/com/deepin/daemon/Accounts", AccountsService, QDBusConnection::systemBus());
-    onUserListChanged(interface.property("UserList").toStringList());
-    updateUserOnlineStatus(m_dmInter->sessions());
+    QDBusMessage userListMsg = QDBusMessage::createMethodCall(AccountsService, "/com/deepin/daemon/Accounts", PropertiesInterface, "Get");
+    userListMsg << AccountsService << "UserList";
+    QDBusPendingCallWatcher *userListWatcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(userListMsg), this);
+    connect(userListWatcher, &QDBusPendingCallWatcher::finished, this, [this, userListWatcher] {
+        QDBusPendingReply<QDBusVariant> reply = *userListWatcher;
+        if (!reply.isError()) {
+            onUserListChanged(reply.value().variant().toStringList());
+        } else {
+            qWarning() << "get user list failed:" << reply.error();
+        }
+        userListWatcher->deleteLater();
+    });
+    QDBusMessage sessionsMsg = QDBusMessage::createMethodCall(m_dmInter->service(), m_dmInter->path(), PropertiesInterface, "Get");
+    sessionsMsg << m_dmInter->interface() << "Sessions";
+    QDBusPendingCallWatcher *sessionsWatcher = new QDBusPendingCallWatcher(m_dmInter->connection().asyncCall(sessionsMsg), this);
+    connect(sessionsWatcher, &QDBusPendingCallWatcher::finished, this, [this, sessionsWatcher] {
+        QDBusPendingReply<QDBusVariant> reply = *sessionsWatcher;
+        if (!reply.isError()) {
+            updateUserOnlineStatus(qdbus_cast<QList<QDBusObjectPath>>(reply.value().variant()));
+        } else {
+            qWarning() << "get display manager sessions failed:" << reply.error();
+        }
+        sessionsWatcher->deleteLater();
+    });
     getAllGroups();
     getPresetGroups();
 
@@ -154,14 +187,8 @@ void AccountsWorker::setGroups(User *user, const QStringList &usrGroups)
 
 void AccountsWorker::active()
 {
-    for (auto it(m_userInters.cbegin()); it != m_userInters.cend(); ++it) {
-        it.key()->setName(it.value()->userName());
-        it.key()->setAutoLogin(it.value()->automaticLogin());
-        it.key()->setAvatars(it.value()->iconList());
-        it.key()->setGroups(it.value()->groups());
-        it.key()->setCurrentAvatar(it.value()->iconFile());
-        it.key()->setCreatedTime(it.value()->createdTime());
-    }
+    for (auto it(m_pathUsers.cbegin()); it != m_pathUsers.cend(); ++it)
+        refreshUserProperties(it.key());
 }
 
 QString AccountsWorker::getCurrentUserName()
@@ -233,7 +260,7 @@ void AccountsWorker::setFullname(User *user, const QString &fullname)
 void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
 {
     QDBusPendingReply<> reply = m_accountsInter->DeleteUser(user->name(), deleteHome);
-    reply.waitForFinished();
+    dcc::DBusTelemetry::waitForFinished(reply, "com.deepin.daemon.Accounts.DeleteUser");
     if (reply.isError()) {
         qDebug() << Q_FUNC_INFO << reply.error().message();
         Q_EMIT m_userModel->isCancelChanged();
@@ -242,14 +269,14 @@ void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
         Q_EMIT m_userModel->deleteUserSuccess();
         removeUser(m_userInters.value(user)->path());
 
-        QDBusPendingReply<> listFingersReply = m_fingerPrint->ListFingers(user->name());
-        listFingersReply.waitForFinished();
+        QDBusPendingReply<QStringList> listFingersReply = m_fingerPrint->ListFingers(user->name());
+        dcc::DBusTelemetry::waitForFinished(listFingersReply, "com.deepin.daemon.Authenticate.Fingerprint.ListFingers");
         if (listFingersReply.isError()) {
             qDebug() << Q_FUNC_INFO << listFingersReply.error().message();
         } else {
-            if (m_fingerPrint->ListFingers(user->name()).value().count()) {
+            if (!listFingersReply.value().isEmpty()) {
                 QDBusPendingReply<> delAllFingereply = m_fingerPrint->DeleteAllFingers(user->name());
-                delAllFingereply.waitForFinished();
+                dcc::DBusTelemetry::waitForFinished(delAllFingereply, "com.deepin.daemon.Authenticate.Fingerprint.DeleteAllFingers");
                 if (delAllFingereply.isError()) {
                     qDebug() << Q_FUNC_INFO << delAllFingereply.error().message();
                 }
@@ -278,29 +305,140 @@ void AccountsWorker::setAutoLogin(User *user, const bool autoLogin)
     });
 }
 
-void AccountsWorker::loadUserList()
+void AccountsWorker::loadUserList(int lastVisibleRow)
 {
-    onUserListChanged(m_accountsInter->userList());
+    ensureUsersLoaded(lastVisibleRow + 1 + UserPrefetchCount);
 }
 
 void AccountsWorker::onUserListChanged(const QStringList &userList)
 {
-    int count = 0;
-    static bool first = true;
+    const QString currentUserPath = QString("/com/deepin/daemon/Accounts/User%1").arg(getuid());
+
+    m_userPaths.clear();
+    m_userPathSet.clear();
     for (const QString &path : userList) {
-        if (!m_userModel->contains(path)) {
-            count++;
-            addUser(path);
-            if (count > 50 && first) {
-                first = false;
-                break; // 第一次打开用户列表只加载51个用户信息
-            } else if (count > 2 && !first) {
-                break; // 滚动条每滑动一次，加载3个用户
+        if (path.contains("User0", Qt::CaseInsensitive))
+            continue;
+
+        m_userPathSet << path;
+        // 当前用户优先加载
+        if (path == currentUserPath) {
+            m_userPaths.prepend(path);
+        } else {
+            m_userPaths << path;
+        }
+    }
+
+    for (const QString &path : m_pathUsers.keys()) {
+        if (!m_userPathSet.contains(path))
+            removeUser(path);
+    }
+
+    ensureUsersLoaded(m_loadTarget);
+}
+
+void AccountsWorker::ensureUsersLoaded(int count)
+{
+    m_loadTarget = qMax(m_loadTarget, count);
+
+    QStringList batch;
+    const int end = qMin(m_loadTarget, m_userPaths.size());
+    for (int i = 0; i < end; ++i) {
+        const QString &path = m_userPaths.at(i);
+        if (m_pathUsers.contains(path) || m_loadingPaths.contains(path))
+            continue;
+
+        batch << path;
+        if (batch.size() == UserBatchSize) {
+            fetchUsers(batch);
+            batch.clear();
+        }
+    }
+
+    if (!batch.isEmpty())
+        fetchUsers(batch);
+}
+
+void AccountsWorker::fetchUsers(const QStringList &paths)
+{
+    // 每个用户一次 GetAll 取回全部属性，整批返回后再按顺序加入列表
+    QSharedPointer<QHash<QString, QVariantMap>> results(new QHash<QString, QVariantMap>);
+    QSharedPointer<int> remaining(new int(paths.size()));
+
+    for (const QString &path : paths) {
+        m_loadingPaths << path;
+
+        QDBusMessage msg = QDBusMessage::createMethodCall(AccountsService, path, PropertiesInterface, "GetAll");
+        msg << AccountsUserInterface;
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+            QDBusPendingReply<QVariantMap> reply = *watcher;
+            if (!reply.isError()) {
+                results->insert(path, reply.value());
+            } else {
+                qWarning() << "get user properties failed:" << path << reply.error();
             }
+            watcher->deleteLater();
+
+            if (--(*remaining) > 0)
+                return;
+
+            for (const QString &userPath : paths) {
+                m_loadingPaths.remove(userPath);
+                // 加载期间用户可能已被删除
+                if (results->contains(userPath) && m_userPathSet.contains(userPath) && !m_pathUsers.contains(userPath))
+                    createUser(userPath, results->value(userPath));
+            }
+        });
+    }
+}
+
+void AccountsWorker::applyUserProperties(User *user, const QVariantMap &properties)
+{
+    for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+        const QString &key = it.key();
+        const QVariant &value = it.value();
+
+        if (key == "UserName") {
+            user->setName(value.toString());
+        } else if (key == "FullName") {
+            user->setFullname(value.toString());
+        } else if (key == "AutomaticLogin") {
+            user->setAutoLogin(value.toBool());
+        } else if (key == "IconList") {
+            user->setAvatars(value.toStringList());
+        } else if (key == "Groups") {
+            user->setGroups(value.toStringList());
+        } else if (key == "IconFile") {
+            user->setCurrentAvatar(value.toString());
+        } else if (key == "NoPasswdLogin") {
+            user->setNopasswdLogin(value.toBool());
+        } else if (key == "PasswordStatus") {
+            user->setPasswordStatus(value.toString());
+        } else if (key == "CreatedTime") {
+            user->setCreatedTime(value.toULongLong());
+        } else if (key == "AccountType") {
+            user->setUserType(value.toInt());
+        } else if (key == "MaxPasswordAge") {
+            user->setPasswordAge(value.toInt());
         }
     }
 }
 
+void AccountsWorker::refreshUserProperties(const QString &userPath)
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(AccountsService, userPath, PropertiesInterface, "GetAll");
+    msg << AccountsUserInterface;
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ = ] {
+        QDBusPendingReply<QVariantMap> reply = *watcher;
+        User *user = m_pathUsers.value(userPath);
+        if (user && !reply.isError())
+            applyUserProperties(user, reply.value());
+        watcher->deleteLater();
+    });
+}
+
 void AccountsWorker::setPassword(User *user, const QString &oldpwd, const QString &passwd)
 {
     QProcess process;
@@ -359,6 +497,19 @@ void AccountsWorker::addUser(const QString &userPath)
 {
     if (userPath.contains("User0", Qt::CaseInsensitive))
         return;
+
+    if (!m_userPathSet.contains(userPath)) {
+        m_userPaths << userPath;
+        m_userPathSet << userPath;
+    }
+
+    // 新建的用户总是加载，不受分页限制
+    if (!m_pathUsers.contains(userPath) && !m_loadingPaths.contains(userPath))
+        fetchUsers(QStringList() << userPath);
+}
+
+void AccountsWorker::createUser(const QString &userPath, const QVariantMap &properties)
+{
     AccountsUser *userInter = new AccountsUser(AccountsService, userPath, QDBusConnection::systemBus(), this);
     userInter->setSync(false);
 
@@ -384,36 +535,42 @@ void AccountsWorker::addUser(const QString &userPath)
     connect(userInter, &AccountsUser::AccountTypeChanged, user, &User::setUserType);
     connect(userInter, &AccountsUser::MaxPasswordAgeChanged, user, &User::setPasswordAge);
 
-    user->setName(userInter->userName());
-    user->setFullname(userInter->fullName());
-    user->setAutoLogin(userInter->automaticLogin());
-    user->setAvatars(userInter->iconList());
-    user->setGroups(userInter->groups());
-    user->setCurrentAvatar(userInter->iconFile());
-    user->setNopasswdLogin(userInter->noPasswdLogin());
-    user->setPasswordStatus(userInter->passwordStatus());
-    user->setCreatedTime(userInter->createdTime());
-    user->setUserType(userInter->accountType());
-    user->setPasswordAge(userInter->maxPasswordAge());
-    user->setIsPasswordExpired(userInter->IsPasswordExpired());
+    applyUserProperties(user, properties);
+    user->setOnline(m_onlineUsers.contains(user->name()));
+    user->setIsCurrentUser(user->name() == m_currentUserName);
+
+    QDBusPendingCallWatcher *expiredWatcher = new QDBusPendingCallWatcher(userInter->IsPasswordExpired(), user);
+    connect(expiredWatcher, &QDBusPendingCallWatcher::finished, user, [user, expiredWatcher] {
+        QDBusPendingReply<bool> reply = *expiredWatcher;
+        if (!reply.isError())
+            user->setIsPasswordExpired(reply.value());
+        expiredWatcher->deleteLater();
+    });
 
     m_userInters[user] = userInter;
+    m_pathUsers[userPath] = user;
     m_userModel->addUser(userPath, user);
+
+#ifdef DCC_ENABLE_ADDOMAIN
+    checkADUser();
+#endif
 }
 
 void AccountsWorker::removeUser(const QString &userPath)
 {
-    for (AccountsUser *userInter : m_userInters.values()) {
-        if (userInter->path() == userPath) {
-            User *user = m_userInters.key(userInter);
-            user->deleteLater();
+    if (m_userPathSet.remove(userPath))
+        m_userPaths.removeOne(userPath);
+
+    User *user = m_pathUsers.take(userPath);
+    if (!user)
+        return;
 
-            m_userInters.remove(user);
-            m_userModel->removeUser(userPath);
+    AccountsUser *userInter = m_userInters.take(user);
+    if (userInter)
+        userInter->deleteLater();
 
-            return;
-        }
-    }
+    m_userModel->removeUser(userPath);
+    user->deleteLater();
 }
 
 void AccountsWorker::setNopasswdLogin(User *user, const bool nopasswdLogin)
@@ -575,7 +732,7 @@ CreationResult *AccountsWorker::createAccountInternal(const User *user)
 
     // validate username
     QDBusPendingReply<bool, QString, int> reply = m_accountsInter->IsUsernameValid(user->name());
-    reply.waitForFinished();
+    dcc::DBusTelemetry::waitForFinished(reply, "com.deepin.daemon.Accounts.IsUsernameValid");
     if (reply.isError()) {
         result->setType(CreationResult::UserNameError);
         result->setMessage(reply.error().message());
@@ -608,7 +765,7 @@ CreationResult *AccountsWorker::createAccountInternal(const User *user)
     // default FullName is empty string
     QDBusObjectPath path;
     QDBusPendingReply<QDBusObjectPath> createReply = m_accountsInter->CreateUser(user->name(), user->fullname(), user->userType());
-    createReply.waitForFinished();
+    dcc::DBusTelemetry::waitForFinished(createReply, "com.deepin.daemon.Accounts.CreateUser");
     if (createReply.isError()) {
         /* 这里由后端保证出错时一定有错误信息返回，如果没有错误信息，就默认用户在认证时点了取消 */
         result->setType(createReply.error().message().isEmpty() ? CreationResult::Canceled : CreationResult::UnknownError);
@@ -86,7 +86,7 @@ public Q_SLOTS:
     void deleteUserIcon(User *user, const QString &iconPath);
     void setNopasswdLogin(User *user, const bool nopasswdLogin);
     void setMaxPasswordAge(User *user, const int maxAge);
-    void loadUserList();
+    void loadUserList(int lastVisibleRow);
 
 #ifdef DCC_ENABLE_ADDOMAIN
     void refreshADDomain();
@@ -108,6 +108,11 @@ private Q_SLOTS:
 
 private:
     AccountsUser *userInter(const QString &userName) const;
+    void ensureUsersLoaded(int count);
+    void fetchUsers(const QStringList &paths);
+    void createUser(const QString &userPath, const QVariantMap &properties);
+    void applyUserProperties(User *user, const QVariantMap &properties);
+    void refreshUserProperties(const QString &userPath);
     CreationResult *createAccountInternal(const User *user);
     QString cryptUserPassword(const QString &password);
 
@@ -117,8 +122,17 @@ private:
 #ifdef DCC_ENABLE_ADDOMAIN
     Notifications *m_notifyInter;
 #endif
-    QSet<QString> m_userSet;
     QMap<User *, AccountsUser *> m_userInters;
+    // 系统中所有用户的路径，当前用户排在最前面，按此顺序分批加载
+    QStringList m_userPaths;
+    // 与 m_userPaths 内容相同，用于快速判断路径是否存在
+    QSet<QString> m_userPathSet;
+    // 已加载用户的路径索引
+    QHash<QString, User *> m_pathUsers;
+    // 正在异步获取属性的用户路径
+    QSet<QString> m_loadingPaths;
+    // m_userPaths 中需要加载的前 m_loadTarget 个用户
+    int m_loadTarget;
     QString m_currentUserName;
     DisplayManager *m_dmInter;
     QStringList m_onlineUsers;
@@ -24,6 +24,7 @@
  */
 
 #include "avatarwidget.h"
+#include "modules/common/imageloader.h"
 
 #include <QDebug>
 #include <QUrl>
@@ -100,15 +101,23 @@ void AvatarWidget::setAvatarPath(const QString &avatar)
         url = QUrl(avatar);
 
     m_avatarPath = url.toString();
-
-    if (!QPixmap(url.toLocalFile()).isNull()) {
-        m_avatar = QPixmap(url.toLocalFile()).scaled(size() * ratio, Qt::KeepAspectRatio, Qt::FastTransformation);
-        m_avatar.setDevicePixelRatio(ratio);
-    }
+    loadAvatar();
 
     setAccessibleName(m_avatarPath);
+}
 
-    update();
+void AvatarWidget::loadAvatar()
+{
+    const QString file = QUrl(m_avatarPath).toLocalFile();
+    const QSize targetSize = size();
+    ImageLoader::instance()->load(file, targetSize, devicePixelRatioF(), this, [this, file, targetSize](const QPixmap &pixmap) {
+        // 忽略已过期的结果，加载失败时保留原来的头像
+        if (pixmap.isNull() || file != QUrl(m_avatarPath).toLocalFile() || targetSize != size())
+            return;
+
+        m_avatar = pixmap;
+        update();
+    });
 }
 
 void AvatarWidget::mouseReleaseEvent(QMouseEvent *e)
@@ -212,11 +221,5 @@ void AvatarWidget::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
 
-    const auto ratio = devicePixelRatioF();
-
-    QUrl url(m_avatarPath);
-    m_avatar = QPixmap(url.toLocalFile()).scaled(size() * ratio, Qt::KeepAspectRatio, Qt::FastTransformation);
-    m_avatar.setDevicePixelRatio(ratio);
-
-    update();
+    loadAvatar();
 }
@@ -63,6 +63,9 @@ protected:
     void leaveEvent(QEvent *);
     void resizeEvent(QResizeEvent *event);
 
+private:
+    void loadAvatar();
+
 private:
     bool m_hover;
     bool m_deleable;
@@ -41,6 +41,8 @@ FingerWorker::FingerWorker(FingerModel *model, QObject *parent)
     , m_fingerPrintInter(new Fingerprint(FingerPrintService, "/com/deepin/daemon/Authenticate/Fingerprint",
                                          QDBusConnection::systemBus(), this))
     , m_SMInter(new SessionManagerInter("com.deepin.SessionManager", "/com/deepin/SessionManager", QDBusConnection::sessionBus(), this))
+    , m_enrollStage(Stage_Idle)
+    , m_enrollSerial(0)
 {
     //处理指纹后端的录入状态信号
     connect(m_fingerPrintInter, &Fingerprint::EnrollStatus, m_model, [this](const QString &, int code, const QString &msg) {
@@ -56,65 +58,143 @@ FingerWorker::FingerWorker(FingerModel *model, QObject *parent)
 
 void FingerWorker::tryEnroll(const QString &name, const QString &thumb)
 {
-    m_fingerPrintInter->setTimeout(1000 * 60 * 60);
+    m_enrollUser = name;
+    m_enrollThumb = thumb;
+    m_enrollStage = Stage_Authenticating;
+
+    // 认证需要等待用户输入密码，超时只对这一次调用生效
     qDebug() << "PreAuthEnroll()";
+    m_fingerPrintInter->setTimeout(1000 * 60 * 60);
     QDBusPendingCall call = m_fingerPrintInter->PreAuthEnroll();
+    m_fingerPrintInter->setTimeout(-1);
+    watchCall(call, [this](QDBusPendingCallWatcher *watcher, int serial) {
+        onPreAuthEnrollFinished(watcher, serial);
+    });
+}
+
+void FingerWorker::watchCall(const QDBusPendingCall &call, std::function<void (QDBusPendingCallWatcher *, int)> handler)
+{
+    const int serial = ++m_enrollSerial;
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
-        if (call.isError()) {
-            qDebug() << "call PreAuthEnroll Error : " << call.error();
-            Q_EMIT tryEnrollResult(Enroll_AuthFailed);
-        } else {
-            m_fingerPrintInter->setTimeout(-1);
-            auto callClaim = m_fingerPrintInter->Claim(name, true);
-            callClaim.waitForFinished();
-            if (callClaim.isError()) {
-                qDebug() << "call Claim Error : " << callClaim.error();
-                Q_EMIT tryEnrollResult(Enroll_ClaimFailed);
-            } else {
-                auto callEnroll =  m_fingerPrintInter->Enroll(thumb);
-                callEnroll.waitForFinished();
-                if (callEnroll.isError()) {
-                    qDebug() << "call Enroll Error : " << callClaim.error();
-                    m_fingerPrintInter->Claim(name, false);
-                    Q_EMIT tryEnrollResult(Enroll_Failed);
-                } else {
-                    Q_EMIT tryEnrollResult(Enroll_Success);
-                }
-            }
-        }
-        m_fingerPrintInter->setTimeout(-1);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [watcher, handler, serial] {
+        handler(watcher, serial);
         watcher->deleteLater();
     });
 }
 
-void FingerWorker::refreshUserEnrollList(const QString &id)
+void FingerWorker::onPreAuthEnrollFinished(QDBusPendingCallWatcher *watcher, int serial)
+{
+    if (serial != m_enrollSerial)
+        return;
+
+    if (watcher->isError()) {
+        qDebug() << "call PreAuthEnroll Error : " << watcher->error();
+        m_enrollStage = Stage_Idle;
+        Q_EMIT tryEnrollResult(Enroll_AuthFailed);
+        return;
+    }
+
+    m_enrollStage = Stage_Claiming;
+    // 回复到达时 m_enrollUser 可能已属于新的录入，释放设备时要用发起占用的用户
+    const QString userName = m_enrollUser;
+    watchCall(m_fingerPrintInter->Claim(userName, true), [this, userName](QDBusPendingCallWatcher *watcher, int serial) {
+        onClaimFinished(watcher, serial, userName);
+    });
+}
+
+void FingerWorker::onClaimFinished(QDBusPendingCallWatcher *watcher, int serial, const QString &userName)
+{
+    if (serial != m_enrollSerial) {
+        // 录入已被取消，但设备仍然被占用；录入状态已属于之后的流程，不再修改
+        if (!watcher->isError())
+            releaseDevice(userName, serial);
+        return;
+    }
+
+    if (watcher->isError()) {
+        qDebug() << "call Claim Error : " << watcher->error();
+        m_enrollStage = Stage_Idle;
+        Q_EMIT tryEnrollResult(Enroll_ClaimFailed);
+        return;
+    }
+
+    m_enrollStage = Stage_Enrolling;
+    watchCall(m_fingerPrintInter->Enroll(m_enrollThumb), [this](QDBusPendingCallWatcher *watcher, int serial) {
+        onEnrollFinished(watcher, serial);
+    });
+}
+
+void FingerWorker::onEnrollFinished(QDBusPendingCallWatcher *watcher, int serial)
 {
-    auto call = m_fingerPrintInter->ListFingers(id);
-    call.waitForFinished();
-    if (call.isError()) {
-        qDebug() << "m_fingerPrintInter->ListFingers call Error";
-        m_model->setThumbsList(QStringList());
+    if (serial != m_enrollSerial)
+        return;
+
+    if (watcher->isError()) {
+        qDebug() << "call Enroll Error : " << watcher->error();
+        m_enrollStage = Stage_Releasing;
+        releaseDevice(m_enrollUser, serial);
+        Q_EMIT tryEnrollResult(Enroll_Failed);
         return;
-    } else {
-        qDebug() << "m_fingerPrintInter->ListFingers";
     }
-    m_model->setThumbsList(call.value());
+
+    // 录入进度由 EnrollStatus 信号通知，直到 stopEnroll 释放设备
+    Q_EMIT tryEnrollResult(Enroll_Success);
+}
+
+void FingerWorker::releaseDevice(const QString &userName, int serial)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_fingerPrintInter->Claim(userName, false), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, serial] {
+        if (watcher->isError())
+            qDebug() << "call Claim Error : " << watcher->error();
+
+        // 只结束发起释放的那次录入，之后开始的录入不受影响
+        if (serial == m_enrollSerial && m_enrollStage == Stage_Releasing)
+            m_enrollStage = Stage_Idle;
+        watcher->deleteLater();
+    });
+}
+
+void FingerWorker::refreshUserEnrollList(const QString &id)
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_fingerPrintInter->ListFingers(id), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher] {
+        QDBusPendingReply<QStringList> reply = *watcher;
+        if (reply.isError()) {
+            qDebug() << "m_fingerPrintInter->ListFingers call Error";
+            m_model->setThumbsList(QStringList());
+        } else {
+            m_model->setThumbsList(reply.value());
+        }
+        watcher->deleteLater();
+    });
 }
 
 void FingerWorker::stopEnroll(const QString& userName)
 {
     qDebug() << "stopEnroll";
-    auto call = m_fingerPrintInter->StopEnroll();
-    call.waitForFinished();
-    if (call.isError()) {
-        qDebug() << "call StopEnroll Error" << call.error();
-    }
-    auto callClaim = m_fingerPrintInter->Claim(userName, false);
-    callClaim.waitForFinished();
-    if (callClaim.isError()) {
-        qDebug() << "call Claim Error : " << callClaim.error();
+    const EnrollStage stage = m_enrollStage;
+    if (stage == Stage_Idle || stage == Stage_Releasing)
+        return;
+
+    // 丢弃尚未返回的认证、占用和录入请求
+    ++m_enrollSerial;
+    // 占用请求尚未返回时由 onClaimFinished 释放设备，这里可以直接结束
+    if (stage == Stage_Authenticating || stage == Stage_Claiming) {
+        m_enrollStage = Stage_Idle;
+        return;
     }
+
+    m_enrollStage = Stage_Releasing;
+
+    // 同一连接上的调用按顺序处理，StopEnroll 总在释放设备之前执行
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_fingerPrintInter->StopEnroll(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [watcher] {
+        if (watcher->isError())
+            qDebug() << "call StopEnroll Error" << watcher->error();
+        watcher->deleteLater();
+    });
+    releaseDevice(userName, m_enrollSerial);
 }
 
 void FingerWorker::deleteFingerItem(const QString& userName, const QString& finger)
@@ -130,10 +210,11 @@ void FingerWorker::deleteFingerItem(const QString& userName, const QString& fing
 
 void FingerWorker::renameFingerItem(const QString& userName, const QString& finger, const QString& newName)
 {
-    auto call = m_fingerPrintInter->RenameFinger(userName, finger, newName);
-    call.waitForFinished();
-    if (call.isError()) {
-        qDebug() << "call RenameFinger Error : " << call.error();
-    }
-    refreshUserEnrollList(userName);
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_fingerPrintInter->RenameFinger(userName, finger, newName), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, userName] {
+        if (watcher->isError())
+            qDebug() << "call RenameFinger Error : " << watcher->error();
+        refreshUserEnrollList(userName);
+        watcher->deleteLater();
+    });
 }
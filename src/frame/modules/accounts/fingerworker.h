@@ -34,6 +34,8 @@
 
 #include <QObject>
 
+#include <functional>
+
 using com::deepin::daemon::authenticate::Fingerprint;
 using SessionManagerInter = com::deepin::SessionManager;
 
@@ -51,6 +53,14 @@ public:
         Enroll_Success,
         Count
     };
+    // 录入流程：PreAuthEnroll 认证 -> Claim 占用设备 -> Enroll 录入，结束后 StopEnroll 并释放设备
+    enum EnrollStage {
+        Stage_Idle,
+        Stage_Authenticating,
+        Stage_Claiming,
+        Stage_Enrolling,
+        Stage_Releasing
+    };
     explicit FingerWorker(FingerModel *model, QObject *parent = nullptr);
 
     void refreshDevice();
@@ -61,6 +71,7 @@ Q_SIGNALS:
 
 public:
     void tryEnroll(const QString &name, const QString &thumb);
+    EnrollStage enrollStage() const { return m_enrollStage; }
 
 public Q_SLOTS:
     void refreshUserEnrollList(const QString &id);
@@ -68,10 +79,22 @@ public Q_SLOTS:
     void deleteFingerItem(const QString& userName, const QString& finger);
     void renameFingerItem(const QString& userName, const QString& finger, const QString& newName);
 
+private:
+    void onPreAuthEnrollFinished(QDBusPendingCallWatcher *watcher, int serial);
+    void onClaimFinished(QDBusPendingCallWatcher *watcher, int serial, const QString &userName);
+    void onEnrollFinished(QDBusPendingCallWatcher *watcher, int serial);
+    void releaseDevice(const QString &userName, int serial);
+    void watchCall(const QDBusPendingCall &call, std::function<void (QDBusPendingCallWatcher *, int)> handler);
+
 private:
     FingerModel *m_model;
     Fingerprint *m_fingerPrintInter;
     SessionManagerInter *m_SMInter{nullptr};
+    EnrollStage m_enrollStage;
+    // 每次开始或取消录入时递增，用来丢弃已过期的回复
+    int m_enrollSerial;
+    QString m_enrollUser;
+    QString m_enrollThumb;
 };
 
 }
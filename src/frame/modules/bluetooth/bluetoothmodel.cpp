@@ -39,6 +39,17 @@ void BluetoothModel::addAdapter(Adapter *adapter)
 {
     if (!adapterById(adapter->id())) {
         m_adapters[adapter->id()] = adapter;
+
+        // 维护所有适配器下设备的路径索引
+        for (const Device *device : adapter->devices())
+            m_devices[device->id()] = device;
+        connect(adapter, &Adapter::deviceAdded, this, [this](const Device *device) {
+            m_devices[device->id()] = device;
+        });
+        connect(adapter, &Adapter::deviceRemoved, this, [this](const QString &deviceId) {
+            m_devices.remove(deviceId);
+        });
+
         Q_EMIT adapterAdded(adapter);
         Q_EMIT adpaterListChanged();
         return;
@@ -54,6 +65,9 @@ const Adapter *BluetoothModel::removeAdapater(const QString &adapterId)
     adapter = adapterById(adapterId);
     if (adapter) {
         m_adapters.remove(adapterId);
+        disconnect(adapter, nullptr, this, nullptr);
+        for (const QString &deviceId : adapter->devicesId())
+            m_devices.remove(deviceId);
         Q_EMIT adapterRemoved(adapter);
         Q_EMIT adpaterListChanged();
     }
@@ -68,7 +82,12 @@ QMap<QString, const Adapter *> BluetoothModel::adapters() const
 
 const Adapter *BluetoothModel::adapterById(const QString &id)
 {
-    return m_adapters.keys().contains(id) ? m_adapters[id] : nullptr;
+    return m_adapters.value(id, nullptr);
+}
+
+const Device *BluetoothModel::deviceById(const QString &id) const
+{
+    return m_devices.value(id, nullptr);
 }
 
 /**
@@ -27,6 +27,7 @@
 #define DCC_BLUETOOTH_BLUETOOTHMODEL_H
 
 #include <QObject>
+#include <QHash>
 
 #include "adapter.h"
 
@@ -41,6 +42,7 @@ public:
 
     QMap<QString, const Adapter *> adapters() const;
     const Adapter *adapterById(const QString &id);
+    const Device *deviceById(const QString &id) const;
     bool canTransportable() const;
 
 public Q_SLOTS:
@@ -57,6 +59,7 @@ Q_SIGNALS:
 
 private:
     QMap<QString, const Adapter *> m_adapters;
+    QHash<QString, const Device *> m_devices;
     bool m_transPortable;
     friend class BluetoothWorker;
 };
@@ -36,8 +36,13 @@ namespace bluetooth {
 BluetoothWorker::BluetoothWorker(BluetoothModel *model, bool sync) :
     QObject(),
     m_bluetoothInter(new DBusBluetooth("com.deepin.daemon.Bluetooth", "/com/deepin/daemon/Bluetooth", QDBusConnection::sessionBus(), this)),
-    m_model(model)
+    m_model(model),
+    m_devicePropertiesTimer(new QTimer(this))
 {
+    m_devicePropertiesTimer->setSingleShot(true);
+    m_devicePropertiesTimer->setInterval(16);
+    connect(m_devicePropertiesTimer, &QTimer::timeout, this, &BluetoothWorker::flushDeviceProperties);
+
     connect(m_bluetoothInter, &DBusBluetooth::AdapterAdded, this, &BluetoothWorker::addAdapter);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterRemoved, this, &BluetoothWorker::removeAdapter);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterPropertiesChanged, this, &BluetoothWorker::onAdapterPropertiesChanged);
@@ -261,15 +266,11 @@ void BluetoothWorker::inflateAdapter(Adapter *adapter, const QJsonObject &adapte
             QJsonArray arr = doc.array();
             for (QJsonValue val : arr) {
                 const QString id = val.toObject()["Path"].toString();
-                const QString name = val.toObject()["Name"].toString();
 
                 const Device *result = adapter->deviceById(id);
                 Device *device = const_cast<Device*>(result);
-                if (!device) {
+                if (!device)
                     device = new Device(adapter);
-                } else {
-                    if (device->name() != name) adapter->removeDevice(device->id());
-                }
                 inflateDevice(device, val.toObject());
                 adapter->addDevice(device);
 
@@ -322,24 +323,24 @@ void BluetoothWorker::onAdapterPropertiesChanged(const QString &json)
 
 void BluetoothWorker::onDevicePropertiesChanged(const QString &json)
 {
-    const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-    const QJsonObject obj = doc.object();
-    const QString id = obj["Path"].toString();
-    const QString name = obj["Name"].toString();
-    for (const Adapter *adapter : m_model->adapters()) {
-        Adapter *adapterPointer = const_cast<Adapter*>(adapter);
-        Device *device = const_cast<Device*>(adapter->deviceById(id));
-        if (device) {
-            if (device->name() == name) {
-                inflateDevice(device, obj);
-            } else {
-                if (!adapterPointer)
-                    return;
-                adapterPointer->removeDevice(device->id());
-                inflateDevice(device, obj);
-                adapterPointer->addDevice(device);
-            }
-        }
+    // 扫描时 RSSI 等属性变化非常频繁，同一设备只保留最新的属性
+    const QJsonObject obj = QJsonDocument::fromJson(json.toUtf8()).object();
+    m_pendingDeviceProperties.insert(obj["Path"].toString(), obj);
+
+    if (!m_devicePropertiesTimer->isActive())
+        m_devicePropertiesTimer->start();
+}
+
+void BluetoothWorker::flushDeviceProperties()
+{
+    const QHash<QString, QJsonObject> pending = m_pendingDeviceProperties;
+    m_pendingDeviceProperties.clear();
+
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        // 名称变化由 Device::nameChanged 通知界面，不再移除后重新添加
+        Device *device = const_cast<Device *>(m_model->deviceById(it.key()));
+        if (device)
+            inflateDevice(device, it.value());
     }
 }
 
@@ -391,6 +392,8 @@ void BluetoothWorker::removeDevice(const QString &json)
     const QString adapterId = obj["AdapterPath"].toString();
     const QString id = obj["Path"].toString();
 
+    m_pendingDeviceProperties.remove(id);
+
     const Adapter *result = m_model->adapterById(adapterId);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
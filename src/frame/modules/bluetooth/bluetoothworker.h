@@ -27,6 +27,9 @@
 #define DCC_BLUETOOTH_BLUETOOTHWORKER_H
 
 #include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QTimer>
 
 #include <com_deepin_daemon_bluetooth.h>
 
@@ -77,6 +80,7 @@ private:
 private Q_SLOTS:
     void onAdapterPropertiesChanged(const QString &json);
     void onDevicePropertiesChanged(const QString &json);
+    void flushDeviceProperties();
 
     void addAdapter(const QString &json);
     void removeAdapter(const QString &json);
@@ -95,6 +99,9 @@ private:
     DBusBluetooth *m_bluetoothInter;
     BluetoothModel *m_model;
     QMap<QDBusObjectPath, PinCodeDialog*> m_dialogs;
+    // 设备属性变化按设备合并，每帧最多应用一次
+    QHash<QString, QJsonObject> m_pendingDeviceProperties;
+    QTimer *m_devicePropertiesTimer;
 };
 
 } // namespace bluetooth
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dbusfuture.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QDebug>
+
+namespace dcc {
+
+void watchPendingCall(const QDBusPendingCall &call, QObject *context,
+                      std::function<void(const QDBusPendingCall &)> callback)
+{
+    // watcher 挂在 context 上，context 先销毁时回调随之取消
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, context);
+    QObject::connect(watcher, &QDBusPendingCallWatcher::finished, context, [callback](QDBusPendingCallWatcher *w) {
+        if (w->isError())
+            qDebug() << "dbus call failed:" << w->error().name() << w->error().message();
+        callback(*w);
+        w->deleteLater();
+    });
+}
+
+}
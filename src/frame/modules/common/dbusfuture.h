@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBUSFUTURE_H
+#define DBUSFUTURE_H
+
+#include "dbustelemetry.h"
+
+#include <QDBusError>
+#include <QDBusPendingCall>
+#include <QDBusPendingReply>
+
+#include <functional>
+
+class QObject;
+
+namespace dcc {
+
+/**
+ * @brief watchPendingCall 在主线程等待 D-Bus 调用返回后回调，不占用线程池；context 销毁后不再回调
+ */
+void watchPendingCall(const QDBusPendingCall &call, QObject *context,
+                      std::function<void(const QDBusPendingCall &)> callback);
+
+/**
+ * @brief DBusFuture 对 QDBusPendingCall 的非阻塞封装
+ *
+ * 用 then() 注册返回值和错误的回调，例如：
+ * DBusFuture<QString>(inter->CanSuspend()).then(this, [this](const QString &value) { ... });
+ * 出错时会打印日志，需要额外处理时再提供错误回调。传入 method 时调用耗时会计入 DBusTelemetry。
+ */
+template<typename T = void>
+class DBusFuture
+{
+public:
+    using ValueCallback = std::function<void(const T &)>;
+    using ErrorCallback = std::function<void(const QDBusError &)>;
+
+    DBusFuture(const QDBusPendingCall &call, const QString &method = QString())
+        : m_call(call)
+    {
+        if (!method.isEmpty())
+            DBusTelemetry::instance()->track(call, method);
+    }
+
+    void then(QObject *context, ValueCallback onValue, ErrorCallback onError = ErrorCallback()) const
+    {
+        watchPendingCall(m_call, context, [onValue, onError](const QDBusPendingCall &call) {
+            QDBusPendingReply<T> reply = call;
+            if (reply.isError()) {
+                if (onError)
+                    onError(reply.error());
+                return;
+            }
+            onValue(reply.value());
+        });
+    }
+
+private:
+    QDBusPendingCall m_call;
+};
+
+template<>
+class DBusFuture<void>
+{
+public:
+    using ValueCallback = std::function<void()>;
+    using ErrorCallback = std::function<void(const QDBusError &)>;
+
+    DBusFuture(const QDBusPendingCall &call, const QString &method = QString())
+        : m_call(call)
+    {
+        if (!method.isEmpty())
+            DBusTelemetry::instance()->track(call, method);
+    }
+
+    void then(QObject *context, ValueCallback onValue, ErrorCallback onError = ErrorCallback()) const
+    {
+        watchPendingCall(m_call, context, [onValue, onError](const QDBusPendingCall &call) {
+            if (call.isError()) {
+                if (onError)
+                    onError(call.error());
+                return;
+            }
+            onValue();
+        });
+    }
+
+private:
+    QDBusPendingCall m_call;
+};
+
+}
+
+#endif // DBUSFUTURE_H
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dbusproxyregistry.h"
+#include "dbustelemetry.h"
+
+#include <QCoreApplication>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QDBusVariant>
+#include <QDebug>
+#include <QThread>
+
+namespace dcc {
+
+static const QString PropertiesInterface = QStringLiteral("org.freedesktop.DBus.Properties");
+
+DBusObjectProxy::DBusObjectProxy(const QDBusConnection &connection, const QString &service,
+                                 const QString &path, const QString &interface)
+    : QObject(nullptr)
+    , m_connection(connection)
+    , m_service(service)
+    , m_path(path)
+    , m_interface(interface)
+    , m_serviceWatcher(new QDBusServiceWatcher(service, connection, QDBusServiceWatcher::WatchForOwnerChange, this))
+{
+    // 只关心本接口的属性变化
+    m_connection.connect(m_service, m_path, PropertiesInterface, "PropertiesChanged",
+                         QStringList() << m_interface, QString(),
+                         this, SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceOwnerChanged, this, &DBusObjectProxy::onServiceOwnerChanged);
+    refresh();
+}
+
+DBusObjectProxy::~DBusObjectProxy()
+{
+    m_connection.disconnect(m_service, m_path, PropertiesInterface, "PropertiesChanged",
+                            QStringList() << m_interface, QString(),
+                            this, SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
+    for (const QString &signal : m_signals)
+        m_connection.disconnect(m_service, m_path, m_interface, signal, this, SLOT(onSignal(QDBusMessage)));
+}
+
+QVariant DBusObjectProxy::cachedProperty(const QString &name)
+{
+    auto it = m_properties.constFind(name);
+    if (it != m_properties.constEnd())
+        return it.value();
+
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_service, m_path, PropertiesInterface, "Get");
+    msg << m_interface << name;
+    QDBusMessage reply;
+    {
+        DBusTelemetry::SyncScope scope(QString("%1.%2 [Get]").arg(m_interface, name));
+        reply = m_connection.call(msg);
+    }
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty()) {
+        qDebug() << "get property failed:" << m_service << m_path << name << reply.errorMessage();
+        return QVariant();
+    }
+
+    const QVariant value = reply.arguments().first().value<QDBusVariant>().variant();
+    m_properties.insert(name, value);
+    return value;
+}
+
+void DBusObjectProxy::refresh()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_service, m_path, PropertiesInterface, "GetAll");
+    msg << m_interface;
+
+    const QDBusPendingCall call = m_connection.asyncCall(msg);
+    DBusTelemetry::instance()->track(call, m_interface + " [GetAll]");
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher] {
+        QDBusPendingReply<QVariantMap> reply = *watcher;
+        if (reply.isError()) {
+            qDebug() << "get all properties failed:" << m_service << m_path << reply.error().message();
+        } else {
+            const QVariantMap properties = reply.value();
+            for (auto it = properties.constBegin(); it != properties.constEnd(); ++it)
+                updateProperty(it.key(), it.value());
+        }
+        watcher->deleteLater();
+    });
+}
+
+QDBusMessage DBusObjectProxy::call(const QString &method, const QVariantList &arguments)
+{
+    DBusTelemetry::SyncScope scope(m_interface + "." + method);
+    return m_connection.call(createCall(method, arguments));
+}
+
+QDBusPendingCall DBusObjectProxy::asyncCall(const QString &method, const QVariantList &arguments)
+{
+    const QDBusPendingCall call = m_connection.asyncCall(createCall(method, arguments));
+    DBusTelemetry::instance()->track(call, m_interface + "." + method);
+    return call;
+}
+
+void DBusObjectProxy::subscribe(const QString &signal)
+{
+    if (m_signals.contains(signal))
+        return;
+
+    if (m_connection.connect(m_service, m_path, m_interface, signal, this, SLOT(onSignal(QDBusMessage))))
+        m_signals.insert(signal);
+}
+
+void DBusObjectProxy::onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated)
+{
+    if (interface != m_interface)
+        return;
+
+    for (auto it = changed.constBegin(); it != changed.constEnd(); ++it)
+        updateProperty(it.key(), it.value());
+
+    // 失效的属性下次读取时再获取
+    for (const QString &name : invalidated)
+        m_properties.remove(name);
+}
+
+void DBusObjectProxy::onSignal(const QDBusMessage &message)
+{
+    Q_EMIT dbusSignal(message.member(), message.arguments());
+}
+
+void DBusObjectProxy::onServiceOwnerChanged(const QString &service, const QString &oldOwner, const QString &newOwner)
+{
+    Q_UNUSED(service);
+    Q_UNUSED(oldOwner);
+
+    // 缓存的属性属于旧的服务进程，服务重新启动后全部重新获取并通知变化
+    m_properties.clear();
+    if (!newOwner.isEmpty())
+        refresh();
+}
+
+QDBusMessage DBusObjectProxy::createCall(const QString &method, const QVariantList &arguments) const
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_service, m_path, m_interface, method);
+    msg.setArguments(arguments);
+    return msg;
+}
+
+void DBusObjectProxy::updateProperty(const QString &name, const QVariant &value)
+{
+    auto it = m_properties.find(name);
+    if (it != m_properties.end() && it.value() == value)
+        return;
+
+    m_properties.insert(name, value);
+    Q_EMIT propertyChanged(name, value);
+}
+
+DBusProxyRegistry::DBusProxyRegistry(QObject *parent)
+    : QObject(parent)
+{
+}
+
+DBusProxyRegistry *DBusProxyRegistry::instance()
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+    static DBusProxyRegistry *registry = new DBusProxyRegistry(qApp);
+    return registry;
+}
+
+QSharedPointer<DBusObjectProxy> DBusProxyRegistry::proxy(const QDBusConnection &connection, const QString &service,
+                                                         const QString &path, const QString &interface)
+{
+    // 代理和注册表都不加锁，工作线程需要时通过排队连接交给主线程
+    Q_ASSERT(QThread::currentThread() == thread());
+    const QString key = QString("%1|%2|%3|%4").arg(connection.name(), service, path, interface);
+    QSharedPointer<DBusObjectProxy> proxy = m_proxies.value(key).toStrongRef();
+    if (proxy)
+        return proxy;
+
+    // 最后一个引用释放时可能还在代理自身的信号处理中，延迟删除
+    proxy = QSharedPointer<DBusObjectProxy>(new DBusObjectProxy(connection, service, path, interface), &QObject::deleteLater);
+    m_proxies.insert(key, proxy);
+
+    // 清理已经失效的弱引用，避免键值无限增长
+    for (auto it = m_proxies.begin(); it != m_proxies.end();) {
+        if (it.value().isNull())
+            it = m_proxies.erase(it);
+        else
+            ++it;
+    }
+
+    return proxy;
+}
+
+}
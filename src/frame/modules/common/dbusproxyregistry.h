@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBUSPROXYREGISTRY_H
+#define DBUSPROXYREGISTRY_H
+
+#include <QObject>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCall>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVariantMap>
+#include <QWeakPointer>
+
+class QDBusServiceWatcher;
+
+namespace dcc {
+
+/**
+ * @brief DBusObjectProxy 进程内共享的 D-Bus 对象代理
+ *
+ * 不做 introspect，属性在创建时通过一次 GetAll 取回，之后只由 PropertiesChanged 更新，
+ * 服务的所有者变化（重启或退出）时清空缓存并重新获取；
+ * 每个对象只注册一条属性变化和每种信号一条匹配规则，由 DBusProxyRegistry 创建和共享。
+ */
+class DBusObjectProxy : public QObject
+{
+    Q_OBJECT
+    friend class DBusProxyRegistry;
+
+public:
+    QDBusConnection connection() const { return m_connection; }
+    QString service() const { return m_service; }
+    QString path() const { return m_path; }
+    QString interface() const { return m_interface; }
+
+    /**
+     * @brief cachedProperty 读取缓存的属性，缓存中没有时同步获取一次并缓存
+     */
+    QVariant cachedProperty(const QString &name);
+    bool hasCachedProperty(const QString &name) const { return m_properties.contains(name); }
+    // 重新异步获取全部属性，用于服务重启或只发自定义信号而不发 PropertiesChanged 的服务
+    void refresh();
+
+    QDBusMessage call(const QString &method, const QVariantList &arguments = QVariantList());
+    QDBusPendingCall asyncCall(const QString &method, const QVariantList &arguments = QVariantList());
+
+    /**
+     * @brief subscribe 订阅该接口的信号，收到后通过 dbusSignal 转发，同一信号只注册一次
+     */
+    void subscribe(const QString &signal);
+
+Q_SIGNALS:
+    void propertyChanged(const QString &name, const QVariant &value);
+    void dbusSignal(const QString &name, const QVariantList &arguments);
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QString &interface, const QVariantMap &changed, const QStringList &invalidated);
+    void onSignal(const QDBusMessage &message);
+    void onServiceOwnerChanged(const QString &service, const QString &oldOwner, const QString &newOwner);
+
+private:
+    DBusObjectProxy(const QDBusConnection &connection, const QString &service,
+                    const QString &path, const QString &interface);
+    ~DBusObjectProxy() override;
+
+    QDBusMessage createCall(const QString &method, const QVariantList &arguments) const;
+    void updateProperty(const QString &name, const QVariant &value);
+
+private:
+    QDBusConnection m_connection;
+    QString m_service;
+    QString m_path;
+    QString m_interface;
+    QVariantMap m_properties;
+    QSet<QString> m_signals;
+    QDBusServiceWatcher *m_serviceWatcher;
+};
+
+/**
+ * @brief DBusProxyRegistry 按 (总线, 服务, 路径, 接口) 共享 DBusObjectProxy
+ *
+ * 返回的代理以引用计数管理，最后一个使用者释放后销毁并注销匹配规则。
+ * 注册表和代理都属于主线程，只能在主线程获取和使用。
+ */
+class DBusProxyRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DBusProxyRegistry *instance();
+
+    QSharedPointer<DBusObjectProxy> proxy(const QDBusConnection &connection, const QString &service,
+                                          const QString &path, const QString &interface);
+
+private:
+    explicit DBusProxyRegistry(QObject *parent = nullptr);
+
+private:
+    QHash<QString, QWeakPointer<DBusObjectProxy>> m_proxies;
+};
+
+}
+
+#endif // DBUSPROXYREGISTRY_H
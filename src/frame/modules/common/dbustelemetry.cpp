@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dbustelemetry.h"
+
+#include <QCoreApplication>
+#include <QDBusPendingCallWatcher>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+
+namespace dcc {
+
+// 直方图各桶的上限（毫秒），最后一桶收纳更慢的调用
+static const QVector<int> HistogramBoundsMs { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+static const int DefaultStallThresholdMs = 50;
+
+DBusTelemetry::SyncScope::SyncScope(const QString &method)
+    : m_method(method)
+{
+    m_timer.start();
+}
+
+DBusTelemetry::SyncScope::~SyncScope()
+{
+    DBusTelemetry::instance()->record(m_method, m_timer.nsecsElapsed() / 1000, true);
+}
+
+DBusTelemetry::DBusTelemetry(QObject *parent)
+    : QObject(parent)
+    , m_stallThresholdMs(DefaultStallThresholdMs)
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    bool ok = false;
+    const int threshold = qEnvironmentVariableIntValue("DCC_DBUS_STALL_MS", &ok);
+    if (ok && threshold > 0)
+        m_stallThresholdMs = threshold;
+}
+
+DBusTelemetry *DBusTelemetry::instance()
+{
+    static DBusTelemetry *telemetry = new DBusTelemetry(qApp);
+    return telemetry;
+}
+
+void DBusTelemetry::waitForFinished(QDBusPendingCall call, const QString &method)
+{
+    SyncScope scope(method);
+    call.waitForFinished();
+}
+
+void DBusTelemetry::track(const QDBusPendingCall &call, const QString &method)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 调用可能来自工作线程，watcher 留在调用方线程，避免等待主线程事件循环而多计耗时
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call);
+    connect(watcher, &QDBusPendingCallWatcher::finished, watcher, [this, method, timer](QDBusPendingCallWatcher *w) {
+        record(method, timer.nsecsElapsed() / 1000, false);
+        w->deleteLater();
+    });
+}
+
+void DBusTelemetry::record(const QString &method, qint64 elapsedUs, bool sync)
+{
+    const qint64 elapsedMs = elapsedUs / 1000;
+    // 只有 GUI 线程上的同步调用会卡住界面
+    const int threshold = m_stallThresholdMs.load();
+    const bool isStall = sync && elapsedMs >= threshold
+            && QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        MethodStats &stats = m_stats[method];
+        if (stats.histogram.isEmpty())
+            stats.histogram.fill(0, HistogramBoundsMs.size() + 1);
+
+        ++stats.count;
+        stats.totalUs += elapsedUs;
+        stats.maxUs = qMax(stats.maxUs, elapsedUs);
+        if (sync)
+            ++stats.syncCount;
+        if (isStall)
+            ++stats.stallCount;
+
+        int bucket = 0;
+        while (bucket < HistogramBoundsMs.size() && elapsedMs >= HistogramBoundsMs.at(bucket))
+            ++bucket;
+        ++stats.histogram[bucket];
+    }
+
+    if (isStall) {
+        qWarning() << "dbus call blocked the GUI thread:" << method << elapsedMs << "ms";
+        Q_EMIT stalled(method, elapsedMs);
+    }
+}
+
+QJsonObject DBusTelemetry::statistics() const
+{
+    QJsonArray bounds;
+    for (int bound : HistogramBoundsMs)
+        bounds << bound;
+
+    QJsonObject methods;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+            const MethodStats &stats = it.value();
+            QJsonArray histogram;
+            for (int count : stats.histogram)
+                histogram << count;
+
+            methods.insert(it.key(), QJsonObject {
+                { "count", stats.count },
+                { "sync", stats.syncCount },
+                { "stalls", stats.stallCount },
+                { "totalMs", stats.totalUs / 1000.0 },
+                { "averageMs", stats.count ? stats.totalUs / 1000.0 / stats.count : 0.0 },
+                { "maxMs", stats.maxUs / 1000.0 },
+                { "histogram", histogram },
+            });
+        }
+    }
+
+    return QJsonObject {
+        { "time", QDateTime::currentDateTime().toString(Qt::ISODate) },
+        { "stallThresholdMs", m_stallThresholdMs.load() },
+        { "histogramBoundsMs", bounds },
+        { "methods", methods },
+    };
+}
+
+QString DBusTelemetry::dumpToFile(const QString &fileName) const
+{
+    // 文件名可能来自 D-Bus 调用方，只允许写入缓存目录下的普通文件名
+    const QString name = fileName.isEmpty() ? QString("dbus-telemetry.json") : fileName;
+    if (name.contains('/') || name.startsWith('.')) {
+        qWarning() << "invalid dbus telemetry file name:" << fileName;
+        return QString();
+    }
+
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!QDir().mkpath(dir))
+        return QString();
+
+    const QString filePath = dir + "/" + name;
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "dump dbus telemetry failed:" << filePath << file.errorString();
+        return QString();
+    }
+
+    file.write(QJsonDocument(statistics()).toJson());
+    return file.commit() ? filePath : QString();
+}
+
+void DBusTelemetry::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stats.clear();
+}
+
+}
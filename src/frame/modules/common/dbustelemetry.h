@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBUSTELEMETRY_H
+#define DBUSTELEMETRY_H
+
+#include <QObject>
+#include <QAtomicInteger>
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QVector>
+
+namespace dcc {
+
+/**
+ * @brief DBusTelemetry 统计各 D-Bus 方法调用和属性读取的次数与耗时
+ *
+ * 同步调用用 SyncScope 或 waitForFinished() 计时，在 GUI 线程上超过阈值时记为卡顿并打印警告；
+ * 异步调用用 track() 统计从发出到返回的时间。统计结果可通过控制中心的 D-Bus 接口读取或写入文件。
+ * 方法名建议使用 "接口.方法"，属性读取使用 "接口.属性 [Get]"。
+ * 单例需要在主线程创建，之后可以在任意线程使用。
+ */
+class DBusTelemetry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DBusTelemetry *instance();
+
+    class SyncScope
+    {
+    public:
+        explicit SyncScope(const QString &method);
+        ~SyncScope();
+
+    private:
+        QString m_method;
+        QElapsedTimer m_timer;
+    };
+
+    // 阻塞等待 call 返回并计入同步调用
+    static void waitForFinished(QDBusPendingCall call, const QString &method);
+
+    /**
+     * @brief readProperty 计时读取生成的代理类的属性，同步代理的每次读取都是一次 Properties.Get 调用
+     * @param property "接口.属性"，记录为 "接口.属性 [Get]"
+     * @param getter 调用代理类的读取函数，如 [inter] { return inter->name(); }
+     */
+    template<typename Getter>
+    static auto readProperty(const QString &property, Getter getter) -> decltype(getter())
+    {
+        SyncScope scope(property + " [Get]");
+        return getter();
+    }
+
+    void track(const QDBusPendingCall &call, const QString &method);
+    void record(const QString &method, qint64 elapsedUs, bool sync);
+
+    int stallThreshold() const { return m_stallThresholdMs.load(); }
+    void setStallThreshold(int ms) { m_stallThresholdMs.store(ms); }
+
+    QJsonObject statistics() const;
+    /**
+     * @brief dumpToFile 以 JSON 格式将统计结果写入缓存目录
+     * @param fileName 文件名，不能包含路径，为空时使用 dbus-telemetry.json
+     * @return 写入的文件路径，失败时为空
+     */
+    QString dumpToFile(const QString &fileName = QString()) const;
+    void reset();
+
+Q_SIGNALS:
+    void stalled(const QString &method, qint64 elapsedMs);
+
+private:
+    explicit DBusTelemetry(QObject *parent = nullptr);
+
+    struct MethodStats {
+        int count = 0;
+        int syncCount = 0;
+        int stallCount = 0;
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+        QVector<int> histogram;
+    };
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, MethodStats> m_stats;
+    QAtomicInteger<int> m_stallThresholdMs;
+};
+
+}
+
+#endif // DBUSTELEMETRY_H
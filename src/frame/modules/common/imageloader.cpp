@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "imageloader.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QtConcurrent>
+#include <QDebug>
+
+namespace dcc {
+
+// 缓存上限，单位 KB
+static const int CacheLimitKB = 32 * 1024;
+
+ImageLoader::ImageLoader(QObject *parent)
+    : QObject(parent)
+    , m_cache(CacheLimitKB)
+{
+}
+
+ImageLoader *ImageLoader::instance()
+{
+    static ImageLoader *loader = new ImageLoader(qApp);
+    return loader;
+}
+
+QImage ImageLoader::readScaled(const QString &path, const QSize &pixelSize, Qt::AspectRatioMode mode)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    const QSize imageSize = reader.size();
+    if (imageSize.isValid() && pixelSize.isValid()) {
+        const QSize scaledSize = imageSize.scaled(pixelSize, mode);
+        // 只缩小，避免放大后占用更多内存
+        if (scaledSize.width() < imageSize.width() || scaledSize.height() < imageSize.height())
+            reader.setScaledSize(scaledSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull())
+        qWarning() << "failed to read image:" << path << reader.errorString();
+
+    return image;
+}
+
+void ImageLoader::load(const QString &path, const QSize &size, qreal ratio, QObject *context,
+                       std::function<void(const QPixmap &)> callback, Qt::AspectRatioMode mode)
+{
+    const QFileInfo info(path);
+    if (!info.isFile()) {
+        callback(QPixmap());
+        return;
+    }
+
+    // 文件可能被原地替换（如 grub 背景），修改时间也作为键的一部分
+    const QSize pixelSize = size * ratio;
+    const QString key = QString("%1|%2|%3x%4|%5|%6").arg(path).arg(info.lastModified().toMSecsSinceEpoch())
+                        .arg(pixelSize.width()).arg(pixelSize.height()).arg(ratio).arg(mode);
+
+    if (QPixmap *pixmap = m_cache.object(key)) {
+        callback(*pixmap);
+        return;
+    }
+
+    const bool loading = m_pendingRequests.contains(key);
+    m_pendingRequests[key].append({context, callback});
+    if (loading)
+        return;
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, ratio] {
+        onImageLoaded(key, watcher->result(), ratio);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(&ImageLoader::readScaled, path, pixelSize, mode));
+}
+
+void ImageLoader::onImageLoaded(const QString &key, const QImage &image, qreal ratio)
+{
+    QPixmap pixmap = QPixmap::fromImage(image);
+    pixmap.setDevicePixelRatio(ratio);
+
+    if (!pixmap.isNull())
+        m_cache.insert(key, new QPixmap(pixmap), qMax(1, image.bytesPerLine() * image.height() / 1024));
+
+    const QList<PendingRequest> requests = m_pendingRequests.take(key);
+    for (const PendingRequest &request : requests) {
+        if (request.context)
+            request.callback(pixmap);
+    }
+}
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+
+#include <functional>
+
+namespace dcc {
+
+/**
+ * @brief ImageLoader 图片异步加载服务
+ *
+ * 图片在线程池中用 QImageReader 直接按目标尺寸解码，结果按文件、修改时间和尺寸缓存，
+ * 相同的请求只解码一次。
+ */
+class ImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ImageLoader *instance();
+
+    /**
+     * @brief load 异步加载图片，已缓存时立即回调
+     * @param path 本地文件路径
+     * @param size 目标逻辑尺寸，图片按 mode 缩放到 size * ratio，不会放大
+     * @param ratio 设备像素比，返回的 pixmap 已设置该值
+     * @param context 回调上下文，销毁后不再回调
+     * @param callback 加载结果回调，在 GUI 线程执行，失败时为空 pixmap
+     */
+    void load(const QString &path, const QSize &size, qreal ratio, QObject *context,
+              std::function<void(const QPixmap &)> callback, Qt::AspectRatioMode mode = Qt::KeepAspectRatio);
+
+    /**
+     * @brief readScaled 按目标像素尺寸解码图片，可在任意线程调用
+     */
+    static QImage readScaled(const QString &path, const QSize &pixelSize, Qt::AspectRatioMode mode);
+
+private:
+    explicit ImageLoader(QObject *parent = nullptr);
+
+    void onImageLoaded(const QString &key, const QImage &image, qreal ratio);
+
+private:
+    struct PendingRequest {
+        QPointer<QObject> context;
+        std::function<void(const QPixmap &)> callback;
+    };
+
+    QCache<QString, QPixmap> m_cache;
+    QHash<QString, QList<PendingRequest>> m_pendingRequests;
+};
+
+}
+
+#endif // IMAGELOADER_H
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "licensestate.h"
+#include "dbusproxyregistry.h"
+
+#include <QCoreApplication>
+#include <QThread>
+#include <QDebug>
+
+namespace dcc {
+
+static const QString AuthorizationState = QStringLiteral("AuthorizationState");
+
+LicenseState::LicenseState(QObject *parent)
+    : QObject(parent)
+    , m_licenseInfo(DBusProxyRegistry::instance()->proxy(QDBusConnection::systemBus(),
+                                                         "com.deepin.license",
+                                                         "/com/deepin/license/Info",
+                                                         "com.deepin.license.Info"))
+    , m_valid(false)
+    , m_state(0)
+{
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+
+    // 代理创建时已经发出一次 GetAll，结果通过 propertyChanged 送达
+    connect(m_licenseInfo.data(), &DBusObjectProxy::propertyChanged, this, [this](const QString &name, const QVariant &value) {
+        if (name == AuthorizationState)
+            setState(value.toUInt());
+    });
+
+    m_licenseInfo->subscribe("LicenseStateChange");
+    connect(m_licenseInfo.data(), &DBusObjectProxy::dbusSignal, this, [this](const QString &name) {
+        if (name == "LicenseStateChange")
+            refresh();
+    });
+
+    if (m_licenseInfo->hasCachedProperty(AuthorizationState))
+        setState(m_licenseInfo->cachedProperty(AuthorizationState).toUInt());
+}
+
+LicenseState *LicenseState::instance()
+{
+    static LicenseState *state = new LicenseState(qApp);
+    return state;
+}
+
+void LicenseState::subscribe(QObject *context, std::function<void(quint32)> callback)
+{
+    connect(this, &LicenseState::authorizationStateChanged, context, [callback](quint32 state) {
+        callback(state);
+    });
+
+    if (m_valid)
+        callback(m_state);
+}
+
+void LicenseState::refresh()
+{
+    m_licenseInfo->refresh();
+}
+
+void LicenseState::setState(quint32 state)
+{
+    if (m_valid && m_state == state)
+        return;
+
+    qDebug() << "authorize result:" << state;
+    m_valid = true;
+    m_state = state;
+    Q_EMIT authorizationStateChanged(state);
+}
+
+}
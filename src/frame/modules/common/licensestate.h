@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LICENSESTATE_H
+#define LICENSESTATE_H
+
+#include <QObject>
+#include <QSharedPointer>
+
+#include <functional>
+
+namespace dcc {
+
+class DBusObjectProxy;
+
+/**
+ * @brief LicenseState 进程内共享的系统授权状态
+ *
+ * 基于 com.deepin.license.Info 的共享代理，收到 LicenseStateChange 后异步刷新，
+ * 各模块通过 subscribe() 获取状态，不再各自创建接口或占用线程池同步读取。
+ * 只能在主线程创建和使用，工作线程通过排队连接 authorizationStateChanged 接收状态。
+ */
+class LicenseState : public QObject
+{
+    Q_OBJECT
+
+public:
+    static LicenseState *instance();
+
+    // 是否已经取得过授权状态，服务不存在时始终为 false
+    bool isValid() const { return m_valid; }
+    quint32 authorizationState() const { return m_state; }
+    // 已授权或处于试用期
+    static bool isActivated(quint32 state) { return state == 1 || state == 3; }
+
+    /**
+     * @brief subscribe 已取得状态时立即回调一次，之后每次变化时回调；context 销毁后自动取消
+     */
+    void subscribe(QObject *context, std::function<void(quint32)> callback);
+
+public Q_SLOTS:
+    void refresh();
+
+Q_SIGNALS:
+    void authorizationStateChanged(quint32 state);
+
+private:
+    explicit LicenseState(QObject *parent = nullptr);
+
+    void setState(quint32 state);
+
+private:
+    QSharedPointer<DBusObjectProxy> m_licenseInfo;
+    bool m_valid;
+    quint32 m_state;
+};
+
+}
+
+#endif // LICENSESTATE_H
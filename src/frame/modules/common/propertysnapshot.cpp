@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "propertysnapshot.h"
+#include "dbustelemetry.h"
+
+#include <QDBusAbstractInterface>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QSharedPointer>
+#include <QDebug>
+
+namespace dcc {
+
+PropertySnapshot &PropertySnapshot::add(const QDBusAbstractInterface *inter, const QStringList &properties)
+{
+    return add(inter->connection(), inter->service(), inter->path(), inter->interface(), properties);
+}
+
+PropertySnapshot &PropertySnapshot::add(const QDBusConnection &connection, const QString &service, const QString &path,
+                                        const QString &interface, const QStringList &properties)
+{
+    m_requests.append({connection, service, path, interface, properties});
+    return *this;
+}
+
+void PropertySnapshot::fetch(QObject *context, std::function<void(const PropertySnapshot &)> callback) const
+{
+    struct State {
+        PropertySnapshot snapshot;
+        int pending;
+        std::function<void(const PropertySnapshot &)> callback;
+    };
+
+    QSharedPointer<State> state(new State{*this, m_requests.size(), callback});
+    if (m_requests.isEmpty()) {
+        callback(state->snapshot);
+        return;
+    }
+
+    for (const Request &request : m_requests) {
+        QDBusMessage msg = QDBusMessage::createMethodCall(request.service, request.path,
+                                                          "org.freedesktop.DBus.Properties", "GetAll");
+        msg << request.interface;
+
+        const QDBusPendingCall call = request.connection.asyncCall(msg);
+        DBusTelemetry::instance()->track(call, request.interface + " [GetAll]");
+
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, context);
+        QObject::connect(watcher, &QDBusPendingCallWatcher::finished, context, [state, request, watcher] {
+            QDBusPendingReply<QVariantMap> reply = *watcher;
+            if (reply.isError()) {
+                qDebug() << "get all properties failed:" << request.service << request.path << reply.error().message();
+            } else {
+                QVariantMap values = reply.value();
+                if (!request.properties.isEmpty()) {
+                    for (auto it = values.begin(); it != values.end();) {
+                        if (request.properties.contains(it.key()))
+                            ++it;
+                        else
+                            it = values.erase(it);
+                    }
+                }
+                state->snapshot.m_values.insert(key(request.service, request.path, request.interface), values);
+            }
+            watcher->deleteLater();
+
+            if (--state->pending == 0)
+                state->callback(state->snapshot);
+        });
+    }
+}
+
+bool PropertySnapshot::contains(const QDBusAbstractInterface *inter, const QString &name) const
+{
+    return m_values.value(key(inter->service(), inter->path(), inter->interface())).contains(name);
+}
+
+QVariant PropertySnapshot::value(const QDBusAbstractInterface *inter, const QString &name) const
+{
+    return value(inter->service(), inter->path(), inter->interface(), name);
+}
+
+QVariant PropertySnapshot::value(const QString &service, const QString &path, const QString &interface, const QString &name) const
+{
+    return m_values.value(key(service, path, interface)).value(name);
+}
+
+QString PropertySnapshot::key(const QString &service, const QString &path, const QString &interface)
+{
+    return QString("%1|%2|%3").arg(service, path, interface);
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTYSNAPSHOT_H
+#define PROPERTYSNAPSHOT_H
+
+#include <QDBusConnection>
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <functional>
+
+class QDBusAbstractInterface;
+
+namespace dcc {
+
+/**
+ * @brief PropertySnapshot 一次性读取多个接口的属性
+ *
+ * 先用 add() 声明需要的属性，fetch() 对每个接口只发一次异步 GetAll，
+ * 全部返回后一次性回调，用于模块激活时批量刷新 model。
+ */
+class PropertySnapshot
+{
+public:
+    /**
+     * @brief add 声明要读取的接口和属性，properties 为空时保留该接口的全部属性
+     */
+    PropertySnapshot &add(const QDBusAbstractInterface *inter, const QStringList &properties = QStringList());
+    PropertySnapshot &add(const QDBusConnection &connection, const QString &service, const QString &path,
+                          const QString &interface, const QStringList &properties = QStringList());
+
+    /**
+     * @brief fetch 异步获取所有声明的属性，完成后回调；context 销毁后不再回调
+     */
+    void fetch(QObject *context, std::function<void(const PropertySnapshot &)> callback) const;
+
+    bool contains(const QDBusAbstractInterface *inter, const QString &name) const;
+    // 获取失败或未声明的属性返回无效的 QVariant，复合类型为 QDBusArgument，需要 qdbus_cast
+    QVariant value(const QDBusAbstractInterface *inter, const QString &name) const;
+    QVariant value(const QString &service, const QString &path, const QString &interface, const QString &name) const;
+
+private:
+    struct Request {
+        QDBusConnection connection;
+        QString service;
+        QString path;
+        QString interface;
+        QStringList properties;
+    };
+
+    static QString key(const QString &service, const QString &path, const QString &interface);
+
+private:
+    QList<Request> m_requests;
+    QHash<QString, QVariantMap> m_values;
+};
+
+}
+
+#endif // PROPERTYSNAPSHOT_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "systemcapabilities.h"
+
+#include <QCoreApplication>
+#include <QFutureWatcher>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+#include <sys/utsname.h>
+
+namespace dcc {
+
+SystemCapabilities::SystemCapabilities(QObject *parent)
+    : QObject(parent)
+{
+    struct utsname name;
+    if (uname(&name) == 0)
+        m_kernelRelease = QString::fromLocal8Bit(name.release);
+}
+
+SystemCapabilities *SystemCapabilities::instance()
+{
+    static SystemCapabilities *capabilities = new SystemCapabilities(qApp);
+    return capabilities;
+}
+
+bool SystemCapabilities::findExecutableInPath(const QString &name)
+{
+    return !QStandardPaths::findExecutable(name).isEmpty();
+}
+
+void SystemCapabilities::queryExecutable(const QString &name, QObject *context, std::function<void(bool)> callback)
+{
+    auto cached = m_executables.constFind(name);
+    if (cached != m_executables.constEnd()) {
+        callback(cached.value());
+        return;
+    }
+
+    const bool probing = m_pendingQueries.contains(name);
+    m_pendingQueries[name].append({context, callback});
+    if (probing)
+        return;
+
+    QFutureWatcher<bool> *watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, name] {
+        onExecutableProbed(name, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(&SystemCapabilities::findExecutableInPath, name));
+}
+
+void SystemCapabilities::onExecutableProbed(const QString &name, bool found)
+{
+    m_executables.insert(name, found);
+
+    const QList<PendingQuery> queries = m_pendingQueries.take(name);
+    for (const PendingQuery &query : queries) {
+        if (query.context)
+            query.callback(found);
+    }
+}
+
+}
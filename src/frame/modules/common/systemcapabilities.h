@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYSTEMCAPABILITIES_H
+#define SYSTEMCAPABILITIES_H
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+
+#include <functional>
+
+namespace dcc {
+
+/**
+ * @brief SystemCapabilities 系统能力探测，每个会话只解析一次并缓存结果
+ *
+ * 可执行文件查找在进程内扫描 PATH，内核版本通过 uname(2) 获取，不再 fork 子进程。
+ */
+class SystemCapabilities : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SystemCapabilities *instance();
+
+    /**
+     * @brief queryExecutable 异步查询 PATH 中是否存在可执行文件，已缓存时立即回调
+     * @param name 可执行文件名
+     * @param context 回调上下文，销毁后不再回调
+     * @param callback 查询结果回调，在 GUI 线程执行
+     */
+    void queryExecutable(const QString &name, QObject *context, std::function<void(bool)> callback);
+
+    /**
+     * @brief kernelRelease 内核版本，等同于 uname -r
+     */
+    QString kernelRelease() const { return m_kernelRelease; }
+
+    static bool findExecutableInPath(const QString &name);
+
+private:
+    explicit SystemCapabilities(QObject *parent = nullptr);
+
+    void onExecutableProbed(const QString &name, bool found);
+
+private:
+    struct PendingQuery {
+        QPointer<QObject> context;
+        std::function<void(bool)> callback;
+    };
+
+    QString m_kernelRelease;
+    QHash<QString, bool> m_executables;
+    QHash<QString, QList<PendingQuery>> m_pendingQueries;
+};
+
+}
+
+#endif // SYSTEMCAPABILITIES_H
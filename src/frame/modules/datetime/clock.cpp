@@ -24,6 +24,7 @@
  */
 
 #include "clock.h"
+#include "clockticker.h"
 
 #include <QPainter>
 #include <QPainterPath>
@@ -36,9 +37,17 @@ namespace datetime {
 Clock::Clock(QWidget *parent) :
     QWidget(parent),
     m_drawTicks(true),
-    m_autoNightMode(true)
+    m_autoNightMode(true),
+    m_lastMinute(-1)
 {
-
+    // 只绘制时针和分针，分钟变化时才需要重绘
+    ClockTicker::instance()->subscribe(this, [this] {
+        const int minute = QTime::currentTime().minute();
+        if (minute != m_lastMinute) {
+            m_lastMinute = minute;
+            update();
+        }
+    });
 }
 
 Clock::~Clock()
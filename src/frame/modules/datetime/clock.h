@@ -54,6 +54,7 @@ protected:
 private:
     bool m_drawTicks;
     bool m_autoNightMode;
+    int m_lastMinute;
     ZoneInfo m_timeZone;
 };
 }
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clockticker.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QTime>
+#include <QTimer>
+#include <QWidget>
+
+namespace dcc {
+namespace datetime {
+
+// 在整秒之后稍作延迟再触发，避免定时器提前几毫秒到达时读到上一秒
+static const int TickSlackMs = 5;
+
+ClockTicker::ClockTicker(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ClockTicker::onTimeout);
+}
+
+ClockTicker *ClockTicker::instance()
+{
+    static ClockTicker *ticker = new ClockTicker(qApp);
+    return ticker;
+}
+
+void ClockTicker::subscribe(QWidget *widget, std::function<void()> callback)
+{
+    if (!widget)
+        return;
+
+    if (!m_subscribers.contains(widget)) {
+        widget->installEventFilter(this);
+        connect(widget, &QObject::destroyed, this, [this, widget] {
+            m_subscribers.remove(widget);
+            updateTimer();
+        });
+    }
+
+    m_subscribers.insert(widget, callback);
+    updateTimer();
+}
+
+void ClockTicker::unsubscribe(QWidget *widget)
+{
+    if (!m_subscribers.remove(widget))
+        return;
+
+    widget->removeEventFilter(this);
+    disconnect(widget, &QObject::destroyed, this, nullptr);
+    updateTimer();
+}
+
+bool ClockTicker::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Show) {
+        // 隐藏期间没有刷新，重新显示时先补一次
+        auto it = m_subscribers.constFind(static_cast<QWidget *>(watched));
+        if (it != m_subscribers.constEnd())
+            it.value()();
+        updateTimer();
+    } else if (event->type() == QEvent::Hide) {
+        updateTimer();
+    }
+
+    return false;
+}
+
+void ClockTicker::onTimeout()
+{
+    // 回调中可能取消订阅，先复制一份
+    const auto subscribers = m_subscribers;
+    for (auto it = subscribers.constBegin(); it != subscribers.constEnd(); ++it) {
+        if (m_subscribers.contains(it.key()) && it.key()->isVisible())
+            it.value()();
+    }
+
+    updateTimer();
+}
+
+void ClockTicker::updateTimer()
+{
+    if (!hasVisibleSubscriber()) {
+        m_timer->stop();
+        return;
+    }
+
+    if (!m_timer->isActive())
+        m_timer->start(1000 - QTime::currentTime().msec() + TickSlackMs);
+}
+
+bool ClockTicker::hasVisibleSubscriber() const
+{
+    for (auto it = m_subscribers.constBegin(); it != m_subscribers.constEnd(); ++it) {
+        if (it.key()->isVisible())
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace datetime
+} // namespace dcc
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLOCKTICKER_H
+#define CLOCKTICKER_H
+
+#include <QObject>
+#include <QHash>
+
+#include <functional>
+
+class QTimer;
+class QWidget;
+
+namespace dcc {
+namespace datetime {
+
+/**
+ * @brief ClockTicker 所有时钟共用的秒定时器
+ *
+ * 定时器对齐到整秒触发，只回调当前可见的订阅者；没有可见的订阅者时停止计时。
+ */
+class ClockTicker : public QObject
+{
+    Q_OBJECT
+public:
+    static ClockTicker *instance();
+
+    /**
+     * @brief subscribe 订阅秒信号，widget 可见时每秒回调一次，重新显示时会立即回调一次
+     * @param widget 订阅者，销毁时自动取消订阅
+     * @param callback 回调函数
+     */
+    void subscribe(QWidget *widget, std::function<void()> callback);
+    void unsubscribe(QWidget *widget);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit ClockTicker(QObject *parent = nullptr);
+
+    void onTimeout();
+    void updateTimer();
+    bool hasVisibleSubscriber() const;
+
+private:
+    QTimer *m_timer;
+    QHash<QWidget *, std::function<void()>> m_subscribers;
+};
+
+} // namespace datetime
+} // namespace dcc
+
+#endif // CLOCKTICKER_H
@@ -75,6 +75,16 @@ double ConvertPos(const QString& pos, int digits) {
   }
 }
 
+// Remove continent name from translated timezone name.
+QString StripContinentName(const QString& local_name) {
+  int index = local_name.lastIndexOf('/');
+  if (index == -1) {
+    // Some translations of locale name contains non-standard char.
+    index = local_name.lastIndexOf("∕");
+  }
+  return (index > -1) ? local_name.mid(index + 1) : local_name;
+}
+
 }  // namespace
 
 bool ZoneInfoDistanceComp(const ZoneInfo& a, const ZoneInfo& b) {
@@ -152,18 +162,37 @@ QString GetTimezoneName(const QString& timezone) {
 QString GetLocalTimezoneName(const QString& timezone, const QString& locale) {
   // Set locale first.
   (void) setlocale(LC_ALL, QString(locale + ".UTF-8").toStdString().c_str());
-  const QString local_name(dgettext(kTimezoneDomain,
-                                    timezone.toStdString().c_str()));
-  int index = local_name.lastIndexOf('/');
-  if (index == -1) {
-    // Some translations of locale name contains non-standard char.
-    index = local_name.lastIndexOf("∕");
-  }
+  const QString local_name(StripContinentName(
+      dgettext(kTimezoneDomain, timezone.toStdString().c_str())));
 
   // Reset locale.
   (void) setlocale(LC_ALL, kDefaultLocale);
 
-  return (index > -1) ? local_name.mid(index + 1) : local_name;
+  return local_name;
+}
+
+QStringList GetLocalTimezoneNames(const QStringList& timezones,
+                                  const QString& locale) {
+  QStringList names;
+  names.reserve(timezones.length());
+
+  const locale_t new_locale = newlocale(
+      LC_ALL_MASK, QString(locale + ".UTF-8").toStdString().c_str(),
+      static_cast<locale_t>(0));
+  const locale_t old_locale =
+      new_locale ? uselocale(new_locale) : static_cast<locale_t>(0);
+
+  for (const QString& timezone : timezones) {
+    names.append(StripContinentName(
+        dgettext(kTimezoneDomain, timezone.toStdString().c_str())));
+  }
+
+  if (new_locale) {
+    (void) uselocale(old_locale);
+    freelocale(new_locale);
+  }
+
+  return names;
 }
 
 TimezoneAliasMap GetTimezoneAliasMap() {
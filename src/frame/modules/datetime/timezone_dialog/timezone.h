@@ -32,6 +32,7 @@
 
 #include <QList>
 #include <QHash>
+#include <QStringList>
 
 namespace installer {
 
@@ -69,6 +70,12 @@ QString GetTimezoneName(const QString& timezone);
 // |locale| is desired locale name.
 QString GetLocalTimezoneName(const QString& timezone, const QString& locale);
 
+// Returns local names of |timezones|, in the same order.
+// Unlike GetLocalTimezoneName(), this switches locale only once and only for
+// the calling thread, so it is safe to call from a worker thread.
+QStringList GetLocalTimezoneNames(const QStringList& timezones,
+                                  const QString& locale);
+
 // A map between old name of timezone and current name.
 // e.g. Asia/Chongqing -> Asia/Shanghai
 typedef QHash<QString, QString> TimezoneAliasMap;
@@ -30,15 +30,14 @@
 #include "timezone_map.h"
 
 #include <QDebug>
+#include <QImageReader>
 #include <QItemSelectionModel>
 #include <QLabel>
 #include <QListView>
 #include <QMouseEvent>
 #include <QVBoxLayout>
-#include "widgets/basiclistdelegate.h"
 
 #include "file_util.h"
-#include "timezone_map_util.h"
 #include "popup_menu.h"
 #include "tooltip_pin.h"
 
@@ -68,6 +67,7 @@ TimezoneMap::TimezoneMap(QWidget* parent)
     : QFrame(parent),
       current_zone_(),
       total_zones_(GetZoneInfoList()),
+      zone_locator_(total_zones_),
       nearest_zones_() {
   this->setObjectName("timezone_map");
 
@@ -107,9 +107,9 @@ bool TimezoneMap::setTimezone(const QString &timezone)
 void TimezoneMap::mousePressEvent(QMouseEvent* event) {
   if (event->button() == Qt::LeftButton) {
     // Get nearest zones around mouse.
-    nearest_zones_ = GetNearestZones(total_zones_, kDistanceThreshold,
-                                     event->x(), event->y(),
-                                     this->width(), this->height());
+    nearest_zones_ = zone_locator_.nearestZones(kDistanceThreshold,
+                                                event->x(), event->y(),
+                                                this->width(), this->height());
     qDebug() << nearest_zones_;
     current_zone_ = nearest_zones_.first();
     if (nearest_zones_.length() == 1) {
@@ -130,11 +130,7 @@ void TimezoneMap::resizeEvent(QResizeEvent* event) {
     popup_window_->hide();
   }
 
-  QLabel *background_label = findChild<QLabel*>("background_label");
-  if (background_label) {
-      QPixmap timezone_pixmap = loadPixmap(kTimezoneMapFile);
-      background_label->setPixmap(timezone_pixmap.scaled(event->size() * devicePixelRatioF(), Qt::KeepAspectRatio, Qt::FastTransformation));
-  }
+  this->updateMapPixmap(event->size());
 
   QWidget::resizeEvent(event);
 }
@@ -150,11 +146,9 @@ void TimezoneMap::initConnections() {
 }
 
 void TimezoneMap::initUI() {
-  QLabel* background_label = new QLabel(this);
-  background_label->setObjectName("background_label");
-  QPixmap timezone_pixmap = loadPixmap(kTimezoneMapFile);
-  Q_ASSERT(!timezone_pixmap.isNull());
-  background_label->setPixmap(timezone_pixmap);
+  background_label_ = new QLabel(this);
+  background_label_->setObjectName("background_label");
+  this->updateMapPixmap(QImageReader(kTimezoneMapFile).size());
 
   // Set parent widget of dot_ to SystemInfoTimezoneFrame.
   dot_ = new QLabel(this->parentWidget());
@@ -178,6 +172,26 @@ void TimezoneMap::initUI() {
   this->setContentsMargins(0, 0, 0, 0);
 }
 
+void TimezoneMap::updateMapPixmap(const QSize& size) {
+  const qreal ratio = devicePixelRatioF();
+  const QSize pixmap_size = size * ratio;
+  if (pixmap_size.isEmpty() || pixmap_size == map_pixmap_size_) {
+    return;
+  }
+  map_pixmap_size_ = pixmap_size;
+
+  // Render svg directly at target device pixel size, instead of loading it
+  // at default size and rescaling.
+  QImageReader reader(kTimezoneMapFile);
+  reader.setScaledSize(reader.size().scaled(pixmap_size, Qt::KeepAspectRatio));
+  QPixmap timezone_pixmap = QPixmap::fromImage(reader.read());
+  Q_ASSERT(!timezone_pixmap.isNull());
+  timezone_pixmap.setDevicePixelRatio(ratio);
+
+  background_label_->setPixmap(timezone_pixmap);
+  background_label_->resize(timezone_pixmap.size() / ratio);
+}
+
 void TimezoneMap::popupZoneWindow(const QPoint& pos) {
   // Hide all marks first.
   dot_->hide();
@@ -37,6 +37,7 @@ class QResizeEvent;
 class QStringListModel;
 
 #include "timezone.h"
+#include "timezone_map_util.h"
 
 namespace installer {
 
@@ -77,15 +78,26 @@ class TimezoneMap : public QFrame {
   // Mark current zone on the map.
   void remark();
 
+  // Render world map for |size|, skipped if size is not changed.
+  void updateMapPixmap(const QSize& size);
+
   // Currently selected/marked timezone.
   ZoneInfo current_zone_;
 
   // A list of zone info found in system.
   const ZoneInfoList total_zones_;
 
+  // Spatial index of total_zones_, must be declared after it.
+  ZoneLocator zone_locator_;
+
   // A list of zone info which are near enough to current cursor position.
   ZoneInfoList nearest_zones_;
 
+  QLabel* background_label_ = nullptr;
+
+  // Device pixel size of current rendered map.
+  QSize map_pixmap_size_;
+
   // A round dot to indicate position on the map.
   QLabel* dot_ = nullptr;
 
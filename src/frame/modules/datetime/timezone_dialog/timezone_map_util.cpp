@@ -31,6 +31,8 @@
 
 #include <math.h>
 
+#include <algorithm>
+
 namespace installer {
 
 namespace {
@@ -92,4 +94,116 @@ ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
   return zones;
 }
 
+ZoneLocator::ZoneLocator(const ZoneInfoList& total_zones)
+    : total_zones_(total_zones) {
+  positions_.reserve(total_zones.length());
+  for (const ZoneInfo& zone : total_zones) {
+    positions_.append(QPointF(ConvertLongitudeToX(zone.longitude),
+                              ConvertLatitudeToY(zone.latitude)));
+  }
+}
+
+ZoneInfoList ZoneLocator::nearestZones(double threshold, int x, int y,
+                                       int map_width, int map_height) {
+  ZoneInfoList zones;
+  if (positions_.isEmpty() || map_width <= 0 || map_height <= 0) {
+    return zones;
+  }
+
+  if (grid_map_size_ != QSize(map_width, map_height) ||
+      grid_threshold_ != threshold) {
+    this->rebuildGrid(threshold, map_width, map_height);
+  }
+
+  const int center_column = qBound(0, int(x / cell_size_), columns_ - 1);
+  const int center_row = qBound(0, int(y / cell_size_), rows_ - 1);
+
+  // Visit cells ring by ring around (x, y). Zones out of the visited square
+  // cannot be closer than its border, so stop once the nearest zone found
+  // is closer than that and the threshold circle is covered.
+  QVector<int> matched;
+  double minimum_distance = -1.0;
+  int nearest_zone_index = -1;
+  const int max_ring = qMax(columns_, rows_);
+  for (int ring = 0; ring <= max_ring; ring++) {
+    // Distance from (x, y) to the border of rings visited so far.
+    const double covered = (ring - 1) * cell_size_;
+    if (ring > 0 && nearest_zone_index > -1 &&
+        covered * covered >= threshold &&
+        covered * covered >= minimum_distance) {
+      break;
+    }
+
+    for (int row = center_row - ring; row <= center_row + ring; row++) {
+      if (row < 0 || row >= rows_) {
+        continue;
+      }
+      for (int column = center_column - ring; column <= center_column + ring;
+           column++) {
+        if (column < 0 || column >= columns_) {
+          continue;
+        }
+        // Only visit cells on the border of this ring.
+        if (row != center_row - ring && row != center_row + ring &&
+            column != center_column - ring && column != center_column + ring) {
+          continue;
+        }
+        for (int index : cells_.at(this->cellIndex(column, row))) {
+          const QPointF& pos = positions_.at(index);
+          const double dx = pos.x() * map_width - x;
+          const double dy = pos.y() * map_height - y;
+          const double distance = dx * dx + dy * dy;
+          if (nearest_zone_index == -1 || distance < minimum_distance ||
+              (distance == minimum_distance && index < nearest_zone_index)) {
+            minimum_distance = distance;
+            nearest_zone_index = index;
+          }
+          if (distance <= threshold) {
+            matched.append(index);
+          }
+        }
+      }
+    }
+  }
+
+  // Keep the order of total zones, same as GetNearestZones().
+  std::sort(matched.begin(), matched.end());
+  for (int index : matched) {
+    zones.append(total_zones_.at(index));
+  }
+
+  // Get the nearest zone.
+  if (zones.isEmpty() && nearest_zone_index > -1) {
+    zones.append(total_zones_.at(nearest_zone_index));
+  }
+
+  return zones;
+}
+
+void ZoneLocator::rebuildGrid(double threshold, int map_width,
+                              int map_height) {
+  // One cell covers the threshold radius, so a hit test usually visits
+  // the 3x3 cells around cursor only.
+  cell_size_ = qMax(1.0, sqrt(threshold));
+  columns_ = qMax(1, int(ceil(map_width / cell_size_)));
+  rows_ = qMax(1, int(ceil(map_height / cell_size_)));
+  grid_map_size_ = QSize(map_width, map_height);
+  grid_threshold_ = threshold;
+
+  cells_.clear();
+  cells_.resize(columns_ * rows_);
+  for (int index = 0; index < positions_.length(); index++) {
+    const QPointF& pos = positions_.at(index);
+    const int column = qBound(0, int(pos.x() * map_width / cell_size_),
+                              columns_ - 1);
+    const int row = qBound(0, int(pos.y() * map_height / cell_size_),
+                           rows_ - 1);
+    cells_[this->cellIndex(column, row)].append(index);
+  }
+}
+
+int ZoneLocator::cellIndex(int column, int row) const {
+  return row * columns_ + column;
+}
+
 }  // namespace installer
@@ -32,6 +32,10 @@
 
 #include "timezone.h"
 
+#include <QPointF>
+#include <QSize>
+#include <QVector>
+
 namespace installer {
 
 // Convert position of zone from polar coordinates to rectangular coordinates.
@@ -43,6 +47,36 @@ double ConvertLongitudeToX(double longitude);
 ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
                              int x, int y, int map_width, int map_height);
 
+// Spatial index of zones for hit-testing on the map.
+// Projected coordinates are computed only once; the grid is rebuilt only
+// when map size changes.
+class ZoneLocator {
+ public:
+  explicit ZoneLocator(const ZoneInfoList& total_zones);
+
+  // Same result as GetNearestZones(), but only zones in grid cells around
+  // (x, y) are visited.
+  ZoneInfoList nearestZones(double threshold, int x, int y,
+                            int map_width, int map_height);
+
+ private:
+  void rebuildGrid(double threshold, int map_width, int map_height);
+  int cellIndex(int column, int row) const;
+
+  const ZoneInfoList& total_zones_;
+
+  // Projected coordinates in range [0, 1], same order as total_zones_.
+  QVector<QPointF> positions_;
+
+  // Zone indexes of each cell, in row-major order.
+  QVector<QVector<int>> cells_;
+  double cell_size_ = 0.0;
+  int columns_ = 0;
+  int rows_ = 0;
+  QSize grid_map_size_;
+  double grid_threshold_ = -1.0;
+};
+
 }  // namespace installer
 
 #endif  // INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
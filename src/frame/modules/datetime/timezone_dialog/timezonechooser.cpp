@@ -46,6 +46,9 @@
 #include <QLabel>
 #include <QStyleFactory>
 #include <QAbstractItemView>
+#include <QStringListModel>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 DWIDGET_USE_NAMESPACE
 
@@ -63,6 +66,7 @@ TimeZoneChooser::TimeZoneChooser()
     , m_currLangSelector(new LangSelector("com.deepin.daemon.LangSelector",
                                           "/com/deepin/daemon/LangSelector",
                                           QDBusConnection::sessionBus(), this))
+    , m_completionModel(new QStringListModel(this))
 {
     setWindowFlags(Qt::Dialog);
     setAttribute(Qt::WA_TranslucentBackground);
@@ -133,7 +137,7 @@ TimeZoneChooser::TimeZoneChooser()
 
     connect(m_searchInput, &SearchInput::editingFinished, [this] {
         QString timezone = m_searchInput->text();
-        timezone = m_completionCache.value(timezone, timezone);
+        timezone = m_timezoneTable.zoneForName(timezone);
         if (m_map->setTimezone(timezone) && !m_confirmBtn->isEnabled())
             m_confirmBtn->setEnabled(true);
     });
@@ -146,54 +150,48 @@ TimeZoneChooser::TimeZoneChooser()
         m_confirmBtn->setEnabled(true);
     });
 
-    QTimer::singleShot(0, [this] {
-        QStringList completions;
-        QStringList completions_filter;
-        for (QString timezone : QTimeZone::availableTimeZoneIds()) {
-            completions << timezone; // timezone as completion candidate.
+    m_completer = new QCompleter(m_completionModel, this);
+    m_completer->setWidget(m_searchInput);
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_completer->popup()->setAttribute(Qt::WA_InputMethodEnabled);
+    connect(m_completer, static_cast<void (QCompleter::*)(const QString &)>(&QCompleter::activated),
+            m_searchInput, &SearchInput::setText);
 
-            // localized timezone as completion candidate.
-            const QString locale = QLocale::system().name();
-            QString localizedTimezone = installer::GetLocalTimezoneName(timezone, locale);
-            completions << localizedTimezone;
+    m_popup = m_completer->popup();
+    m_popup->setObjectName("TimezoneCompleter");
+    m_popup->setAttribute(Qt::WA_TranslucentBackground);
+    m_popup->installEventFilter(this);
 
-            m_completionCache[localizedTimezone] = timezone;
-        }
-
-        if ("en_US.UTF-8" == m_currLangSelector->currentLocale()) {
-            int i = 0;
-            for (auto str : completions) {
-                if ( i++ % 2 == 0) continue;
-                completions_filter << str;
-            }
-            m_completer = new QCompleter(completions_filter, m_searchInput);
-        } else {
-            m_completer = new QCompleter(completions, m_searchInput);
-        }
-
-        m_completer->popup()->setAttribute(Qt::WA_InputMethodEnabled);
-        m_completer->setCompletionMode(QCompleter::PopupCompletion);
-        m_completer->setCaseSensitivity(Qt::CaseInsensitive);
-        m_completer->setFilterMode(Qt::MatchContains);
+    DBlurEffectWidget *blurEffect = new DBlurEffectWidget(m_popup);
+    blurEffect->setMaskColor(Qt::white);
 
-        m_searchInput->setCompleter(m_completer);
+    QHBoxLayout *popupLayout = new QHBoxLayout;
+    popupLayout->setSpacing(0);
+    popupLayout->setMargin(0);
+    popupLayout->addWidget(blurEffect);
+    m_popup->setLayout(popupLayout);
 
-        m_popup = m_completer->popup();
-        m_popup->setObjectName("TimezoneCompleter");
-        m_popup->setAttribute(Qt::WA_TranslucentBackground);
-        m_popup->installEventFilter(this);
+    blurEffect->lower();
 
-        DBlurEffectWidget *blurEffect = new DBlurEffectWidget(m_popup);
-        blurEffect->setMaskColor(Qt::white);
+    connect(m_searchInput, &SearchInput::textEdited, this, &TimeZoneChooser::updateCompletions);
 
-        QHBoxLayout *layout = new QHBoxLayout;
-        layout->setSpacing(0);
-        layout->setMargin(0);
-        layout->addWidget(blurEffect);
-        m_popup->setLayout(layout);
-
-        blurEffect->lower();
+    // 本地化时区表在工作线程中生成（或从磁盘缓存读取），避免在 GUI 线程上反复切换 locale
+    const QString locale = QLocale::system().name();
+    const bool includeZoneIds = "en_US.UTF-8" != m_currLangSelector->currentLocale();
+    QFutureWatcher<TimezoneTable> *watcher = new QFutureWatcher<TimezoneTable>(this);
+    connect(watcher, &QFutureWatcher<TimezoneTable>::finished, this, [this, watcher] {
+        m_timezoneTable = watcher->result();
+        watcher->deleteLater();
+
+        if (m_searchInput->hasFocus())
+            updateCompletions(m_searchInput->text());
     });
+    watcher->setFuture(QtConcurrent::run([locale, includeZoneIds] {
+        TimezoneTable table = TimezoneTable::load(locale);
+        table.setCandidates(includeZoneIds);
+        return table;
+    }));
+
     connect(m_searchInput, &SearchInput::returnPressed, [this] {
         QModelIndex index = m_popup->model()->index(0, 0);
         if (index.isValid()) {
@@ -203,6 +201,17 @@ TimeZoneChooser::TimeZoneChooser()
     });
 }
 
+void TimeZoneChooser::updateCompletions(const QString &text)
+{
+    m_completionModel->setStringList(m_timezoneTable.match(text));
+
+    if (m_completionModel->rowCount() > 0) {
+        m_completer->complete();
+    } else {
+        m_popup->hide();
+    }
+}
+
 void TimeZoneChooser::setIsAddZone(const bool isAdd)
 {
     m_isAddZone = isAdd;
@@ -26,6 +26,8 @@
 #ifndef TIMEZONECHOOSER_H
 #define TIMEZONECHOOSER_H
 
+#include "timezonetable.h"
+
 #include <DBlurEffectWidget>
 #include <DSuggestButton>
 
@@ -42,6 +44,7 @@ class QPushButton;
 class QComboBox;
 class QLabel;
 class QAbstractItemView;
+class QStringListModel;
 
 namespace installer {
 class TimezoneMap;
@@ -83,10 +86,11 @@ private:
     QSize getFitSize() const;
     int getFontSize() const;
     void setupSize();
+    void updateCompletions(const QString &text);
 
 private:
     bool m_isAddZone;
-    QMap<QString, QString> m_completionCache;
+    TimezoneTable m_timezoneTable;
 
     DBlurEffectWidget *m_blurEffect;
 
@@ -99,6 +103,7 @@ private:
     DSuggestButton *m_confirmBtn;
     LangSelector *m_currLangSelector;
     QCompleter *m_completer;
+    QStringListModel *m_completionModel;
 };
 
 } // namespace datetime
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timezonetable.h"
+#include "timezone.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimeZone>
+#include <QDebug>
+
+using namespace dcc::datetime;
+
+static const quint32 CacheMagic = 0x545a5442; // "TZTB"
+static const quint32 CacheVersion = 1;
+// 索引的最长子串长度，更长的查询用其中最稀疏的子串做初筛再逐个校验
+static const int MaxGramLength = 3;
+
+TimezoneTable TimezoneTable::load(const QString &locale)
+{
+    TimezoneTable table;
+    const QString path = cacheFilePath(locale);
+    if (table.readCache(path))
+        return table;
+
+    for (const QByteArray &zone : QTimeZone::availableTimeZoneIds())
+        table.m_zones << QString::fromLatin1(zone);
+    table.m_localizedNames = installer::GetLocalTimezoneNames(table.m_zones, locale);
+
+    for (int i = 0; i < table.m_zones.size(); ++i)
+        table.m_nameToZone.insert(table.m_localizedNames.at(i), table.m_zones.at(i));
+
+    table.writeCache(path);
+    return table;
+}
+
+void TimezoneTable::setCandidates(bool includeZoneIds)
+{
+    m_candidates.clear();
+    m_gramIndex.clear();
+
+    for (int i = 0; i < m_zones.size(); ++i) {
+        if (includeZoneIds)
+            m_candidates << m_zones.at(i);
+        m_candidates << m_localizedNames.at(i);
+    }
+
+    for (int i = 0; i < m_candidates.size(); ++i) {
+        const QString text = m_candidates.at(i).toLower();
+        for (int len = 1; len <= MaxGramLength; ++len) {
+            for (int pos = 0; pos + len <= text.size(); ++pos) {
+                QVector<int> &postings = m_gramIndex[text.mid(pos, len)];
+                // 按候选项顺序插入，只需检查末尾即可去重
+                if (postings.isEmpty() || postings.last() != i)
+                    postings.append(i);
+            }
+        }
+    }
+}
+
+QStringList TimezoneTable::match(const QString &text, int limit) const
+{
+    QStringList result;
+    const QString key = text.toLower();
+    if (key.isEmpty())
+        return result;
+
+    if (key.size() <= MaxGramLength) {
+        for (int i : m_gramIndex.value(key)) {
+            result << m_candidates.at(i);
+            if (limit > 0 && result.size() >= limit)
+                break;
+        }
+        return result;
+    }
+
+    const QVector<int> *postings = nullptr;
+    for (int pos = 0; pos + MaxGramLength <= key.size(); ++pos) {
+        auto it = m_gramIndex.constFind(key.mid(pos, MaxGramLength));
+        if (it == m_gramIndex.constEnd())
+            return result;
+        if (!postings || it->size() < postings->size())
+            postings = &it.value();
+    }
+
+    for (int i : *postings) {
+        if (!m_candidates.at(i).contains(text, Qt::CaseInsensitive))
+            continue;
+        result << m_candidates.at(i);
+        if (limit > 0 && result.size() >= limit)
+            break;
+    }
+
+    return result;
+}
+
+QString TimezoneTable::zoneForName(const QString &name) const
+{
+    return m_nameToZone.value(name, name);
+}
+
+QString TimezoneTable::cacheFilePath(const QString &locale)
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/timezones";
+    return QString("%1/%2-%3.cache").arg(dir, locale, tzdataVersion());
+}
+
+QString TimezoneTable::tzdataVersion()
+{
+    // tzdata.zi 首行形如 "# version 2021a"
+    QFile file("/usr/share/zoneinfo/tzdata.zi");
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.startsWith("# version "))
+            return QString::fromLatin1(line.mid(10));
+    }
+
+    return QString::number(QFileInfo("/usr/share/zoneinfo/zone.tab").lastModified().toSecsSinceEpoch());
+}
+
+bool TimezoneTable::readCache(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion)
+        return false;
+
+    QStringList zones, names;
+    stream >> zones >> names;
+    if (stream.status() != QDataStream::Ok || zones.isEmpty() || zones.size() != names.size()) {
+        qWarning() << "invalid timezone cache:" << path;
+        return false;
+    }
+
+    m_zones = zones;
+    m_localizedNames = names;
+    for (int i = 0; i < m_zones.size(); ++i)
+        m_nameToZone.insert(m_localizedNames.at(i), m_zones.at(i));
+
+    return true;
+}
+
+void TimezoneTable::writeCache(const QString &path) const
+{
+    if (m_zones.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath()))
+        return;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << CacheMagic << CacheVersion << m_zones << m_localizedNames;
+    file.commit();
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMEZONETABLE_H
+#define TIMEZONETABLE_H
+
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+namespace dcc {
+namespace datetime {
+
+/**
+ * @brief TimezoneTable 某个语言下的时区本地化名称表及其搜索索引
+ *
+ * 表格通过 load() 在工作线程中构建，并以语言和 tzdata 版本为键缓存到磁盘，
+ * 搜索使用 n-gram 倒排索引，效果等同于大小写不敏感的 MatchContains。
+ */
+class TimezoneTable
+{
+public:
+    TimezoneTable() {}
+
+    /**
+     * @brief load 读取磁盘缓存，缓存不存在或已过期时重新生成并写回，可在工作线程中调用
+     * @param locale 语言名称，如 zh_CN
+     */
+    static TimezoneTable load(const QString &locale);
+
+    /**
+     * @brief setCandidates 设置搜索候选项，includeZoneIds 为 false 时只搜索本地化名称
+     */
+    void setCandidates(bool includeZoneIds);
+
+    /**
+     * @brief match 返回包含 text 的候选项，按表格顺序排列
+     */
+    QStringList match(const QString &text, int limit = -1) const;
+
+    /**
+     * @brief zoneForName 本地化名称对应的时区，找不到时原样返回
+     */
+    QString zoneForName(const QString &name) const;
+
+    bool isEmpty() const { return m_zones.isEmpty(); }
+
+private:
+    static QString cacheFilePath(const QString &locale);
+    static QString tzdataVersion();
+    bool readCache(const QString &path);
+    void writeCache(const QString &path) const;
+
+private:
+    QStringList m_zones;
+    QStringList m_localizedNames;
+    QHash<QString, QString> m_nameToZone;
+
+    QStringList m_candidates;
+    QHash<QString, QVector<int>> m_gramIndex;
+};
+
+} // namespace datetime
+} // namespace dcc
+
+#endif // TIMEZONETABLE_H
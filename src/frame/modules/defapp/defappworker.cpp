@@ -30,16 +30,23 @@
 #include <QStringList>
 #include <QList>
 #include <QFileInfo>
+#include <QTimer>
 const QString ManagerService = "com.deepin.daemon.Mime";
 using namespace dcc;
 using namespace dcc::defapp;
 DefAppWorker::DefAppWorker(DefAppModel *model, QObject *parent) :
     QObject(parent),
     m_defAppModel(model),
-    m_dbusManager(new Mime(ManagerService, "/com/deepin/daemon/Mime", QDBusConnection::sessionBus(), this))
+    m_dbusManager(new Mime(ManagerService, "/com/deepin/daemon/Mime", QDBusConnection::sessionBus(), this)),
+    m_refreshTimer(new QTimer(this))
 {
     m_dbusManager->setSync(false);
 
+    // 后端一次修改可能连续发出多个 Change 信号，合并后再刷新
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(100);
+    connect(m_refreshTimer, &QTimer::timeout, this, &DefAppWorker::onGetListApps);
+
     m_stringToCategory.insert("Browser",     Browser);
     m_stringToCategory.insert("Mail",        Mail);
     m_stringToCategory.insert("Text",        Text);
@@ -48,7 +55,7 @@ DefAppWorker::DefAppWorker(DefAppModel *model, QObject *parent) :
     m_stringToCategory.insert("Picture",     Picture);
     m_stringToCategory.insert("Terminal",    Terminal);
 
-    connect(m_dbusManager, &Mime::Change, this, &DefAppWorker::onGetListApps);
+    connect(m_dbusManager, &Mime::Change, m_refreshTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
 
     m_userLocalPath = QDir::homePath() + "/.local/share/applications/";
 
@@ -116,32 +123,14 @@ void DefAppWorker::onDelUserApp(const QString &mime, const App &item)
 void DefAppWorker::onCreateFile(const QString &mime, const QFileInfo &info)
 {
     const bool isDesktop = info.suffix() == "desktop";
+    const QString filename = "deepin-custom-" + info.baseName() + ".desktop";
 
     if (isDesktop) {
         QFile file(info.filePath());
-        QString newfile = m_userLocalPath + "deepin-custom-" + info.fileName();
-        file.copy(newfile);
+        file.copy(m_userLocalPath + "deepin-custom-" + info.fileName());
         file.close();
-
-        QStringList mimelist = getTypeListByCategory(m_stringToCategory[mime]);
-        QFileInfo fileInfo(info.filePath());
-
-        const QString &filename = "deepin-custom-" + fileInfo.baseName() + ".desktop";
-
-        m_dbusManager->AddUserApp(mimelist, filename).waitForFinished();
-
-        App app;
-        app.Id = filename;
-        app.Name = fileInfo.baseName();
-        app.DisplayName = fileInfo.baseName();
-        app.Icon = "application-default-icon";
-        app.Description = "";
-        app.Exec = info.filePath();
-        app.isUser = true;
-
-        onGetListApps();
     } else {
-        QFile file(m_userLocalPath + "deepin-custom-" + info.baseName() + ".desktop");
+        QFile file(m_userLocalPath + filename);
 
         if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
             return;
@@ -160,23 +149,28 @@ void DefAppWorker::onCreateFile(const QString &mime, const QFileInfo &info)
             << endl;
         out.flush();
         file.close();
-
-        QStringList mimelist = getTypeListByCategory(m_stringToCategory[mime]);
-
-        QFileInfo fileInfo(info.filePath());
-        m_dbusManager->AddUserApp(mimelist, "deepin-custom-" + fileInfo.baseName() + ".desktop").waitForFinished();
-
-        App app;
-        app.Id = "deepin-custom-" + fileInfo.baseName() + ".desktop";
-        app.Name = fileInfo.baseName();
-        app.DisplayName = fileInfo.baseName();
-        app.Icon = "application-default-icon";
-        app.Description = "";
-        app.Exec = info.filePath();
-        app.isUser = true;
-
-        onGetListApps();
     }
+
+    App app;
+    app.Id = filename;
+    app.Name = info.baseName();
+    app.DisplayName = info.baseName();
+    app.Icon = "application-default-icon";
+    app.Exec = info.filePath();
+    app.isUser = true;
+    app.MimeTypeFit = true;
+
+    // 添加成功后直接插入该应用，后端的 Change 信号触发的刷新只会修正差异部分
+    const QStringList mimelist = getTypeListByCategory(m_stringToCategory[mime]);
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_dbusManager->AddUserApp(mimelist, filename), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, mime, app](QDBusPendingCallWatcher *w) {
+        if (w->isError()) {
+            qWarning() << "add user app failed:" << app.Id << w->error().message();
+        } else if (Category *category = getCategory(mime)) {
+            category->addUserItem(app);
+        }
+        w->deleteLater();
+    });
 }
 
 void DefAppWorker::getListAppFinished(QDBusPendingCallWatcher *w)
@@ -206,6 +200,7 @@ void DefAppWorker::saveListApp(const QString &mime, const QJsonArray &json, cons
     }
 
     QList<App> list;
+    list.reserve(json.size());
 
     for (const QJsonValue &value : json) {
         QJsonObject obj = value.toObject();
@@ -223,40 +218,7 @@ void DefAppWorker::saveListApp(const QString &mime, const QJsonArray &json, cons
         list << app;
     }
 
-    QList<App> systemList = category->systemAppList();
-    QList<App> userList = category->userAppList();
-    for (App app : list) {
-        if (app.isUser == false) {
-            for (App appUser : userList) {
-                if (appUser.Exec == app.Exec) {
-                    category->delUserItem(appUser);
-                }
-            }
-        }
-    }
-
-    for (App app : list) {
-        if (!systemList.contains(app) || !userList.contains(app)) {
-            category->addUserItem(app);
-        }
-    }
-
-    if (isUser) {
-        userList = category->userAppList();
-        for (App app : userList) {
-            if (!list.contains(app)) {
-                category->delUserItem(app);
-            }
-        }
-    } else {
-        systemList = category->systemAppList();
-        for (App app : systemList) {
-            if (!list.contains(app)) {
-                category->delUserItem(app);
-            }
-        }
-    }
-
+    category->mergeAppList(list, isUser);
     category->setCategory(mime);
 }
 
@@ -30,6 +30,9 @@
 
 #include <com_deepin_daemon_mime.h>
 #include <QObject>
+
+class QTimer;
+
 using com::deepin::daemon::Mime;
 
 namespace dcc
@@ -74,6 +77,7 @@ private:
     Mime     *m_dbusManager;
     QMap<QString, DefaultAppsCategory> m_stringToCategory;
     QString m_userLocalPath;
+    QTimer *m_refreshTimer;
 
 private:
     const QString getTypeByCategory(const DefAppWorker::DefaultAppsCategory &category);
@@ -25,8 +25,21 @@
 
 #include "category.h"
 #include <QDebug>
+#include <QSet>
 using namespace dcc;
 using namespace dcc::defapp;
+
+static bool isSameContent(const App &a, const App &b)
+{
+    return a.Name == b.Name
+            && a.DisplayName == b.DisplayName
+            && a.Description == b.Description
+            && a.Icon == b.Icon
+            && a.Exec == b.Exec
+            && a.CanDelete == b.CanDelete
+            && a.MimeTypeFit == b.MimeTypeFit;
+}
+
 Category::Category(QObject *parent)
     : QObject(parent)
 {
@@ -57,6 +70,10 @@ void Category::clear()
     m_systemAppList.clear();
     m_userAppList.clear();
     m_applist.clear();
+    m_systemApps.clear();
+    m_userApps.clear();
+    m_systemExecs.clear();
+    m_userExecs.clear();
     if (clearFlag)
         Q_EMIT clearAll();
 }
@@ -64,16 +81,17 @@ void Category::clear()
 void Category::addUserItem(const App &value)
 {
     if (value.isUser) {
-        for (auto r : m_systemAppList) {
-            if (r.Exec == value.Exec) {
-                return;
-            }
-        }
-        if (m_userAppList.contains(value)) return;
+        if (m_systemExecs.contains(value.Exec) || m_userApps.contains(value.Id))
+            return;
         m_userAppList << value;
+        m_userApps.insert(value.Id, value);
+        m_userExecs.insert(value.Exec, value.Id);
     } else {
-        if (m_systemAppList.contains(value)) return;
+        if (m_systemApps.contains(value.Id))
+            return;
         m_systemAppList << value;
+        m_systemApps.insert(value.Id, value);
+        m_systemExecs.insert(value.Exec, value.Id);
     }
 
     m_applist << value;
@@ -85,9 +103,17 @@ void Category::delUserItem(const App &value)
     bool isRemove = false;
 
     if (value.isUser) {
-        isRemove = m_userAppList.removeOne(value);
+        const App app = m_userApps.take(value.Id);
+        if (!app.Id.isEmpty()) {
+            m_userExecs.remove(app.Exec, app.Id);
+            isRemove = m_userAppList.removeOne(value);
+        }
     } else {
-        isRemove = m_systemAppList.removeOne(value);
+        const App app = m_systemApps.take(value.Id);
+        if (!app.Id.isEmpty()) {
+            m_systemExecs.remove(app.Exec, app.Id);
+            isRemove = m_systemAppList.removeOne(value);
+        }
     }
 
     if (isRemove) {
@@ -95,3 +121,47 @@ void Category::delUserItem(const App &value)
         Q_EMIT removedUserItem(value);
     }
 }
+
+const App Category::appById(const QString &id) const
+{
+    auto it = m_systemApps.constFind(id);
+    if (it != m_systemApps.constEnd())
+        return it.value();
+
+    return m_userApps.value(id);
+}
+
+void Category::mergeAppList(const QList<App> &list, bool isUser)
+{
+    QSet<QString> ids;
+    ids.reserve(list.size());
+    for (const App &app : list)
+        ids.insert(app.Id);
+
+    // 先删除已不存在的应用，以及被同一 Exec 的系统应用覆盖的用户应用
+    const QHash<QString, App> &current = isUser ? m_userApps : m_systemApps;
+    QList<App> removed;
+    for (const App &app : current) {
+        if (!ids.contains(app.Id))
+            removed << app;
+    }
+    if (!isUser) {
+        for (const App &app : list) {
+            for (const QString &userId : m_userExecs.values(app.Exec))
+                removed << m_userApps.value(userId);
+        }
+    }
+    for (const App &app : removed)
+        delUserItem(app);
+
+    for (const App &app : list) {
+        const QHash<QString, App> &apps = app.isUser ? m_userApps : m_systemApps;
+        auto it = apps.constFind(app.Id);
+        if (it != apps.constEnd()) {
+            if (isSameContent(it.value(), app))
+                continue;
+            delUserItem(app);
+        }
+        addUserItem(app);
+    }
+}
@@ -27,6 +27,7 @@
 #define CATEGORY_H
 #include <QObject>
 #include <QList>
+#include <QHash>
 #include <QJsonObject>
 namespace dcc
 {
@@ -73,6 +74,17 @@ public:
     void addUserItem(const App &value);
     void delUserItem(const App &value);
 
+    /**
+     * @brief appById 按 Id 查找应用，系统应用优先，找不到时返回 Id 为空的应用
+     */
+    const App appById(const QString &id) const;
+
+    /**
+     * @brief mergeAppList 用后端返回的系统或用户应用列表增量更新当前列表，
+     * 只对新增、删除和内容变化的应用发出信号
+     */
+    void mergeAppList(const QList<App> &list, bool isUser);
+
 Q_SIGNALS:
     void defaultChanged(const App &id);
     void addedUserItem(const App &app);
@@ -84,6 +96,11 @@ private:
     QList<App> m_applist;
     QList<App> m_systemAppList;
     QList<App> m_userAppList;
+    // 按 Id 和 Exec 建立的索引，Exec 索引的值为应用 Id
+    QHash<QString, App> m_systemApps;
+    QHash<QString, App> m_userApps;
+    QMultiHash<QString, QString> m_systemExecs;
+    QMultiHash<QString, QString> m_userExecs;
     QString m_category;
     App m_default;
 };
@@ -27,6 +27,8 @@
 #include "displaymodel.h"
 #include "monitorsettingdialog.h"
 #include "widgets/utils.h"
+#include "modules/common/systemcapabilities.h"
+#include "modules/common/dbustelemetry.h"
 
 #include <DApplicationHelper>
 
@@ -38,6 +40,7 @@ using namespace dcc::display;
 #define GSETTINGS_MINIMUM_BRIGHTNESS    "brightness-minimum"
 
 const QString DisplayInterface("com.deepin.daemon.Display");
+const QString MonitorInterface("com.deepin.daemon.Display.Monitor");
 
 Q_DECLARE_METATYPE(QList<QDBusObjectPath>)
 
@@ -57,10 +60,10 @@ DisplayWorker::DisplayWorker(DisplayModel *model, QObject *parent, bool isSync)
     m_displayInter.setSync(false);
     m_appearanceInter->setSync(false);
 
-    m_displayDBusInter = new QDBusInterface("com.deepin.daemon.Display",
-                               "/com/deepin/daemon/Display",
-                               "com.deepin.daemon.Display",
-                               QDBusConnection::sessionBus());
+    m_displayDBusInter = DBusProxyRegistry::instance()->proxy(QDBusConnection::sessionBus(),
+                                                              "com.deepin.daemon.Display",
+                                                              "/com/deepin/daemon/Display",
+                                                              "com.deepin.daemon.Display");
 
     connect(&m_displayInter, &DisplayInter::MonitorsChanged, this, &DisplayWorker::onMonitorListChanged);
     connect(&m_displayInter, &DisplayInter::BrightnessChanged, this, &DisplayWorker::onMonitorsBrightnessChanged);
@@ -126,11 +129,14 @@ void DisplayWorker::active()
     //redshift 依赖X11，当前isXWindowPlatform返回不准确,所以先用环境变量判断
     //   DGuiApplicationHelper::isXWindowPlatform() const bool isRedshiftValid = DGuiApplicationHelper::isXWindowPlatform() && QProcess::execute("which", QStringList() << "redshift") == 0;
     auto sessionType = qEnvironmentVariable("XDG_SESSION_TYPE");
-    const bool isRedshiftValid =
-        !sessionType.contains("wayland") &&
-        QProcess::execute("which", QStringList() << "redshift") == 0;
+    if (sessionType.contains("wayland")) {
+        m_model->setRedshiftIsValid(false);
+    } else {
+        SystemCapabilities::instance()->queryExecutable("redshift", this, [this](bool found) {
+            m_model->setRedshiftIsValid(found);
+        });
+    }
 
-    m_model->setRedshiftIsValid(isRedshiftValid);
     m_model->setMinimumBrightnessScale(
         m_dccSettings->get(GSETTINGS_MINIMUM_BRIGHTNESS).toDouble());
 }
@@ -139,7 +145,7 @@ void DisplayWorker::saveChanges()
 {
     qDebug() << Q_FUNC_INFO;
 
-    m_displayInter.Save().waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.Save(), DisplayInterface + ".Save");
     if (m_updateScale)
         setUiScale(m_currentScale);
     m_updateScale = false;
@@ -149,7 +155,7 @@ void DisplayWorker::discardChanges()
 {
     qDebug() << Q_FUNC_INFO;
 
-    m_displayInter.ResetChanges().waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.ResetChanges(), DisplayInterface + ".ResetChanges");
 }
 
 void DisplayWorker::mergeScreens()
@@ -199,22 +205,23 @@ void DisplayWorker::mergeScreens()
             rotate = 1;
         }
     }
-    QList<QDBusPendingReply<>> replys;
+    // 调用同时发出后再逐个等待，每个回复按各自的方法名统计
+    QList<QPair<QDBusPendingCall, QString>> replys;
 
     for (auto *mon : m_model->monitorList()) {
         auto *mInter = m_monitors[mon];
         Q_ASSERT(mInter);
 
-        replys << mInter->SetPosition(0, 0);
-        replys << mInter->SetModeBySize(static_cast<ushort>(mode.width()), static_cast<ushort>(mode.height()));
-        replys << mInter->SetRotation(rotate);
-        replys << m_displayInter.SetBrightness(mon->name(), brightness);
+        replys.append({ mInter->SetPosition(0, 0), MonitorInterface + ".SetPosition" });
+        replys.append({ mInter->SetModeBySize(static_cast<ushort>(mode.width()), static_cast<ushort>(mode.height())), MonitorInterface + ".SetModeBySize" });
+        replys.append({ mInter->SetRotation(rotate), MonitorInterface + ".SetRotation" });
+        replys.append({ m_displayInter.SetBrightness(mon->name(), brightness), DisplayInterface + ".SetBrightness" });
     }
 
-    for (auto r : replys)
-        r.waitForFinished();
+    for (const auto &r : replys)
+        DBusTelemetry::waitForFinished(r.first, r.second);
 
-    m_displayInter.ApplyChanges().waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.ApplyChanges(), DisplayInterface + ".ApplyChanges");
 }
 
 void DisplayWorker::splitScreens()
@@ -228,7 +235,7 @@ void DisplayWorker::splitScreens()
 
     auto *primary = m_model->primaryMonitor();
     Q_ASSERT(m_monitors.contains(primary));
-    m_monitors[primary]->SetPosition(static_cast<short>(m_model->primaryMonitor()->getLastPoint().x()), static_cast<short>(m_model->primaryMonitor()->getLastPoint().y())).waitForFinished();
+    DBusTelemetry::waitForFinished(m_monitors[primary]->SetPosition(static_cast<short>(m_model->primaryMonitor()->getLastPoint().x()), static_cast<short>(m_model->primaryMonitor()->getLastPoint().y())), MonitorInterface + ".SetPosition");
     int xOffset = primary->bestMode().width();
 
     for (auto *mon : mList) {
@@ -236,16 +243,16 @@ void DisplayWorker::splitScreens()
         Q_ASSERT(m_monitors.contains(mon));
         auto *mInter = m_monitors[mon];
         // 设置最好模式
-        mInter->SetMode(static_cast<uint>(mon->bestMode().id())).waitForFinished();
-        mInter->SetRotation(1).waitForFinished();
+        DBusTelemetry::waitForFinished(mInter->SetMode(static_cast<uint>(mon->bestMode().id())), MonitorInterface + ".SetMode");
+        DBusTelemetry::waitForFinished(mInter->SetRotation(1), MonitorInterface + ".SetRotation");
 
         if (mon == primary)
             continue;
 
         if (mon->getLastPoint() == m_model->primaryMonitor()->getLastPoint()) {
-            mInter->SetPosition(static_cast<short>(xOffset), 0).waitForFinished();
+            DBusTelemetry::waitForFinished(mInter->SetPosition(static_cast<short>(xOffset), 0), MonitorInterface + ".SetPosition");
         } else {
-            mInter->SetPosition(static_cast<short>(mon->getLastPoint().x()), static_cast<short>(mon->getLastPoint().y())).waitForFinished();
+            DBusTelemetry::waitForFinished(mInter->SetPosition(static_cast<short>(mon->getLastPoint().x()), static_cast<short>(mon->getLastPoint().y())), MonitorInterface + ".SetPosition");
         }
         xOffset += mon->bestMode().width();
     }
@@ -300,7 +307,7 @@ void DisplayWorker::switchMode(const int mode, const QString &name)
 {
     qDebug() << Q_FUNC_INFO << mode << name;
 
-    m_displayInter.SwitchMode(static_cast<uchar>(mode), name).waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.SwitchMode(static_cast<uchar>(mode), name), DisplayInterface + ".SwitchMode");
 }
 
 void DisplayWorker::onMonitorListChanged(const QList<QDBusObjectPath> &mons)
@@ -377,7 +384,7 @@ void DisplayWorker::setMonitorRotate(Monitor *mon, const quint16 rotate)
     MonitorInter *inter = m_monitors.value(mon);
     Q_ASSERT(inter);
 
-    inter->SetRotation(rotate).waitForFinished();
+    DBusTelemetry::waitForFinished(inter->SetRotation(rotate), MonitorInterface + ".SetRotation");
     for (auto tm = m_monitors.begin(); tm != m_monitors.end(); ++tm) {
         if (m_model->isMerge()) {
             tm.value()->SetPosition(0, 0);
@@ -392,7 +399,7 @@ void DisplayWorker::setMonitorRotateAll(const quint16 rotate)
 {
     qDebug() << rotate;
     for (auto *mi : m_monitors)
-        mi->SetRotation(rotate).waitForFinished();
+        DBusTelemetry::waitForFinished(mi->SetRotation(rotate), MonitorInterface + ".SetRotation");
 
     qDebug() << m_displayInter.ApplyChanges().error();
 }
@@ -413,13 +420,13 @@ void DisplayWorker::setMonitorEnable(Monitor *mon, const bool enabled)
     MonitorInter *inter = m_monitors.value(mon);
     Q_ASSERT(inter);
 
-    inter->Enable(enabled).waitForFinished();
+    DBusTelemetry::waitForFinished(inter->Enable(enabled), MonitorInterface + ".Enable");
     m_displayInter.ApplyChanges();
 }
 
 void DisplayWorker::applyChanges()
 {
-    m_displayInter.ApplyChanges().waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.ApplyChanges(), DisplayInterface + ".ApplyChanges");
 }
 
 void DisplayWorker::onMonitorEnable(Monitor *monitor, const bool enabled)
@@ -476,22 +483,22 @@ void DisplayWorker::onMonitorEnable(Monitor *monitor, const bool enabled)
         const auto rotate = m_model->primaryMonitor()->rotate();
         const auto brightness = m_model->primaryMonitor()->brightness();
 
-        QList<QDBusPendingReply<>> replys;
-        replys << inter->SetModeBySize(static_cast<ushort>(mode.width()), static_cast<ushort>(mode.height()));
-        replys << inter->SetRotation(rotate);
-        replys << inter->Enable(enabled);
-        replys << m_displayInter.SetBrightness(monitor->name(), brightness);
+        QList<QPair<QDBusPendingCall, QString>> replys;
+        replys.append({ inter->SetModeBySize(static_cast<ushort>(mode.width()), static_cast<ushort>(mode.height())), MonitorInterface + ".SetModeBySize" });
+        replys.append({ inter->SetRotation(rotate), MonitorInterface + ".SetRotation" });
+        replys.append({ inter->Enable(enabled), MonitorInterface + ".Enable" });
+        replys.append({ m_displayInter.SetBrightness(monitor->name(), brightness), DisplayInterface + ".SetBrightness" });
 
         //防止customsettingdialog起的时候monitor的属性值不对
         monitor->setW(mode.width());
         monitor->setH(mode.height());
 
-        for (auto r : replys)
-            r.waitForFinished();
+        for (const auto &r : replys)
+            DBusTelemetry::waitForFinished(r.first, r.second);
     } else
-        inter->Enable(enabled).waitForFinished();
+        DBusTelemetry::waitForFinished(inter->Enable(enabled), MonitorInterface + ".Enable");
     Q_ASSERT(m_monitors.contains(primary));
-    m_monitors[primary]->SetPosition(0, 0).waitForFinished();
+    DBusTelemetry::waitForFinished(m_monitors[primary]->SetPosition(0, 0), MonitorInterface + ".SetPosition");
 
     //为亮的屏幕排序
     int xOffset = primary->w();
@@ -510,13 +517,13 @@ void DisplayWorker::onMonitorEnable(Monitor *monitor, const bool enabled)
             }
             Q_ASSERT(m_monitors.contains(mon));
             auto *mInter = m_monitors[mon];
-            mInter->SetPosition(static_cast<short>(xOffset), 0).waitForFinished();
+            DBusTelemetry::waitForFinished(mInter->SetPosition(static_cast<short>(xOffset), 0), MonitorInterface + ".SetPosition");
             monitor->setW(xOffset);
             monitor->setH(0);
             xOffset += mon->w();
         }
     }
-    m_displayInter.ApplyChanges().waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.ApplyChanges(), DisplayInterface + ".ApplyChanges");
 }
 
 void DisplayWorker::setColorTemperature(int value)
@@ -533,12 +540,12 @@ void DisplayWorker::setMonitorResolution(Monitor *mon, const int mode)
     MonitorInter *inter = m_monitors.value(mon);
     Q_ASSERT(inter);
 
-    inter->SetMode(static_cast<uint>(mode)).waitForFinished();
+    DBusTelemetry::waitForFinished(inter->SetMode(static_cast<uint>(mode)), MonitorInterface + ".SetMode");
 }
 
 void DisplayWorker::setMonitorBrightness(Monitor *mon, const double brightness)
 {
-    m_displayInter.SetAndSaveBrightness(mon->name(), std::max(brightness, m_model->minimumBrightnessScale())).waitForFinished();
+    DBusTelemetry::waitForFinished(m_displayInter.SetAndSaveBrightness(mon->name(), std::max(brightness, m_model->minimumBrightnessScale())), DisplayInterface + ".SetAndSaveBrightness");
 }
 
 void DisplayWorker::setMonitorPosition(Monitor *mon, const int x, const int y)
@@ -546,8 +553,8 @@ void DisplayWorker::setMonitorPosition(Monitor *mon, const int x, const int y)
     MonitorInter *inter = m_monitors.value(mon);
     Q_ASSERT(inter);
 
-    inter->SetPosition(static_cast<short>(x), static_cast<short>(y)).waitForFinished();
-    m_displayInter.ApplyChanges().waitForFinished();
+    DBusTelemetry::waitForFinished(inter->SetPosition(static_cast<short>(x), static_cast<short>(y)), MonitorInterface + ".SetPosition");
+    DBusTelemetry::waitForFinished(m_displayInter.ApplyChanges(), DisplayInterface + ".ApplyChanges");
 }
 
 void DisplayWorker::setUiScale(const double value)
@@ -561,7 +568,7 @@ void DisplayWorker::setUiScale(const double value)
     QDBusPendingCall call = m_appearanceInter->SetScaleFactor(rv);
 
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    watcher->waitForFinished();
+    DBusTelemetry::waitForFinished(call, "com.deepin.daemon.Appearance.SetScaleFactor");
     if (!watcher->isError()) {
         m_model->setUIScale(rv);
     }
@@ -643,21 +650,22 @@ void DisplayWorker::monitorAdded(const QString &path)
 
     // NOTE: DO NOT using async dbus call. because we need to have a unique name to distinguish each monitor
     Q_ASSERT(inter->isValid());
-    mon->setName(inter->name());
-    mon->setManufacturer(inter->manufacturer());
-    mon->setModel(inter->model());
-    QDBusReply<bool> reply = m_displayDBusInter->call("CanSetBrightness", inter->name());
+    mon->setName(DBusTelemetry::readProperty(MonitorInterface + ".Name", [inter] { return inter->name(); }));
+    mon->setManufacturer(DBusTelemetry::readProperty(MonitorInterface + ".Manufacturer", [inter] { return inter->manufacturer(); }));
+    mon->setModel(DBusTelemetry::readProperty(MonitorInterface + ".Model", [inter] { return inter->model(); }));
+    // 经由共享代理的同步调用，耗时由 DBusObjectProxy::call 记录
+    QDBusReply<bool> reply = m_displayDBusInter->call("CanSetBrightness", {mon->name()});
     mon->setCanBrightness(reply.value());
-    mon->setMonitorEnable(inter->enabled());
+    mon->setMonitorEnable(DBusTelemetry::readProperty(MonitorInterface + ".Enabled", [inter] { return inter->enabled(); }));
     mon->setPath(path);
-    mon->setX(inter->x());
-    mon->setY(inter->y());
-    mon->setW(inter->width());
-    mon->setH(inter->height());
-    mon->setRotate(inter->rotation());
-    mon->setCurrentMode(inter->currentMode());
-    mon->setBestMode(inter->bestMode());
-    mon->setModeList(inter->modes());
+    mon->setX(DBusTelemetry::readProperty(MonitorInterface + ".X", [inter] { return inter->x(); }));
+    mon->setY(DBusTelemetry::readProperty(MonitorInterface + ".Y", [inter] { return inter->y(); }));
+    mon->setW(DBusTelemetry::readProperty(MonitorInterface + ".Width", [inter] { return inter->width(); }));
+    mon->setH(DBusTelemetry::readProperty(MonitorInterface + ".Height", [inter] { return inter->height(); }));
+    mon->setRotate(DBusTelemetry::readProperty(MonitorInterface + ".Rotation", [inter] { return inter->rotation(); }));
+    mon->setCurrentMode(DBusTelemetry::readProperty(MonitorInterface + ".CurrentMode", [inter] { return inter->currentMode(); }));
+    mon->setBestMode(DBusTelemetry::readProperty(MonitorInterface + ".BestMode", [inter] { return inter->bestMode(); }));
+    mon->setModeList(DBusTelemetry::readProperty(MonitorInterface + ".Modes", [inter] { return inter->modes(); }));
     if (m_model->isRefreshRateEnable() == false) {
         for (auto resolutionModel : mon->modeList()) {
             if (qFuzzyCompare(resolutionModel.rate(), 0.0) == false) {
@@ -665,10 +673,10 @@ void DisplayWorker::monitorAdded(const QString &path)
             }
         }
     }
-    mon->setRotateList(inter->rotations());
-    mon->setPrimary(m_displayInter.primary());
-    mon->setMmWidth(inter->mmWidth());
-    mon->setMmHeight(inter->mmHeight());
+    mon->setRotateList(DBusTelemetry::readProperty(MonitorInterface + ".Rotations", [inter] { return inter->rotations(); }));
+    mon->setPrimary(DBusTelemetry::readProperty(DisplayInterface + ".Primary", [this] { return m_displayInter.primary(); }));
+    mon->setMmWidth(DBusTelemetry::readProperty(MonitorInterface + ".MmWidth", [inter] { return inter->mmWidth(); }));
+    mon->setMmHeight(DBusTelemetry::readProperty(MonitorInterface + ".MmHeight", [inter] { return inter->mmHeight(); }));
 
     if (!m_model->brightnessMap().isEmpty()) {
         mon->setBrightness(m_model->brightnessMap()[mon->name()]);
@@ -787,5 +795,5 @@ void DisplayWorker::setMonitorResolutionBySize(Monitor *mon, const int width, co
         }
         watcher->deleteLater();
     });
-    watcher->waitForFinished();
+    DBusTelemetry::waitForFinished(call, MonitorInterface + ".SetModeBySize");
 }
@@ -27,6 +27,7 @@
 #define DISPLAYWORKER_H
 
 #include "monitor.h"
+#include "modules/common/dbusproxyregistry.h"
 
 #include <QObject>
 
@@ -113,7 +114,7 @@ private:
 private:
     DisplayModel *m_model;
     DisplayInter m_displayInter;
-    QDBusInterface *m_displayDBusInter;
+    QSharedPointer<dcc::DBusObjectProxy> m_displayDBusInter;
     QGSettings *m_dccSettings;
     AppearanceInter *m_appearanceInter;
     QMap<Monitor *, MonitorInter *> m_monitors;
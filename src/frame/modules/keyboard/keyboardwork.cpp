@@ -26,6 +26,7 @@
 #include "keyboardwork.h"
 #include "shortcutitem.h"
 #include "keyboardmodel.h"
+#include "modules/common/dbustelemetry.h"
 #include <QTime>
 #include <QDebug>
 #include <QLocale>
@@ -422,7 +423,8 @@ void KeyboardWorker::onAdded(const QString &in0, int in1)
 void KeyboardWorker::onDisableShortcut(ShortcutInfo *info)
 {
     // disable shortcut need wait!
-    m_keybindInter->ClearShortcutKeystrokes(info->id, static_cast<int>(info->type)).waitForFinished();
+    DBusTelemetry::waitForFinished(m_keybindInter->ClearShortcutKeystrokes(info->id, static_cast<int>(info->type)),
+                                   "com.deepin.daemon.Keybinding.ClearShortcutKeystrokes");
     info->accels.clear();
 }
 
@@ -549,8 +551,6 @@ void KeyboardWorker::onPinyin()
 {
     m_letters.clear();
     m_metaDatas.clear();
-    QDBusInterface dbus_pinyin("com.deepin.api.Pinyin", "/com/deepin/api/Pinyin",
-                               "com.deepin.api.Pinyin");
 
     Q_FOREACH(const QString & str, m_model->kbLayout().keys()) {
         MetaData md;
@@ -563,7 +563,14 @@ void KeyboardWorker::onPinyin()
             letterFirstList << QString(letterFirst);
             md.setPinyin(title);
         } else {
-            QDBusMessage message = dbus_pinyin.call("Query", title);
+            // 直接发送方法调用，不创建 QDBusInterface，省去一次同步的 introspect
+            QDBusMessage message = QDBusMessage::createMethodCall("com.deepin.api.Pinyin", "/com/deepin/api/Pinyin",
+                                                                  "com.deepin.api.Pinyin", "Query");
+            message << title;
+            {
+                DBusTelemetry::SyncScope scope("com.deepin.api.Pinyin.Query");
+                message = QDBusConnection::sessionBus().call(message);
+            }
             letterFirstList = message.arguments()[0].toStringList();
             md.setPinyin(letterFirstList.at(0));
         }
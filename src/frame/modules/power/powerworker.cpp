@@ -26,10 +26,10 @@
 #include "powerworker.h"
 #include "powermodel.h"
 #include "widgets/utils.h"
+#include "modules/common/propertysnapshot.h"
+#include "modules/common/dbusfuture.h"
 
 #include <QProcessEnvironment>
-#include <QFutureWatcher>
-#include <QtConcurrent>
 
 #define POWER_CAN_SLEEP "POWER_CAN_SLEEP"
 #define POWER_CAN_HIBERNATE "POWER_CAN_HIBERNATE"
@@ -88,71 +88,92 @@ void PowerWorker::active()
     m_powerInter->blockSignals(false);
 
     // refersh data
-    m_powerModel->setScreenBlackLock(m_powerInter->screenBlackLock());
-    m_powerModel->setSleepLock(m_powerInter->sleepLock());
-    m_powerModel->setLidPresent(m_powerInter->lidIsPresent());
-    m_powerModel->setSleepOnLidOnPowerClose(m_powerInter->lidClosedSleep());
-    m_powerModel->setHaveBettary(m_sysPowerInter->hasBattery());
-    m_powerModel->setPowerSavingModeAutoWhenQuantifyLow(m_sysPowerInter->powerSavingModeAutoWhenBatteryLow());
-    m_powerModel->setPowerSavingModeLowerBrightnessThreshold(m_sysPowerInter->powerSavingModeBrightnessDropPercent());
-    m_powerModel->setLowPowerNotifyEnable(m_powerInter->lowPowerNotifyEnable());
-    m_powerModel->setLowPowerAutoSleepThreshold(m_powerInter->lowPowerAutoSleepThreshold());
-    m_powerModel->setLowPowerNotifyThreshold(m_powerInter->lowPowerNotifyThreshold());
-    m_powerModel->setLinePowerPressPowerBtnAction(m_powerInter->linePowerPressPowerBtnAction());
-    m_powerModel->setLinePowerLidClosedAction(m_powerInter->linePowerLidClosedAction());
-    m_powerModel->setBatteryPressPowerBtnAction(m_powerInter->batteryPressPowerBtnAction());
-    m_powerModel->setBatteryLidClosedAction(m_powerInter->batteryLidClosedAction());
-    m_powerModel->setPowerPlan(m_sysPowerInter->mode());
-    m_powerModel->setHighPerformanceSupported(m_sysPowerInter->isHighPerformanceSupported());
-
-    setScreenBlackDelayToModelOnPower(m_powerInter->linePowerScreenBlackDelay());
-    setSleepDelayToModelOnPower(m_powerInter->linePowerSleepDelay());
-
-    setScreenBlackDelayToModelOnBattery(m_powerInter->batteryScreenBlackDelay());
-    setSleepDelayToModelOnBattery(m_powerInter->batterySleepDelay());
-
-    setResponseBatteryLockScreenDelay(m_powerInter->batteryLockDelay());
-    setResponsePowerLockScreenDelay(m_powerInter->linePowerLockDelay());
-
-#ifndef DCC_DISABLE_POWERSAVE
-    m_powerModel->setAutoPowerSaveMode(m_sysPowerInter->powerSavingModeAuto());
-    m_powerModel->setPowerSaveMode(m_sysPowerInter->powerSavingModeEnabled());
-#endif
+    // 两个接口各取一次全部属性，返回后一次性写入 model
+    PropertySnapshot()
+        .add(m_powerInter, {"ScreenBlackLock", "SleepLock", "LidIsPresent", "LidClosedSleep",
+                            "LowPowerNotifyEnable", "LowPowerAutoSleepThreshold", "LowPowerNotifyThreshold",
+                            "LinePowerPressPowerBtnAction", "LinePowerLidClosedAction",
+                            "BatteryPressPowerBtnAction", "BatteryLidClosedAction",
+                            "LinePowerScreenBlackDelay", "LinePowerSleepDelay",
+                            "BatteryScreenBlackDelay", "BatterySleepDelay",
+                            "BatteryLockDelay", "LinePowerLockDelay"})
+        .add(m_sysPowerInter, {"HasBattery", "PowerSavingModeAutoWhenBatteryLow", "PowerSavingModeBrightnessDropPercent",
+                               "Mode", "IsHighPerformanceSupported", "PowerSavingModeAuto", "PowerSavingModeEnabled"})
+        .fetch(this, [this](const PropertySnapshot &snapshot) {
+            applyPropertySnapshot(snapshot);
+        });
 
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     const bool confVal = valueByQSettings<bool>(DCC_CONFIG_FILES, "Power", "sleep", true);
     const bool envVal = QVariant(env.value(POWER_CAN_SLEEP)).toBool();
     const bool envVal_hibernate  = QVariant(env.value(POWER_CAN_HIBERNATE)).toBool();
 
-    QFutureWatcher<bool> *canSleepWatcher = new QFutureWatcher<bool>();
-    connect(canSleepWatcher, &QFutureWatcher<bool>::finished, this, [=] {
-        bool canSleep = canSleepWatcher->result();
+    // 获取失败时按不支持处理
+    auto applyCanSleep = [=](bool canSleep) {
         bool can_sleep = env.contains(POWER_CAN_SLEEP) ? envVal : confVal && canSleep;
         m_powerModel->setCanSleep(can_sleep);
-        canSleepWatcher->deleteLater();
+    };
+    DBusFuture<QString>(m_login1ManagerInter->CanSuspend(), "org.freedesktop.login1.Manager.CanSuspend").then(this, [=](const QString &value) {
+        applyCanSleep(value.contains("yes"));
+    }, [=](const QDBusError &) {
+        applyCanSleep(false);
     });
 
-    QFutureWatcher<bool> *canHibernateWatcher = new QFutureWatcher<bool>();
-    connect(canHibernateWatcher, &QFutureWatcher<bool>::finished, this, [=] {
-        bool canHibernate = canHibernateWatcher->result();
+    auto applyCanHibernate = [=](bool canHibernate) {
         bool can_hibernate = env.contains(POWER_CAN_HIBERNATE)
                              ? envVal_hibernate
                              : canHibernate;
         m_powerModel->setCanHibernate(can_hibernate);
-        canHibernateWatcher->deleteLater();
+    };
+    DBusFuture<QString>(m_login1ManagerInter->CanHibernate(), "org.freedesktop.login1.Manager.CanHibernate").then(this, [=](const QString &value) {
+        applyCanHibernate(value.contains("yes"));
+    }, [=](const QDBusError &) {
+        applyCanHibernate(false);
     });
+}
+
+void PowerWorker::applyPropertySnapshot(const PropertySnapshot &snapshot)
+{
+    // 接口获取失败时保留 model 中原有的值
+    if (snapshot.contains(m_powerInter, "ScreenBlackLock")) {
+        auto power = [&](const QString &name) { return snapshot.value(m_powerInter, name); };
+
+        m_powerModel->setScreenBlackLock(power("ScreenBlackLock").toBool());
+        m_powerModel->setSleepLock(power("SleepLock").toBool());
+        m_powerModel->setLidPresent(power("LidIsPresent").toBool());
+        m_powerModel->setSleepOnLidOnPowerClose(power("LidClosedSleep").toBool());
+        m_powerModel->setLowPowerNotifyEnable(power("LowPowerNotifyEnable").toBool());
+        m_powerModel->setLowPowerAutoSleepThreshold(power("LowPowerAutoSleepThreshold").toInt());
+        m_powerModel->setLowPowerNotifyThreshold(power("LowPowerNotifyThreshold").toInt());
+        m_powerModel->setLinePowerPressPowerBtnAction(power("LinePowerPressPowerBtnAction").toInt());
+        m_powerModel->setLinePowerLidClosedAction(power("LinePowerLidClosedAction").toInt());
+        m_powerModel->setBatteryPressPowerBtnAction(power("BatteryPressPowerBtnAction").toInt());
+        m_powerModel->setBatteryLidClosedAction(power("BatteryLidClosedAction").toInt());
+
+        setScreenBlackDelayToModelOnPower(power("LinePowerScreenBlackDelay").toInt());
+        setSleepDelayToModelOnPower(power("LinePowerSleepDelay").toInt());
 
-    canSleepWatcher->setFuture(QtConcurrent::run([=] {
-        QDBusPendingReply<QString> reply = m_login1ManagerInter->CanSuspend();
-        reply.waitForFinished();
-        return reply.value().contains("yes");
-    }));
-
-    canHibernateWatcher->setFuture(QtConcurrent::run([=] {
-        QDBusPendingReply<QString> reply = m_login1ManagerInter->CanHibernate();
-        reply.waitForFinished();
-        return reply.value().contains("yes");
-    }));
+        setScreenBlackDelayToModelOnBattery(power("BatteryScreenBlackDelay").toInt());
+        setSleepDelayToModelOnBattery(power("BatterySleepDelay").toInt());
+
+        setResponseBatteryLockScreenDelay(power("BatteryLockDelay").toInt());
+        setResponsePowerLockScreenDelay(power("LinePowerLockDelay").toInt());
+    }
+
+    if (snapshot.contains(m_sysPowerInter, "HasBattery")) {
+        auto sysPower = [&](const QString &name) { return snapshot.value(m_sysPowerInter, name); };
+
+        m_powerModel->setHaveBettary(sysPower("HasBattery").toBool());
+        m_powerModel->setPowerSavingModeAutoWhenQuantifyLow(sysPower("PowerSavingModeAutoWhenBatteryLow").toBool());
+        m_powerModel->setPowerSavingModeLowerBrightnessThreshold(sysPower("PowerSavingModeBrightnessDropPercent").toUInt());
+        m_powerModel->setPowerPlan(sysPower("Mode").toString());
+        m_powerModel->setHighPerformanceSupported(sysPower("IsHighPerformanceSupported").toBool());
+
+#ifndef DCC_DISABLE_POWERSAVE
+        m_powerModel->setAutoPowerSaveMode(sysPower("PowerSavingModeAuto").toBool());
+        m_powerModel->setPowerSaveMode(sysPower("PowerSavingModeEnabled").toBool());
+#endif
+    }
 }
 
 void PowerWorker::deactive()
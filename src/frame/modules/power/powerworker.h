@@ -36,6 +36,7 @@ using SysPowerInter = com::deepin::system::Power;
 using Login1ManagerInter = org::freedesktop::login1::Manager;
 
 namespace dcc{
+class PropertySnapshot;
 namespace power {
 class PowerModel;
 class PowerWorker : public QObject
@@ -86,6 +87,7 @@ public Q_SLOTS:
 private:
     int  converToDelayModel(int value);
     int  converToDelayDBus(int value);
+    void applyPropertySnapshot(const PropertySnapshot &snapshot);
 
 private:
     PowerModel *m_powerModel;
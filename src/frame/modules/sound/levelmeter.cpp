@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "levelmeter.h"
+
+#include <QAudioDeviceInfo>
+#include <QAudioInput>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+#include <QtEndian>
+#include <QDebug>
+
+#include <cmath>
+#include <cstring>
+
+namespace dcc {
+namespace sound {
+
+// 以 60Hz 为基准的每帧衰减系数，实际按经过的时间换算，约 0.5 秒从满格回落到十分之一
+static const double LevelDecay = 0.93;
+static const double LevelDecayRate = 60;
+// 电平变化小于该值时不通知界面
+static const double LevelEpsilon = 0.005;
+
+LevelMeter::LevelMeter(QObject *parent)
+    : QObject(parent)
+    , m_input(nullptr)
+    , m_device(nullptr)
+    , m_source(nullptr)
+    , m_frameBytes(0)
+    , m_frameTimer(new QTimer(this))
+    , m_peak(0)
+    , m_level(0)
+    , m_reportedLevel(0)
+{
+    connect(m_frameTimer, &QTimer::timeout, this, &LevelMeter::onFrame);
+}
+
+LevelMeter::~LevelMeter()
+{
+    // 析构时不再通知界面，接收者可能已经在析构
+    if (m_input)
+        m_input->stop();
+}
+
+void LevelMeter::setSource(QIODevice *source, const QAudioFormat &format)
+{
+    m_source = source;
+    m_sourceFormat = format;
+}
+
+void LevelMeter::start()
+{
+    if (m_device)
+        return;
+
+    if (m_source) {
+        if (!isFormatSupported(m_sourceFormat)) {
+            qWarning() << "unsupported level meter format:" << m_sourceFormat;
+            return;
+        }
+        if (!m_source->isOpen() && !m_source->open(QIODevice::ReadOnly)) {
+            qWarning() << "open level meter source failed:" << m_source->errorString();
+            return;
+        }
+
+        m_format = m_sourceFormat;
+        m_device = m_source;
+        if (m_device->isSequential())
+            connect(m_device, &QIODevice::readyRead, this, &LevelMeter::onReadyRead);
+        startFrameTimer();
+        return;
+    }
+
+    QAudioFormat format;
+    format.setSampleRate(16000);
+    format.setChannelCount(1);
+    format.setSampleSize(16);
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec("audio/pcm");
+
+    const QAudioDeviceInfo info = QAudioDeviceInfo::defaultInputDevice();
+    if (info.isNull()) {
+        qDebug() << "no audio input device for level meter";
+        return;
+    }
+    if (!info.isFormatSupported(format))
+        format = info.nearestFormat(format);
+
+    if (!isFormatSupported(format)) {
+        qWarning() << "unsupported level meter format:" << format;
+        return;
+    }
+
+    m_format = format;
+    m_input = new QAudioInput(info, m_format, this);
+    // 约 50ms 的缓冲，足够平滑又不会让电平明显滞后
+    m_input->setBufferSize(m_format.bytesForDuration(50000));
+    m_device = m_input->start();
+    if (!m_device) {
+        qWarning() << "start level meter failed:" << m_input->error();
+        stop();
+        return;
+    }
+    connect(m_device, &QIODevice::readyRead, this, &LevelMeter::onReadyRead);
+    startFrameTimer();
+}
+
+void LevelMeter::stop()
+{
+    m_frameTimer->stop();
+    if (m_input) {
+        m_input->stop();
+        m_input->deleteLater();
+        m_input = nullptr;
+    } else if (m_device) {
+        disconnect(m_device, nullptr, this, nullptr);
+    }
+    m_device = nullptr;
+
+    m_peak = 0;
+    m_level = 0;
+    if (!qFuzzyIsNull(m_reportedLevel)) {
+        m_reportedLevel = 0;
+        Q_EMIT levelChanged(m_reportedLevel);
+    }
+}
+
+void LevelMeter::restart()
+{
+    if (!m_device)
+        return;
+
+    stop();
+    start();
+}
+
+void LevelMeter::onReadyRead()
+{
+    const QByteArray data = m_device->readAll();
+    m_peak = qMax(m_peak, peakOf(data.constData(), data.size()));
+}
+
+void LevelMeter::onFrame()
+{
+    if (!m_input && m_device && !m_device->isSequential()) {
+        const QByteArray data = m_device->read(m_frameBytes);
+        m_peak = qMax(m_peak, peakOf(data.constData(), data.size()));
+    }
+
+    // 定时器间隔随刷新率变化且可能被推迟，衰减量与帧数无关
+    const double elapsed = m_frameClock.restart() / 1000.0;
+    m_level = qMax(m_peak, m_level * std::pow(LevelDecay, elapsed * LevelDecayRate));
+    m_peak = 0;
+    if (m_level < LevelEpsilon)
+        m_level = 0;
+
+    // 回落到 0 时总是通知，避免电平停在一个很小的值上
+    if (std::abs(m_level - m_reportedLevel) < LevelEpsilon && (m_level > 0 || qFuzzyIsNull(m_reportedLevel)))
+        return;
+
+    m_reportedLevel = m_level;
+    Q_EMIT levelChanged(m_reportedLevel);
+}
+
+void LevelMeter::startFrameTimer()
+{
+    QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal refreshRate = screen && screen->refreshRate() > 1 ? screen->refreshRate() : 60;
+    const int interval = qMax(1, qRound(1000 / refreshRate));
+    m_frameBytes = m_format.bytesForDuration(interval * 1000);
+    m_frameTimer->start(interval);
+    m_frameClock.start();
+}
+
+bool LevelMeter::isFormatSupported(const QAudioFormat &format)
+{
+    return (format.sampleType() == QAudioFormat::SignedInt && format.sampleSize() == 16)
+           || (format.sampleType() == QAudioFormat::Float && format.sampleSize() == 32);
+}
+
+double LevelMeter::peakOf(const char *data, qint64 size) const
+{
+    double peak = 0;
+    if (m_format.sampleType() == QAudioFormat::Float) {
+        for (qint64 i = 0; i + 4 <= size; i += 4) {
+            float value;
+            memcpy(&value, data + i, sizeof(value));
+            peak = qMax(peak, static_cast<double>(std::fabs(value)));
+        }
+    } else {
+        const bool little = m_format.byteOrder() == QAudioFormat::LittleEndian;
+        for (qint64 i = 0; i + 2 <= size; i += 2) {
+            const uchar *sample = reinterpret_cast<const uchar *>(data + i);
+            const qint16 value = little ? qFromLittleEndian<qint16>(sample) : qFromBigEndian<qint16>(sample);
+            peak = qMax(peak, std::abs(value) / 32768.0);
+        }
+    }
+
+    return qMin(peak, 1.0);
+}
+
+} // namespace sound
+} // namespace dcc
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEVELMETER_H
+#define LEVELMETER_H
+
+#include <QObject>
+#include <QAudioFormat>
+#include <QElapsedTimer>
+
+class QAudioInput;
+class QIODevice;
+class QTimer;
+
+namespace dcc {
+namespace sound {
+
+/**
+ * @brief LevelMeter 直接读取默认输入设备的采集流计算输入电平
+ *
+ * 每帧取采样峰值并做平滑（快速上升、按帧衰减），按屏幕刷新率通知界面，
+ * 只在 start() 与 stop() 之间采集，不经过音频服务的 D-Bus 接口。
+ * 也可以用 setSource() 指定文件等数据源代替输入设备。
+ */
+class LevelMeter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LevelMeter(QObject *parent = nullptr);
+    ~LevelMeter() override;
+
+    bool isActive() const { return m_device != nullptr; }
+    double level() const { return m_reportedLevel; }
+
+    /**
+     * @brief setSource 用 PCM 数据源代替默认输入设备，source 为空时恢复使用输入设备，下次 start() 时生效
+     *
+     * 顺序设备在 readyRead 时读取；文件、QBuffer 等可随机访问的设备每帧读取一帧时长的数据，模拟实时采集。
+     * @param format 数据格式，只支持 16 位整数和 32 位浮点
+     */
+    void setSource(QIODevice *source, const QAudioFormat &format);
+
+public Q_SLOTS:
+    void start();
+    void stop();
+    // 默认输入设备变化后重新打开采集流
+    void restart();
+
+Q_SIGNALS:
+    void levelChanged(double level);
+
+private:
+    void onReadyRead();
+    void onFrame();
+    void startFrameTimer();
+    double peakOf(const char *data, qint64 size) const;
+    static bool isFormatSupported(const QAudioFormat &format);
+
+private:
+    QAudioInput *m_input;
+    QIODevice *m_device;
+    QIODevice *m_source;
+    QAudioFormat m_format;
+    QAudioFormat m_sourceFormat;
+    qint64 m_frameBytes;
+    QTimer *m_frameTimer;
+    // 上一帧的时间，衰减按实际经过的时间计算
+    QElapsedTimer m_frameClock;
+    double m_peak;
+    double m_level;
+    double m_reportedLevel;
+};
+
+} // namespace sound
+} // namespace dcc
+
+#endif // LEVELMETER_H
@@ -24,13 +24,13 @@
  */
 
 #include "soundmodel.h"
+#include "modules/common/dbusproxyregistry.h"
 
 #include "window/utils.h"
 
 #include <DIconButton>
 
 #include <QDebug>
-#include <QDBusInterface>
 #include <QDBusReply>
 #include <QStandardItemModel>
 #include <QHBoxLayout>
@@ -100,9 +100,6 @@ SoundModel::SoundModel(QObject *parent)
     , m_speakerBalance(0)
     , m_microphoneVolume(75)
     , m_maxUIVolume(0.0)
-#ifndef DCC_DISABLE_FEEDBACK
-    , m_microphoneFeedback(50)
-#endif
     ,m_soundEffectMapBattery{}
 {
     m_soundEffectMapBattery = {
@@ -201,15 +198,6 @@ void SoundModel::setMicrophoneVolume(double microphoneVolume)
         Q_EMIT microphoneVolumeChanged(microphoneVolume);
     }
 }
-#ifndef DCC_DISABLE_FEEDBACK
-void SoundModel::setMicrophoneFeedback(double microphoneFeedback)
-{
-    if (!qFuzzyCompare(microphoneFeedback, m_microphoneFeedback)) {
-        m_microphoneFeedback = microphoneFeedback;
-        Q_EMIT microphoneFeedbackChanged(microphoneFeedback);
-    }
-}
-#endif
 
 void SoundModel::setPort(const Port *port)
 {
@@ -220,6 +208,7 @@ void SoundModel::addPort(Port *port)
 {
     if (!containsPort(port)) {
         m_ports.append(port);
+        m_portIndex.insert(qMakePair(port->cardId(), port->id()), port);
         Q_EMIT portAdded(port);
     }
 }
@@ -229,6 +218,7 @@ void SoundModel::removePort(const QString &portId, const uint &cardId)
     Port *port = findPort(portId, cardId);
     if (port) {
         m_ports.removeOne(port);
+        m_portIndex.remove(qMakePair(cardId, portId));
         port->deleteLater();
         Q_EMIT portRemoved(portId, cardId);
     }
@@ -241,15 +231,7 @@ bool SoundModel::containsPort(const Port *port)
 
 Port *SoundModel::findPort(const QString &portId, const uint &cardId) const
 {
-    auto res = std::find_if(m_ports.cbegin(), m_ports.end(), [=] (const Port *data)->bool{
-        return (data->id() == portId && data->cardId() == cardId);
-    });
-
-    if (res != m_ports.cend()) {
-        return *res;
-    }
-
-    return nullptr;
+    return m_portIndex.value(qMakePair(cardId, portId), nullptr);
 }
 
 QList<Port *> SoundModel::ports() const
@@ -410,14 +392,16 @@ bool SoundModel::isShow(QStandardItemModel *model, const Port *port)
     if (model->rowCount() < 2) return false;
 
     //有端口启用时,直接返回true
-    QDBusInterface inter("com.deepin.daemon.Audio", "/com/deepin/daemon/Audio", "com.deepin.daemon.Audio", QDBusConnection::sessionBus(), this);
+    if (!m_audioInter)
+        m_audioInter = dcc::DBusProxyRegistry::instance()->proxy(QDBusConnection::sessionBus(), "com.deepin.daemon.Audio",
+                                                                 "/com/deepin/daemon/Audio", "com.deepin.daemon.Audio");
     for (int i = 0; i < model->rowCount(); i++) {
         auto temp = model->index(i, 0);
         const auto * it = model->data(temp, Qt::WhatsThisPropertyRole).value<const Port *>();
         if (!it)
             return false;
         if (it->cardId() != port->cardId() || it->name() != port->name()) {
-            QDBusReply<bool> reply = inter.call("IsPortEnabled", it->cardId(), it->id());
+            QDBusReply<bool> reply = m_audioInter->call("IsPortEnabled", {it->cardId(), it->id()});
             if (reply.value())
                 return true;
         }
@@ -29,6 +29,9 @@
 #include <QDBusObjectPath>
 #include <QObject>
 #include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QSharedPointer>
 #include <QString>
 #include <QLabel>
 
@@ -40,6 +43,10 @@ DWIDGET_BEGIN_NAMESPACE
 class DIconButton;
 DWIDGET_END_NAMESPACE
 
+namespace dcc {
+class DBusObjectProxy;
+}
+
 QT_BEGIN_NAMESPACE
 class QStandardItemModel;
 QT_END_NAMESPACE
@@ -138,11 +145,6 @@ public:
     inline double microphoneVolume() const { return m_microphoneVolume; }
     void setMicrophoneVolume(double microphoneVolume);
 
-#ifndef DCC_DISABLE_FEEDBACK
-    inline double microphoneFeedback() const { return m_microphoneFeedback; }
-    void setMicrophoneFeedback(double microphoneFeedback);
-#endif
-
     void setPort(const Port *port);
     void addPort(Port *port);
     void removePort(const QString &portId, const uint &cardId);
@@ -220,9 +222,6 @@ Q_SIGNALS:
     //噪音抑制是否可见
     void setNoiseReduceVisible(bool flag);
 
-#ifndef DCC_DISABLE_FEEDBACK
-    void microphoneFeedbackChanged(double microphoneFeedback) const;
-#endif
     void portAdded(const Port *port);
     void portRemoved(const QString & portId, const uint &cardId);
     void soundEffectDataChanged(DDesktopServices::SystemSoundEffect effect, const bool enable);
@@ -242,15 +241,16 @@ private:
     double m_microphoneVolume;
     double m_maxUIVolume;
 
-#ifndef DCC_DISABLE_FEEDBACK
-    double m_microphoneFeedback;
-#endif
     QList<Port *> m_ports;
+    // 按 (声卡 id, 端口名) 索引端口
+    QHash<QPair<uint, QString>, Port *> m_portIndex;
     Port *m_activePort;
 
     QDBusObjectPath m_defaultSource;
     QDBusObjectPath m_defaultSink;
     QString m_audioCards;
+    // 用于查询端口是否启用，首次使用时创建
+    QSharedPointer<dcc::DBusObjectProxy> m_audioInter;
 
     SoundEffectList m_soundEffectMapPower;
     SoundEffectList m_soundEffectMapBattery;
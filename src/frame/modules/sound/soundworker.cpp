@@ -28,8 +28,10 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QSet>
 #include <QDebug>
 #include <QGSettings>
+#include <QTimer>
 
 namespace dcc {
 namespace sound {
@@ -43,20 +45,17 @@ SoundWorker::SoundWorker(SoundModel *model, QObject *parent)
     , m_soundEffectInter(new SoundEffect("com.deepin.daemon.SoundEffect", "/com/deepin/daemon/SoundEffect", QDBusConnection::sessionBus(), this))
     , m_defaultSink(nullptr)
     , m_defaultSource(nullptr)
-    , m_sourceMeter(nullptr)
     , m_effectGsettings(new QGSettings("com.deepin.dde.sound-effect", "", this))
     , m_powerInter(new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
-    , m_pingTimer(new QTimer(this))
     , m_activeTimer(new QTimer(this))
 {
     m_audioInter->setSync(false);
     m_powerInter->setSync(false);
 
-    m_pingTimer->setInterval(5000);
-    m_pingTimer->setSingleShot(false);
-
-    m_activeTimer->setInterval(100);
+    // 端口名和声卡号分两个信号到达，合并到下一次事件循环再更新激活状态
+    m_activeTimer->setInterval(0);
     m_activeTimer->setSingleShot(true);
+    connect(m_activeTimer, &QTimer::timeout, this, &SoundWorker::updatePortActivity);
 
     connect(m_model, &SoundModel::defaultSinkChanged, this, &SoundWorker::defaultSinkChanged);
     connect(m_model, &SoundModel::defaultSourceChanged, this, &SoundWorker::defaultSourceChanged);
@@ -79,8 +78,6 @@ SoundWorker::SoundWorker(SoundModel *model, QObject *parent)
     });
     connect(m_soundEffectInter, &SoundEffect::EnabledChanged, m_model, &SoundModel::setEnableSoundEffect);
 
-    connect(m_pingTimer, &QTimer::timeout, [this] { if (m_sourceMeter) m_sourceMeter->Tick(); });
-    connect(m_activeTimer, &QTimer::timeout, this, &SoundWorker::updatePortActivity);
     connect(m_powerInter, &PowerInter::LidIsPresentChanged, m_model, &SoundModel::setIsLaptop);
 
     m_model->setDefaultSink(m_audioInter->defaultSink());
@@ -94,12 +91,9 @@ SoundWorker::SoundWorker(SoundModel *model, QObject *parent)
 
 void SoundWorker::activate()
 {
-    m_pingTimer->start();
-
     m_audioInter->blockSignals(false);
     if (m_defaultSink) m_defaultSink->blockSignals(false);
     if (m_defaultSource) m_defaultSource->blockSignals(false);
-    if (m_sourceMeter) m_sourceMeter->blockSignals(false);
 
     defaultSinkChanged(m_model->defaultSink());
     defaultSourceChanged(m_model->defaultSource());
@@ -108,12 +102,9 @@ void SoundWorker::activate()
 
 void SoundWorker::deactivate()
 {
-    m_pingTimer->stop();
-
     m_audioInter->blockSignals(true);
     if (m_defaultSink) m_defaultSink->blockSignals(true);
     if (m_defaultSource) m_defaultSource->blockSignals(true);
-    if (m_sourceMeter) m_sourceMeter->blockSignals(true);
 }
 
 void SoundWorker::refreshSoundEffect()
@@ -272,33 +263,12 @@ void SoundWorker::defaultSourceChanged(const QDBusObjectPath &path)
     m_model->setMicrophoneVolume(m_defaultSource->volume());
     activeSourcePortChanged(m_defaultSource->activePort());
     onSourceCardChanged(m_defaultSource->card());
-
-#ifndef DCC_DISABLE_FEEDBACK
-    QDBusPendingCall call = m_defaultSource->GetMeter();
-    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, [this, call] {
-        if (!call.isError()) {
-            QDBusReply<QDBusObjectPath> reply = call.reply();
-            QDBusObjectPath path = reply.value();
-
-            if (m_sourceMeter) {
-                m_sourceMeter->deleteLater();
-            }
-
-            m_sourceMeter = new Meter("com.deepin.daemon.Audio", path.path(), QDBusConnection::sessionBus(), this);
-            m_sourceMeter->setSync(false);
-            connect(m_sourceMeter, &Meter::VolumeChanged, m_model, &SoundModel::setMicrophoneFeedback);
-            m_model->setMicrophoneFeedback(m_sourceMeter->volume());
-        } else {
-            qDebug() << "get meter failed " << call.error().message();
-        }
-    });
-#endif
 }
 
 void SoundWorker::cardsChanged(const QString &cards)
 {
-    QMap<uint, QStringList> tmpCardIds;
+    QSet<QPair<uint, QString>> availablePorts;
+    int added = 0;
     QJsonDocument doc = QJsonDocument::fromJson(cards.toUtf8());
     QJsonArray jCards = doc.array();
     for (QJsonValue cV : jCards) {
@@ -307,8 +277,6 @@ void SoundWorker::cardsChanged(const QString &cards)
         const QString cardName = jCard["Name"].toString();
         QJsonArray jPorts = jCard["Ports"].toArray();
 
-        QStringList tmpPorts;
-
         for (QJsonValue pV : jPorts) {
             QJsonObject jPort = pV.toObject();
             const double portAvai = jPort["Available"].toDouble();
@@ -316,6 +284,7 @@ void SoundWorker::cardsChanged(const QString &cards)
                 const QString portId = jPort["Name"].toString();
                 const QString portName = jPort["Description"].toString();
 
+                // 已有的端口只更新属性，属性未变化时不会发出信号
                 Port *port = m_model->findPort(portId, cardId);
                 const bool include = port != nullptr;
                 if (!include) { port = new Port(m_model); }
@@ -325,26 +294,30 @@ void SoundWorker::cardsChanged(const QString &cards)
                 port->setDirection(Port::Direction(jPort["Direction"].toDouble()));
                 port->setCardId(cardId);
                 port->setCardName(cardName);
-                port->setIsActive(portId == m_activeSinkPort || portId == m_activeSourcePort);
+                port->setIsActive(isActivePort(port));
 
-                if (!include) { m_model->addPort(port); }
+                if (!include) {
+                    m_model->addPort(port);
+                    ++added;
+                }
 
-                tmpPorts << portId;
+                availablePorts.insert(qMakePair(cardId, portId));
             }
         }
-        if (!jPorts.isEmpty())
-            tmpCardIds.insert(cardId, tmpPorts);
     }
 
+    int removed = 0;
     for (Port *port : m_model->ports()) {
-        //if the card is not in the list
-        if (!tmpCardIds.contains(port->cardId())) {
-            m_model->removePort(port->id(), port->cardId());
-        }
-        else if (!tmpCardIds[port->cardId()].contains(port->id())) {
+        if (!availablePorts.contains(qMakePair(port->cardId(), port->id()))) {
             m_model->removePort(port->id(), port->cardId());
+            ++removed;
         }
     }
+
+    if (added || removed) {
+        qDebug() << "audio ports changed, added:" << added << "removed:" << removed;
+        m_activeTimer->start();
+    }
 }
 
 void SoundWorker::activeSinkPortChanged(const AudioPort &activeSinkPort)
@@ -420,14 +393,29 @@ void SoundWorker::getSoundPathFinished(QDBusPendingCallWatcher *watcher)
     watcher->deleteLater();
 }
 
-void SoundWorker::updatePortActivity()
+bool SoundWorker::isActivePort(const Port *port) const
 {
-    for (Port *port : m_model->ports()) {
-        const bool isActiveOuputPort = (port->id() == m_activeSinkPort) && (port->cardId() == m_activeOutputCard);
-        const bool isActiveInputPort = (port->id() == m_activeSourcePort) && (port->cardId() == m_activeInputCard);
+    return (port->id() == m_activeSinkPort && port->cardId() == m_activeOutputCard)
+           || (port->id() == m_activeSourcePort && port->cardId() == m_activeInputCard);
+}
 
-        port->setIsActive(isActiveInputPort || isActiveOuputPort);
-    }
+void SoundWorker::updatePortActivity()
+{
+    // 只更新激活状态发生变化的端口，不再遍历全部端口
+    Port *output = m_model->findPort(m_activeSinkPort, m_activeOutputCard);
+    Port *input = m_model->findPort(m_activeSourcePort, m_activeInputCard);
+
+    if (m_activeOutputPort && m_activeOutputPort != output && m_activeOutputPort != input)
+        m_activeOutputPort->setIsActive(false);
+    if (m_activeInputPort && m_activeInputPort != input && m_activeInputPort != output)
+        m_activeInputPort->setIsActive(false);
+
+    m_activeOutputPort = output;
+    m_activeInputPort = input;
+    if (output)
+        output->setIsActive(true);
+    if (input)
+        input->setIsActive(true);
 }
 
 /**
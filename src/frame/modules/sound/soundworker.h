@@ -31,7 +31,6 @@
 #include <com_deepin_daemon_audio.h>
 #include <com_deepin_daemon_audio_sink.h>
 #include <com_deepin_daemon_audio_source.h>
-#include <com_deepin_daemon_audio_meter.h>
 #include <com_deepin_daemon_soundeffect.h>
 #include <com_deepin_daemon_power.h>
 
@@ -45,11 +44,11 @@ DWIDGET_USE_NAMESPACE
 using com::deepin::daemon::Audio;
 using com::deepin::daemon::audio::Sink;
 using com::deepin::daemon::audio::Source;
-using com::deepin::daemon::audio::Meter;
 using com::deepin::daemon::SoundEffect;
 using PowerInter = com::deepin::daemon::Power;
 
 class QGSettings;
+class QTimer;
 
 namespace dcc {
 namespace sound {
@@ -102,6 +101,7 @@ private Q_SLOTS:
     void getSoundPathFinished(QDBusPendingCallWatcher *watcher);
     
 private:
+    bool isActivePort(const Port *port) const;
     void updatePortActivity();
 
 private:
@@ -115,14 +115,15 @@ private:
     SoundEffect *m_soundEffectInter;
     QPointer<Sink> m_defaultSink;
     QPointer<Source> m_defaultSource;
-    QPointer<Meter> m_sourceMeter;
     QList<Sink*> m_sinks;
     QList<Source*> m_sources;
     QGSettings *m_effectGsettings;
     PowerInter *m_powerInter;
-
-    QTimer *m_pingTimer;
     QTimer *m_activeTimer;
+
+    // 当前标记为激活的输出/输入端口
+    QPointer<Port> m_activeOutputPort;
+    QPointer<Port> m_activeInputPort;
 };
 
 }
@@ -1,10 +1,15 @@
 #include "syncworker.h"
 #include "widgets/utils.h"
+#include "modules/common/propertysnapshot.h"
+#include "modules/common/dbusfuture.h"
+#include "modules/common/licensestate.h"
 
 #include <QProcess>
 #include <QDBusConnection>
-#include <QFutureWatcher>
-#include <QtConcurrent>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <DSysInfo>
 
 DCORE_USE_NAMESPACE
@@ -30,23 +35,31 @@ SyncWorker::SyncWorker(SyncModel *model, QObject *parent)
                                           "sa{sv}as",
                                           this, SLOT(userInfoChanged(QDBusMessage)));
 
-    m_activeInfo = new QDBusInterface("com.deepin.license",
-                                      "/com/deepin/license/Info",
-                                      "com.deepin.license.Info",
-                                      QDBusConnection::systemBus(),this);
-
-    connect(m_activeInfo, SIGNAL(LicenseStateChange()),this, SLOT(licenseStateChangeSlot()));
     connect(m_syncInter, &SyncInter::StateChanged, this, &SyncWorker::onStateChanged, Qt::QueuedConnection);
     connect(m_syncInter, &SyncInter::LastSyncTimeChanged, this, &SyncWorker::onLastSyncTimeChanged, Qt::QueuedConnection);
     connect(m_syncInter, &SyncInter::SwitcherChange, this, &SyncWorker::onSyncModuleStateChanged, Qt::QueuedConnection);
     connect(m_deepinId_inter, &DeepinId::UserInfoChanged, m_model, &SyncModel::setUserinfo, Qt::QueuedConnection);
 
-    auto req = QDBusConnection::sessionBus().interface()->isServiceRegistered("com.deepin.deepinid");
+    if (DSysInfo::DeepinDesktop == DSysInfo::deepinType()) {
+        m_model->setActivation(true);
+    } else {
+        LicenseState::instance()->subscribe(this, [this](quint32 state) {
+            m_model->setActivation(LicenseState::isActivated(state));
+        });
+    }
 
-    m_model->setSyncIsValid(req.value() && valueByQSettings<bool>(DCC_CONFIG_FILES, "CloudSync", "AllowCloudSync", false));
-    licenseStateChangeSlot();
+    QDBusPendingCallWatcher *registeredWatcher = new QDBusPendingCallWatcher(
+        QDBusConnection::sessionBus().interface()->asyncCall("NameHasOwner", "com.deepin.deepinid"), this);
+    connect(registeredWatcher, &QDBusPendingCallWatcher::finished, this, [this, registeredWatcher] {
+        QDBusPendingReply<bool> reply = *registeredWatcher;
+        m_model->setSyncIsValid(reply.value() && valueByQSettings<bool>(DCC_CONFIG_FILES, "CloudSync", "AllowCloudSync", false));
+        registeredWatcher->deleteLater();
+    });
 
-    m_model->setUserinfo(m_deepinId_inter->userInfo());
+    PropertySnapshot().add(m_deepinId_inter, {"UserInfo"}).fetch(this, [this](const PropertySnapshot &snapshot) {
+        if (snapshot.contains(m_deepinId_inter, "UserInfo"))
+            m_model->setUserinfo(qdbus_cast<QVariantMap>(snapshot.value(m_deepinId_inter, "UserInfo")));
+    });
 }
 
 void SyncWorker::activate()
@@ -68,10 +81,8 @@ void SyncWorker::deactivate()
 
 void SyncWorker::refreshSyncState()
 {
-    QFutureWatcher<QJsonObject> *watcher = new QFutureWatcher<QJsonObject>(this);
-    connect(watcher, &QFutureWatcher<QJsonObject>::finished, this, [=] {
-        watcher->deleteLater();
-        QJsonObject obj = std::move(watcher->result());
+    DBusFuture<QString>(m_syncInter->SwitcherDump(), "com.deepin.sync.Daemon.SwitcherDump").then(this, [this](const QString &dump) {
+        const QJsonObject obj = QJsonDocument::fromJson(dump.toUtf8()).object();
 
         if (obj.isEmpty()) {
             qDebug() << "Sync Info is Wrong!";
@@ -88,14 +99,6 @@ void SyncWorker::refreshSyncState()
             m_model->setModuleSyncState(it->first, obj[it->second.first()].toBool());
         }
     });
-
-    QFuture<QJsonObject> future = QtConcurrent::run([=]() -> QJsonObject {
-        QDBusPendingReply<QString> reply = m_syncInter->SwitcherDump();
-        reply.waitForFinished();
-        return QJsonDocument::fromJson(reply.value().toUtf8()).object();
-    });
-
-    watcher->setFuture(future);
 }
 
 void SyncWorker::setSync(std::pair<SyncType, bool> state)
@@ -173,35 +176,3 @@ void SyncWorker::onLastSyncTimeChanged(qlonglong lastSyncTime)
     m_model->setLastSyncTime(lastSyncTime);
 
 }
-
-void SyncWorker::licenseStateChangeSlot()
-{
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<void>::finished, watcher,
-            &QFutureWatcher<void>::deleteLater);
-
-    QFuture<void> future = QtConcurrent::run(this, &SyncWorker::getLicenseState);
-    watcher->setFuture(future);
-}
-
-void SyncWorker::getLicenseState()
-{
-    if (DSysInfo::DeepinDesktop == DSysInfo::deepinType()) {
-        m_model->setActivation(true);
-        return;
-    }
-
-    QDBusInterface licenseInfo("com.deepin.license",
-                               "/com/deepin/license/Info",
-                               "com.deepin.license.Info",
-                               QDBusConnection::systemBus());
-
-    if (!licenseInfo.isValid()) {
-        qWarning()<< "com.deepin.license error ,"<< licenseInfo.lastError().name();
-        return;
-    }
-
-    quint32 reply = licenseInfo.property("AuthorizationState").toUInt();
-    qDebug() << "authorize result:" << reply;
-    m_model->setActivation(reply == 1 || reply == 3);
-}
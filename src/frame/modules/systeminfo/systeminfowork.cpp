@@ -28,6 +28,8 @@
 #include "widgets/basiclistdelegate.h"
 #include "dsysinfo.h"
 #include "window/utils.h"
+#include "modules/common/systemcapabilities.h"
+#include "modules/common/licensestate.h"
 
 #include <QFutureWatcher>
 #include <QtConcurrent>
@@ -63,12 +65,6 @@ SystemInfoWork::SystemInfoWork(SystemInfoModel *model, QObject *parent)
                                         "/com/deepin/daemon/Grub2/Theme",
                                         QDBusConnection::systemBus(), this);
 
-    if (DSysInfo::isDeepin()) {
-        m_activeInfo = new QDBusInterface("com.deepin.license",
-                                          "/com/deepin/license/Info",
-                                          "com.deepin.license.Info",
-                                          QDBusConnection::systemBus(),this);
-    }
 #if 0
     //预留接口
     m_dbusActivator = new GrubThemeDbus("com.deepin.license",
@@ -104,10 +100,13 @@ SystemInfoWork::SystemInfoWork(SystemInfoModel *model, QObject *parent)
     m_dbusGrub->setSync(false, false);
     m_dbusGrubTheme->setSync(false, false);
 
+#ifndef DISABLE_ACTIVATOR
     if (DSysInfo::isDeepin()) {
-        connect(m_activeInfo, SIGNAL(LicenseStateChange()),this, SLOT(licenseStateChangeSlot()));
-        licenseStateChangeSlot();
+        LicenseState::instance()->subscribe(this, [this](quint32 state) {
+            m_model->setLicenseState(static_cast<ActiveState>(state));
+        });
     }
+#endif
 
     connect(m_dbusGrub, &GrubDbus::DefaultEntryChanged, m_model, &SystemInfoModel::setDefaultEntry);
     connect(m_dbusGrub, &GrubDbus::EnableThemeChanged, m_model, &SystemInfoModel::setThemeEnabled);
@@ -127,15 +126,7 @@ SystemInfoWork::SystemInfoWork(SystemInfoModel *model, QObject *parent)
     connect(m_systemInfoInter, &__SystemInfo::DistroVerChanged, m_model, &SystemInfoModel::setDistroVer);
     connect(m_systemInfoInter, &__SystemInfo::DiskCapChanged, m_model, &SystemInfoModel::setDisk);
 
-    QProcess process;
-    process.start("uname -r");
-    process.waitForFinished();
-    QByteArray output = process.readAllStandardOutput();
-    int idx = output.indexOf('\n');
-    if ( -1 != idx) {
-        output.remove(idx, 1);
-    }
-    m_model->setKernel(output);
+    m_model->setKernel(SystemCapabilities::instance()->kernelRelease());
 }
 
 void SystemInfoWork::activate()
@@ -295,16 +286,6 @@ void SystemInfoWork::showActivatorDialog()
     activator.call(QDBus::AutoDetect, "Show");
 }
 
-void SystemInfoWork::licenseStateChangeSlot()
-{
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<void>::finished, watcher,
-            &QFutureWatcher<void>::deleteLater);
-
-    QFuture<void> future = QtConcurrent::run(this, &SystemInfoWork::getLicenseState);
-    watcher->setFuture(future);
-}
-
 void SystemInfoWork::getEntryTitles()
 {
     QDBusPendingCall call = m_dbusGrub->GetSimpleEntryTitles();
@@ -348,24 +329,5 @@ void SystemInfoWork::getBackgroundFinished(QDBusPendingCallWatcher *w)
     w->deleteLater();
 }
 
-#ifndef DISABLE_ACTIVATOR
-void SystemInfoWork::getLicenseState()
-{
-    QDBusInterface licenseInfo("com.deepin.license",
-                               "/com/deepin/license/Info",
-                               "com.deepin.license.Info",
-                               QDBusConnection::systemBus());
-
-    if (!licenseInfo.isValid()) {
-        qDebug() << "com.deepin.license error ," << licenseInfo.lastError().name();
-        return;
-    }
-
-    ActiveState reply = licenseInfo.property("AuthorizationState").value<ActiveState>();
-    qDebug() << "authorize result:" << reply;
-    m_model->setLicenseState(reply);
-}
-#endif
-
 }
 }
@@ -63,13 +63,11 @@ public Q_SLOTS:
     void onBackgroundChanged();
     void setBackground(const QString &path);
     void showActivatorDialog();
-    void licenseStateChangeSlot();
     void processChanged(QDBusMessage msg);
 
 private:
     void getEntryTitles();
     void getBackgroundFinished(QDBusPendingCallWatcher *w);
-    void getLicenseState();
 
 private:
     SystemInfoModel* m_model;
@@ -77,7 +75,6 @@ private:
     GrubDbus* m_dbusGrub;
     GrubThemeDbus *m_dbusGrubTheme;
     QDBusInterface *m_systemInfo;
-    QDBusInterface *m_activeInfo;
 };
 
 }
@@ -21,10 +21,13 @@
 
 #include "unionidworker.h"
 #include "widgets/utils.h"
+#include "modules/common/propertysnapshot.h"
 
 #include <QProcess>
 #include <QDBusConnection>
 #include <QDesktopServices>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 
 using namespace dcc;
 using namespace dcc::unionid;
@@ -44,8 +47,13 @@ UnionidWorker::UnionidWorker(UnionidModel *model, QObject *parent)
     connect(m_deepinId_inter, &DeepinId::UserInfoChanged, m_model, &UnionidModel::setUserinfo, Qt::QueuedConnection);
     connect(m_syncInter, &SyncInter::StateChanged, this, &UnionidWorker::onStateChanged, Qt::QueuedConnection);
 
-    auto req = QDBusConnection::sessionBus().interface()->isServiceRegistered("com.deepin.deepinid");
-    m_model->setSyncIsValid(req.value() && valueByQSettings<bool>(DCC_CONFIG_FILES, "CloudSync", "AllowCloudSync", false));
+    QDBusPendingCallWatcher *registeredWatcher = new QDBusPendingCallWatcher(
+        QDBusConnection::sessionBus().interface()->asyncCall("NameHasOwner", "com.deepin.deepinid"), this);
+    connect(registeredWatcher, &QDBusPendingCallWatcher::finished, this, [this, registeredWatcher] {
+        QDBusPendingReply<bool> reply = *registeredWatcher;
+        m_model->setSyncIsValid(reply.value() && valueByQSettings<bool>(DCC_CONFIG_FILES, "CloudSync", "AllowCloudSync", false));
+        registeredWatcher->deleteLater();
+    });
 }
 
 void UnionidWorker::activate()
@@ -53,7 +61,10 @@ void UnionidWorker::activate()
     m_syncInter->blockSignals(false);
     m_deepinId_inter->blockSignals(false);
 
-    m_model->setUserinfo(m_deepinId_inter->userInfo());
+    PropertySnapshot().add(m_deepinId_inter, {"UserInfo"}).fetch(this, [this](const PropertySnapshot &snapshot) {
+        if (snapshot.contains(m_deepinId_inter, "UserInfo"))
+            m_model->setUserinfo(qdbus_cast<QVariantMap>(snapshot.value(m_deepinId_inter, "UserInfo")));
+    });
     onStateChanged(m_syncInter->state());
 }
 
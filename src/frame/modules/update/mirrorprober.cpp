@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mirrorprober.h"
+#include "updatemodel.h"
+
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QDebug>
+
+namespace dcc {
+namespace update {
+
+MirrorProber::MirrorProber(QObject *parent)
+    : QObject(parent)
+    , m_concurrency(8)
+    , m_timeout(3000)
+{
+}
+
+void MirrorProber::setConcurrency(int concurrency)
+{
+    m_concurrency = qMax(1, concurrency);
+}
+
+void MirrorProber::setTimeout(int msec)
+{
+    m_timeout = qMax(100, msec);
+}
+
+void MirrorProber::probe(const QMap<QString, QString> &urls)
+{
+    abort();
+
+    for (auto it = urls.constBegin(); it != urls.constEnd(); ++it)
+        m_jobs.enqueue({it.key(), QUrl(it.value())});
+
+    startNext();
+}
+
+void MirrorProber::abort()
+{
+    m_jobs.clear();
+
+    const QSet<QTcpSocket *> sockets = m_sockets;
+    m_sockets.clear();
+    for (QTcpSocket *socket : sockets) {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+}
+
+void MirrorProber::startNext()
+{
+    while (m_sockets.size() < m_concurrency && !m_jobs.isEmpty()) {
+        const Job job = m_jobs.dequeue();
+        const int port = job.url.port(job.url.scheme() == "https" ? 443 : 80);
+        if (job.url.host().isEmpty()) {
+            Q_EMIT probed(job.id, MirrorTimeoutSpeed);
+            continue;
+        }
+
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setProperty("mirrorId", job.id);
+        m_sockets.insert(socket);
+
+        QElapsedTimer elapsed;
+        elapsed.start();
+        connect(socket, &QTcpSocket::connected, this, [this, socket, elapsed] {
+            finishProbe(socket, static_cast<int>(qMin<qint64>(elapsed.elapsed(), MirrorTimeoutSpeed - 1)));
+        });
+        connect(socket, static_cast<void (QAbstractSocket::*)(QAbstractSocket::SocketError)>(&QAbstractSocket::error), this, [this, socket, job] {
+            qDebug() << "probe mirror" << job.url.host() << "failed:" << socket->errorString();
+            finishProbe(socket, MirrorTimeoutSpeed);
+        });
+        QTimer::singleShot(m_timeout, socket, [this, socket] {
+            finishProbe(socket, MirrorTimeoutSpeed);
+        });
+
+        // 域名解析和连接都是异步的，耗时计入延迟
+        socket->connectToHost(job.url.host(), static_cast<quint16>(port));
+    }
+
+    if (m_sockets.isEmpty() && m_jobs.isEmpty())
+        Q_EMIT finished();
+}
+
+void MirrorProber::finishProbe(QTcpSocket *socket, int latency)
+{
+    // 连接成功、出错和超时可能先后到达，只处理第一次
+    if (!m_sockets.remove(socket))
+        return;
+
+    const QString id = socket->property("mirrorId").toString();
+    socket->disconnect(this);
+    socket->abort();
+    socket->deleteLater();
+
+    Q_EMIT probed(id, latency);
+    startNext();
+}
+
+} // namespace update
+} // namespace dcc
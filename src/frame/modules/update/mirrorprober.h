@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRORPROBER_H
+#define MIRRORPROBER_H
+
+#include <QObject>
+#include <QMap>
+#include <QQueue>
+#include <QSet>
+#include <QUrl>
+
+class QTcpSocket;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief MirrorProber 在进程内测量镜像源的连接延迟
+ *
+ * 使用非阻塞的 TCP 连接计时，同时进行的探测数量受 concurrency 限制，
+ * 连接失败或超时的镜像结果为 MirrorTimeoutSpeed，与 netselect 超时的结果一致。
+ */
+class MirrorProber : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MirrorProber(QObject *parent = nullptr);
+
+    void setConcurrency(int concurrency);
+    void setTimeout(int msec);
+
+    /**
+     * @brief probe 开始探测，会取消上一次未完成的探测
+     * @param urls 镜像 id 到镜像地址的映射
+     */
+    void probe(const QMap<QString, QString> &urls);
+    void abort();
+
+Q_SIGNALS:
+    void probed(const QString &id, int latency);
+    void finished();
+
+private:
+    void startNext();
+    void finishProbe(QTcpSocket *socket, int latency);
+
+private:
+    struct Job {
+        QString id;
+        QUrl url;
+    };
+
+    int m_concurrency;
+    int m_timeout;
+    QQueue<Job> m_jobs;
+    QSet<QTcpSocket *> m_sockets;
+};
+
+} // namespace update
+} // namespace dcc
+
+#endif // MIRRORPROBER_H
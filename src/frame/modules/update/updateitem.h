@@ -52,6 +52,7 @@ public:
     explicit UpdateItem(QFrame* parent = 0);
 
     void setAppInfo(const AppUpdateInfo& info);
+    const AppUpdateInfo &appInfo() const { return m_info; }
 
     QSize sizeHint() const override;
 
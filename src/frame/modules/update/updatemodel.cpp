@@ -26,6 +26,8 @@
 #include "updatemodel.h"
 #include "modules/systeminfo/systeminfomodel.h"
 
+#include <QDateTime>
+
 namespace dcc{
 namespace update{
 
@@ -46,6 +48,14 @@ void DownloadInfo::setDownloadProgress(double downloadProgress)
     }
 }
 
+void DownloadInfo::setDownloadSize(qlonglong downloadSize)
+{
+    if (m_downloadSize != downloadSize) {
+        m_downloadSize = downloadSize;
+        Q_EMIT downloadSizeChanged(downloadSize);
+    }
+}
+
 
 UpdateModel::UpdateModel(QObject *parent)
     : QObject(parent)
@@ -127,6 +137,33 @@ void UpdateModel::setMirrorSpeedInfo(const QMap<QString, int> &mirrorSpeedInfo)
         Q_EMIT mirrorSpeedInfoAvaiable(mirrorSpeedInfo);
 }
 
+void UpdateModel::updateMirrorSpeed(const QString &mirrorId, int speed)
+{
+    m_mirrorSpeedInfo[mirrorId] = speed;
+
+    if (speed < MirrorTimeoutSpeed) {
+        m_mirrorSpeedCache[mirrorId] = speed;
+        m_mirrorSpeedTime[mirrorId] = QDateTime::currentMSecsSinceEpoch();
+    } else {
+        m_mirrorSpeedCache.remove(mirrorId);
+        m_mirrorSpeedTime.remove(mirrorId);
+    }
+
+    Q_EMIT mirrorSpeedInfoAvaiable(m_mirrorSpeedInfo);
+}
+
+QMap<QString, int> UpdateModel::cachedMirrorSpeed(qint64 ttl) const
+{
+    QMap<QString, int> result;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (auto it = m_mirrorSpeedTime.constBegin(); it != m_mirrorSpeedTime.constEnd(); ++it) {
+        if (now - it.value() < ttl)
+            result.insert(it.key(), m_mirrorSpeedCache.value(it.key()));
+    }
+
+    return result;
+}
+
 bool UpdateModel::lowBattery() const
 {
     return m_lowBattery;
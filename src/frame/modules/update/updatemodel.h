@@ -35,6 +35,9 @@
 namespace dcc{
 namespace update{
 
+// 镜像测速失败或超时的结果，与 netselect 超时时的输出一致
+const int MirrorTimeoutSpeed = 10000;
+
 class DownloadInfo : public QObject
 {
     Q_OBJECT
@@ -47,9 +50,11 @@ public:
     QList<AppUpdateInfo> appInfos() const { return m_appInfos; }
 
     void setDownloadProgress(double downloadProgress);
+    void setDownloadSize(qlonglong downloadSize);
 
 Q_SIGNALS:
     void downloadProgressChanged(const double &progress);
+    void downloadSizeChanged(qlonglong downloadSize);
 
 private:
     qlonglong m_downloadSize;
@@ -102,6 +107,11 @@ public:
 
     QMap<QString, int> mirrorSpeedInfo() const;
     void setMirrorSpeedInfo(const QMap<QString, int> &mirrorSpeedInfo);
+    void updateMirrorSpeed(const QString &mirrorId, int speed);
+    /**
+     * @brief cachedMirrorSpeed 返回 ttl 毫秒内测得的测速结果，超时的结果不缓存
+     */
+    QMap<QString, int> cachedMirrorSpeed(qint64 ttl) const;
 
     bool lowBattery() const;
     void setLowBattery(bool lowBattery);
@@ -234,6 +244,8 @@ private:
     QString m_mirrorId;
     MirrorInfoList m_mirrorList;
     QMap<QString, int> m_mirrorSpeedInfo;
+    QMap<QString, int> m_mirrorSpeedCache;
+    QMap<QString, qint64> m_mirrorSpeedTime;
     bool m_bRecoverBackingUp;
     bool m_bRecoverConfigValid;
     bool m_bRecoverRestoring;
@@ -24,13 +24,18 @@
  */
 
 #include "updatework.h"
+#include "mirrorprober.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
+#include "modules/common/licensestate.h"
+#include "modules/common/propertysnapshot.h"
+#include "modules/common/dbustelemetry.h"
 #include <QtConcurrent>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QDBusMessage>
 #include <QApplication>
 
 #define MIN_NM_ACTIVE 50
@@ -43,47 +48,6 @@ const QString DDEId = "dde";
 
 namespace dcc {
 namespace update {
-static int TestMirrorSpeedInternal(const QString &url, QPointer<QObject> baseObject)
-{
-    if (!baseObject || QCoreApplication::closingDown()) {
-        return -1;
-    }
-
-    QStringList args;
-    args << url << "-s" << "1";
-
-    QProcess process;
-    process.start("netselect", args);
-
-    if (!process.waitForStarted()) {
-        return 10000;
-    }
-
-    do {
-        if (!baseObject || QCoreApplication::closingDown()) {
-            process.kill();
-            process.terminate();
-            process.waitForFinished(1000);
-
-            return -1;
-        }
-
-        if (process.waitForFinished(500))
-            break;
-    } while (process.state() == QProcess::Running);
-
-    const QString output = process.readAllStandardOutput().trimmed();
-    const QStringList result = output.split(' ');
-
-    qDebug() << "speed of url" << url << "is" << result.first();
-
-    if (!result.first().isEmpty()) {
-        return result.first().toInt();
-    }
-
-    return 10000;
-}
-
 UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     : QObject(parent)
     , m_model(model)
@@ -91,6 +55,7 @@ UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     , m_checkUpdateJob(nullptr)
     , m_distUpgradeJob(nullptr)
     , m_otherUpdateJob(nullptr)
+    , m_mirrorProber(nullptr)
     , m_onBattery(true)
     , m_batteryPercentage(0.0)
     , m_batterySystemPercentage(0.0)
@@ -100,8 +65,10 @@ UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     , m_downloadProcess(0.0)
     , m_bIsFirstGetDownloadProcess(true)
     , m_downloadSize(0)
+    , m_downloadSizeReady(false)
     , m_iconThemeState("")
     , m_beginUpdatesJob(false)
+    , m_appInfoSerial(0)
 {
 
 }
@@ -199,30 +166,16 @@ void UpdateWorker::init() {
 
 void UpdateWorker::licenseStateChangeSlot()
 {
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>();
-    connect(watcher, &QFutureWatcher<void>::finished, watcher, &QFutureWatcher<void>::deleteLater);
+    // LicenseState 属于主线程，社区版不会创建
+    if (DSysInfo::DeepinDesktop == DSysInfo::deepinType())
+        return;
 
-    QFuture<void> future = QtConcurrent::run(this, &UpdateWorker::getLicenseState);
-    watcher->setFuture(future);
+    QMetaObject::invokeMethod(LicenseState::instance(), &LicenseState::refresh, Qt::QueuedConnection);
 }
 
-void UpdateWorker::getLicenseState()
+void UpdateWorker::onLicenseStateChanged(quint32 state)
 {
-    if (DSysInfo::DeepinDesktop == DSysInfo::deepinType()) {
-        m_model->setSystemActivation(UiActiveState::Authorized);
-        return;
-    }
-    QDBusInterface licenseInfo("com.deepin.license",
-                               "/com/deepin/license/Info",
-                               "com.deepin.license.Info",
-                               QDBusConnection::systemBus());
-    if (!licenseInfo.isValid()) {
-        qDebug() << "com.deepin.license error ," << licenseInfo.lastError().name();
-        return;
-    }
-    UiActiveState reply = static_cast<UiActiveState>(licenseInfo.property("AuthorizationState").toInt());
-    qDebug() << "Authorization State:" << reply;
-    m_model->setSystemActivation(reply);
+    m_model->setSystemActivation(static_cast<UiActiveState>(state));
 }
 
 void UpdateWorker::activate()
@@ -232,7 +185,10 @@ void UpdateWorker::activate()
 #endif
     double interval = 50.0;
     QString checkTime;
-    interval = m_updateInter->GetCheckIntervalAndTime(checkTime);
+    {
+        DBusTelemetry::SyncScope scope("com.deepin.lastore.Updater.GetCheckIntervalAndTime");
+        interval = m_updateInter->GetCheckIntervalAndTime(checkTime);
+    }
     m_model->setLastCheckUpdateTime(checkTime);
     m_model->setAutoCheckUpdateCircle(static_cast<int>(interval));
 
@@ -257,45 +213,19 @@ void UpdateWorker::activate()
     refreshMirrors();
 #endif
 
-    licenseStateChangeSlot();
-
-    QDBusConnection::systemBus().connect("com.deepin.license", "/com/deepin/license/Info",
-                                         "com.deepin.license.Info", "LicenseStateChange",
-                                         this, SLOT(licenseStateChangeSlot()));
-
-    QFutureWatcher<QStringList> *packagesWatcher = new QFutureWatcher<QStringList>();
-    connect(packagesWatcher, &QFutureWatcher<QStringList>::finished, this, [=] {
-        QStringList updatablePackages = std::move(packagesWatcher->result());
-        qDebug() << "UpdatablePackages = " << updatablePackages.count();
-        m_model->isUpdatablePackages(updatablePackages.count() > UPDATE_PACKAGE_SIZE);
-        packagesWatcher->deleteLater();
-    });
-
-    packagesWatcher->setFuture(QtConcurrent::run([=]() -> QStringList {
-        QDBusInterface Interface("com.deepin.lastore", "/com/deepin/lastore",
-                                 "com.deepin.lastore.Updater",
-                                 QDBusConnection::systemBus());
-        if (!Interface.isValid()) {
-            qDebug() << "com.deepin.license error ," << Interface.lastError().name();
-            return {};
-        }
-
-        return Interface.property("UpdatablePackages").toStringList();
-    }));
-
-    QFutureWatcher<QString> *iconWatcher = new QFutureWatcher<QString>();
-    connect(iconWatcher, &QFutureWatcher<QString>::finished, this, [=] {
-        m_iconThemeState = iconWatcher->result();
-        iconWatcher->deleteLater();
-    });
-
-    iconWatcher->setFuture(QtConcurrent::run([=] {
-        bool isSync = m_iconTheme->sync();
-        m_iconTheme->setSync(true);
-        const QString &iconTheme = m_iconTheme->iconTheme();
-        m_iconTheme->setSync(isSync);
-        return iconTheme;
-    }));
+    PropertySnapshot()
+        .add(QDBusConnection::systemBus(), "com.deepin.lastore", "/com/deepin/lastore",
+             "com.deepin.lastore.Updater", {"UpdatablePackages"})
+        .add(m_iconTheme, {"IconTheme"})
+        .fetch(this, [this](const PropertySnapshot &snapshot) {
+            const QStringList updatablePackages = snapshot.value("com.deepin.lastore", "/com/deepin/lastore",
+                                                                 "com.deepin.lastore.Updater", "UpdatablePackages").toStringList();
+            qDebug() << "UpdatablePackages = " << updatablePackages.count();
+            m_model->isUpdatablePackages(updatablePackages.count() > UPDATE_PACKAGE_SIZE);
+
+            if (snapshot.contains(m_iconTheme, "IconTheme"))
+                m_iconThemeState = snapshot.value(m_iconTheme, "IconTheme").toString();
+        });
 }
 
 void UpdateWorker::deactivate()
@@ -364,18 +294,76 @@ void UpdateWorker::distUpgradeInstallUpdates()
     });
 }
 
+void UpdateWorker::refreshAppUpdateInfo()
+{
+    // 新的刷新开始后，之前未完成的结果全部作废
+    const int serial = ++m_appInfoSerial;
+    QDBusPendingCall call = m_updateInter->ApplicationUpdateInfos(QLocale::system().name());
+    DBusTelemetry::instance()->track(call, "com.deepin.lastore.Updater.ApplicationUpdateInfos");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, serial] {
+        watcher->deleteLater();
+        if (serial != m_appInfoSerial)
+            return;
+
+        QDBusPendingReply<AppUpdateInfoList> reply = *watcher;
+        if (reply.isError())
+            qWarning() << "get application update infos failed:" << reply.error().message();
+
+        setAppUpdateInfo(reply.isError() ? AppUpdateInfoList() : reply.value());
+    });
+}
+
 void UpdateWorker::setAppUpdateInfo(const AppUpdateInfoList &list)
 {
-    m_updateInter->setSync(true);
-    m_managerInter->setSync(true);
+    const int serial = ++m_appInfoSerial;
+    m_downloadSizeReady = false;
+    QSharedPointer<PendingAppInfo> pending(new PendingAppInfo);
+    pending->appInfos = list;
+
+    // 可更新应用和可更新包列表一次 GetAll 取回，不再切换为同步模式读取属性
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_updateInter->service(), m_updateInter->path(),
+                                                      "org.freedesktop.DBus.Properties", "GetAll");
+    msg << m_updateInter->interface();
+    QDBusPendingCallWatcher *listWatcher = new QDBusPendingCallWatcher(m_updateInter->connection().asyncCall(msg), this);
+    connect(listWatcher, &QDBusPendingCallWatcher::finished, this, [this, listWatcher, pending, serial] {
+        listWatcher->deleteLater();
+        if (serial != m_appInfoSerial)
+            return;
 
-    m_updatableApps = m_updateInter->updatableApps();
-    m_updatablePackages = m_updateInter->updatablePackages();
+        QDBusPendingReply<QVariantMap> reply = *listWatcher;
+        if (reply.isError()) {
+            qWarning() << "get updatable packages failed:" << reply.error().message();
+        } else {
+            pending->updatableApps = reply.value().value("UpdatableApps").toStringList();
+            pending->updatablePackages = reply.value().value("UpdatablePackages").toStringList();
+        }
+        pending->listsReady = true;
+        if (pending->changeLogReady)
+            mergeAppUpdateInfo(pending);
+    });
 
-    m_updateInter->setSync(false);
-    m_managerInter->setSync(false);
+    // 更新日志文件可能很大，在工作线程中解析
+    QFutureWatcher<ChangeLog> *logWatcher = new QFutureWatcher<ChangeLog>(this);
+    connect(logWatcher, &QFutureWatcher<ChangeLog>::finished, this, [this, logWatcher, pending, serial] {
+        logWatcher->deleteLater();
+        if (serial != m_appInfoSerial)
+            return;
+
+        pending->changeLog = logWatcher->result();
+        pending->changeLogReady = true;
+        if (pending->listsReady)
+            mergeAppUpdateInfo(pending);
+    });
+    logWatcher->setFuture(QtConcurrent::run(&UpdateWorker::loadChangeLog, QLocale::system().name()));
+}
+
+void UpdateWorker::mergeAppUpdateInfo(const QSharedPointer<PendingAppInfo> &pending)
+{
+    m_updatableApps = pending->updatableApps;
+    m_updatablePackages = pending->updatablePackages;
 
-    AppUpdateInfoList value = list;
+    AppUpdateInfoList &value = pending->appInfos;
     AppUpdateInfoList infos;
 
     int pkgCount = m_updatablePackages.count();
@@ -398,7 +386,7 @@ void UpdateWorker::setAppUpdateInfo(const AppUpdateInfoList &list)
     for (AppUpdateInfo &val : value) {
         const QString currentVer = val.m_currentVersion;
         const QString lastVer = val.m_avilableVersion;
-        AppUpdateInfo info = getInfo(val, currentVer, lastVer);
+        AppUpdateInfo info = getInfo(val, currentVer, lastVer, pending->changeLog);
         infos << info;
     }
 
@@ -418,7 +406,7 @@ void UpdateWorker::setAppUpdateInfo(const AppUpdateInfoList &list)
             infos.removeAt(it - infos.constBegin());
         }
 
-        AppUpdateInfo ddeUpdateInfo = getInfo(dde, dde.m_currentVersion, dde.m_avilableVersion);
+        AppUpdateInfo ddeUpdateInfo = getInfo(dde, dde.m_currentVersion, dde.m_avilableVersion, pending->changeLog);
         if (ddeUpdateInfo.m_changelog.isEmpty()) {
             ddeUpdateInfo.m_avilableVersion = tr("Patches");
             ddeUpdateInfo.m_changelog = tr("System patches");
@@ -427,12 +415,45 @@ void UpdateWorker::setAppUpdateInfo(const AppUpdateInfoList &list)
         infos.prepend(ddeUpdateInfo);
     }
     qDebug() << " UpdateWorker::setAppUpdateInfo: infos.count()" << infos.count();
-    DownloadInfo *result = calculateDownloadInfo(infos);
-    m_model->setDownloadInfo(result);
+
+    // 每次刷新只创建一个 DownloadInfo。已经显示过下载信息时先用上次的下载大小刷新列表，
+    // 准确的大小计算完成后原地更新
+    DownloadInfo *info = new DownloadInfo(static_cast<qlonglong>(m_downloadSize), infos);
+    if (m_model->downloadInfo() && m_downloadSize)
+        m_model->setDownloadInfo(info);
+
+    calculateDownloadInfo(info);
+}
+
+void UpdateWorker::setDownloadInfo(DownloadInfo *result)
+{
+    //等待下载大小期间可能已经出错
+    if (m_model->status() == UpdatesStatus::UpdateFailed) {
+        qDebug() << " [UpdateWork] The status is error. Current status : " << m_model->status();
+        if (m_model->downloadInfo() != result)
+            result->deleteLater();
+        return;
+    }
+
+    if (m_model->downloadInfo() != result)
+        m_model->setDownloadInfo(result);
 
     qDebug() << "updatable packages:" <<  m_updatablePackages << result->appInfos();
     qDebug() << "total download size:" << formatCap(result->downloadSize());
     m_downloadSize = result->downloadSize();
+    m_downloadSizeReady = true;
+
+    // 下载或安装任务进行中时状态由任务决定，下载信息只用来刷新列表和进度
+    if (!m_downloadJob.isNull() || !m_distUpgradeJob.isNull()) {
+        onNotifyDownloadInfoChanged();
+        return;
+    }
+
+    const UpdatesStatus status = m_model->status();
+    if (status != UpdatesStatus::Default && status != UpdatesStatus::Checking && status != UpdatesStatus::UpdatesAvailable) {
+        qDebug() << " [UpdateWork] Keep current status : " << status;
+        return;
+    }
 
     qDebug() << "UpdateWorker::setAppUpdateInfo:result->appInfos().length() = " << result->appInfos().length();
     if (result->appInfos().length() == 0) {
@@ -560,7 +581,7 @@ void UpdateWorker::resetDownloadInfo(bool state)
     m_updatableApps.clear();
     m_updatablePackages.clear();
     if (m_updateInter) {
-        setAppUpdateInfo(m_updateInter->ApplicationUpdateInfos(QLocale::system().name()));
+        refreshAppUpdateInfo();
     }
 
     if (!state) {
@@ -704,55 +725,35 @@ void UpdateWorker::setSourceCheck(bool enable)
 
 void UpdateWorker::testMirrorSpeed()
 {
-    QList<MirrorInfo> mirrors = m_model->mirrorInfos();
-
-    QStringList urlList;
-    for (MirrorInfo &info : mirrors) {
-        urlList << info.m_url;
+    // 有效期内的测速结果直接复用，只探测没有结果或已过期的镜像
+    const qint64 ttl = valueByQSettings<int>(DCC_CONFIG_FILES, "MirrorProbe", "cacheTtl", 600) * 1000LL;
+    const QMap<QString, int> cached = m_model->cachedMirrorSpeed(ttl);
+
+    QMap<QString, QString> urls;
+    for (const MirrorInfo &info : m_model->mirrorInfos()) {
+        if (!cached.contains(info.m_id))
+            urls.insert(info.m_id, info.m_url);
     }
 
     // reset the data;
-    m_model->setMirrorSpeedInfo(QMap<QString, int>());
-
-    QFutureWatcher<int> *watcher = new QFutureWatcher<int>();
-    connect(watcher, &QFutureWatcher<int>::resultReadyAt, [this, urlList, watcher, mirrors](int index) {
-        QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
-
-        int result = watcher->resultAt(index);
-        QString mirrorId = mirrors.at(index).m_id;
-        speedInfo[mirrorId] = result;
+    m_model->setMirrorSpeedInfo(cached);
+    if (urls.isEmpty())
+        return;
 
-        m_model->setMirrorSpeedInfo(speedInfo);
-    });
+    if (!m_mirrorProber) {
+        m_mirrorProber = new MirrorProber(this);
+        m_mirrorProber->setConcurrency(valueByQSettings<int>(DCC_CONFIG_FILES, "MirrorProbe", "concurrency", 8));
+        m_mirrorProber->setTimeout(valueByQSettings<int>(DCC_CONFIG_FILES, "MirrorProbe", "timeout", 3000));
+        connect(m_mirrorProber, &MirrorProber::probed, m_model, &UpdateModel::updateMirrorSpeed);
+    }
 
-    QPointer<QObject> guest(this);
-    QFuture<int> future = QtConcurrent::mapped(urlList, std::bind(TestMirrorSpeedInternal, std::placeholders::_1, guest));
-    watcher->setFuture(future);
+    m_mirrorProber->probe(urls);
 }
 
 void UpdateWorker::checkNetselect()
 {
-    QProcess *process = new QProcess;
-    process->start("netselect", QStringList() << "127.0.0.1");
-    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
-        if ((error == QProcess::FailedToStart) || (error == QProcess::Crashed)) {
-            m_model->setNetselectExist(false);
-            process->deleteLater();
-        }
-    });
-    connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished), this, [this, process](int result) {
-        bool isNetselectExist = false;
-        if (result == 0) {
-            isNetselectExist = true;
-        } else {
-            isNetselectExist = false;
-        }
-        if (!isNetselectExist) {
-            qDebug() << "[wubw UpdateWorker] netselect 127.0.0.1 : " << isNetselectExist;
-        }
-        m_model->setNetselectExist(isNetselectExist);
-        process->deleteLater();
-    });
+    // 测速已在进程内完成，不再依赖 netselect
+    m_model->setNetselectExist(true);
 }
 
 void UpdateWorker::setSmartMirror(bool enable)
@@ -856,7 +857,9 @@ void UpdateWorker::setCheckUpdatesJob(const QString &jobPath)
 
     const CheckUpdateJobRet& ret = createCheckUpdateJob(jobPath);
     if (ret.status == "succeed") {
-        QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(m_updateInter->ApplicationUpdateInfos(QLocale::system().name()), this);
+        QDBusPendingCall call = m_updateInter->ApplicationUpdateInfos(QLocale::system().name());
+        DBusTelemetry::instance()->track(call, "com.deepin.lastore.Updater.ApplicationUpdateInfos");
+        QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(call, this);
         connect(w, &QDBusPendingCallWatcher::finished, this, &UpdateWorker::onAppUpdateInfoFinished);
     } else {
         m_managerInter->CleanJob(ret.jobID);
@@ -871,7 +874,7 @@ void UpdateWorker::setDownloadJob(const QString &jobPath)
     if (!m_downloadJob.isNull())
         return;
 
-    setAppUpdateInfo(m_updateInter->ApplicationUpdateInfos(QLocale::system().name()));
+    refreshAppUpdateInfo();
 
     m_downloadJob = new JobInter("com.deepin.lastore",
                                  jobPath,
@@ -899,7 +902,8 @@ void UpdateWorker::setDownloadJob(const QString &jobPath)
                     onNotifyStatusChanged(UpdatesStatus::DownloadPaused);
                 }
             } else {
-                if (m_downloadSize > 0) {
+                // 下载大小还没有返回时也以任务进度为准
+                if (m_downloadSize > 0 || !m_downloadSizeReady) {
                     m_model->setStatus(UpdatesStatus::Downloading, __LINE__);
                 } else {
                     qDebug() << " m_downloadSize is 0 : do nothing.";
@@ -924,7 +928,7 @@ void UpdateWorker::setDistUpgradeJob(const QString &jobPath)
     if (!m_distUpgradeJob.isNull())
         return;
 
-    setAppUpdateInfo(m_updateInter->ApplicationUpdateInfos(QLocale::system().name()));
+    refreshAppUpdateInfo();
 
     m_distUpgradeJob = new JobInter("com.deepin.lastore",
                                     jobPath,
@@ -1106,15 +1110,57 @@ void UpdateWorker::checkDiskSpace(const QString &jobDescription)
     }
 }
 
-DownloadInfo *UpdateWorker::calculateDownloadInfo(const AppUpdateInfoList &list)
+void UpdateWorker::calculateDownloadInfo(DownloadInfo *info)
 {
-    const qlonglong size = m_managerInter->PackagesDownloadSize(m_updatablePackages);
+    const int serial = m_appInfoSerial;
+    QPointer<DownloadInfo> pendingInfo(info);
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_managerInter->PackagesDownloadSize(m_updatablePackages), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, pendingInfo, serial] {
+        watcher->deleteLater();
+        if (pendingInfo.isNull())
+            return;
 
-    DownloadInfo *ret = new DownloadInfo(size, list);
-    return ret;
+        if (serial != m_appInfoSerial) {
+            // 未发布给 model 的下载信息由这里释放
+            if (m_model->downloadInfo() != pendingInfo)
+                pendingInfo->deleteLater();
+            return;
+        }
+
+        QDBusPendingReply<qlonglong> reply = *watcher;
+        if (reply.isError())
+            qWarning() << "get packages download size failed:" << reply.error().message();
+
+        pendingInfo->setDownloadSize(reply.isError() ? 0 : reply.value());
+        setDownloadInfo(pendingInfo);
+    });
+}
+
+UpdateWorker::ChangeLog UpdateWorker::loadChangeLog(const QString &language)
+{
+    ChangeLog changeLog;
+    QFile logFile(ChangeLogFile);
+    if (!logFile.open(QFile::ReadOnly)) {
+        qDebug() << "can not find update file:" << ChangeLogFile;
+        return changeLog;
+    }
+
+    changeLog.valid = true;
+    const QJsonObject &object = QJsonDocument::fromJson(logFile.readAll()).object();
+    const QJsonObject &systemInfo = object.value("systemInfo").toObject();
+    changeLog.systemLog = systemInfo.value(language).toString();
+    changeLog.systemVersion = systemInfo.value("update_time").toString();
+
+    const QJsonArray &apps = object.value("appInfo").toArray();
+    for (auto itApp = apps.begin(); itApp != apps.end(); ++itApp) {
+        const QJsonObject &app = itApp->toObject();
+        changeLog.appLogs.insert(app.value("package_id").toString(), app.value(language).toString());
+    }
+
+    return changeLog;
 }
 
-AppUpdateInfo UpdateWorker::getInfo(const AppUpdateInfo &packageInfo, const QString &currentVersion, const QString &lastVersion) const
+AppUpdateInfo UpdateWorker::getInfo(const AppUpdateInfo &packageInfo, const QString &currentVersion, const QString &lastVersion, const ChangeLog &changeLog) const
 {
     AppUpdateInfo info;
     info.m_packageId = packageInfo.m_packageId;
@@ -1123,25 +1169,14 @@ AppUpdateInfo UpdateWorker::getInfo(const AppUpdateInfo &packageInfo, const QStr
     info.m_avilableVersion = lastVersion;
     info.m_icon = m_iconThemeState;
 
-    const QString &language = QLocale::system().name();
-    QFile logFile(ChangeLogFile);
-    if (!logFile.open(QFile::ReadOnly)) {
-        qDebug() << "can not find update file:" << ChangeLogFile;
+    if (!changeLog.valid)
         return info;
-    }
-
-    const QJsonObject &object = QJsonDocument::fromJson(logFile.readAll()).object();
 
     if (info.m_packageId == DDEId) {
-        info.m_changelog = object.value("systemInfo").toObject().value(language).toString();
-        info.m_avilableVersion = object.value("systemInfo").toObject().value("update_time").toString();
+        info.m_changelog = changeLog.systemLog;
+        info.m_avilableVersion = changeLog.systemVersion;
     } else {
-        const QJsonArray &apps = object.value("appInfo").toArray();
-        for (auto itApp = apps.begin(); itApp != apps.end(); ++itApp) {
-            if (itApp->toObject().value("package_id").toString() == info.m_packageId) {
-                info.m_changelog = itApp->toObject().value(language).toString();
-            }
-        }
+        info.m_changelog = changeLog.appLogs.value(info.m_packageId);
     }
 
     return info;
@@ -1173,14 +1208,28 @@ void UpdateWorker::setOnBattery(bool onBattery)
 void UpdateWorker::refreshHistoryAppsInfo()
 {
     //m_model->setHistoryAppInfos(m_updateInter->getHistoryAppsInfo());
-    m_model->setHistoryAppInfos(m_updateInter->ApplicationUpdateInfos(QLocale::system().name()));
+    QDBusPendingCall call = m_updateInter->ApplicationUpdateInfos(QLocale::system().name());
+    DBusTelemetry::instance()->track(call, "com.deepin.lastore.Updater.ApplicationUpdateInfos");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher] {
+        QDBusPendingReply<AppUpdateInfoList> reply = *watcher;
+        if (reply.isError()) {
+            qWarning() << "get history app infos failed:" << reply.error().message();
+        } else {
+            m_model->setHistoryAppInfos(reply.value());
+        }
+        watcher->deleteLater();
+    });
 }
 
 void UpdateWorker::refreshLastTimeAndCheckCircle()
 {
     double interval = 50.0;
     QString checkTime;
-    interval = m_updateInter->GetCheckIntervalAndTime(checkTime);
+    {
+        DBusTelemetry::SyncScope scope("com.deepin.lastore.Updater.GetCheckIntervalAndTime");
+        interval = m_updateInter->GetCheckIntervalAndTime(checkTime);
+    }
 
     m_model->setAutoCheckUpdateCircle(static_cast<int>(interval));
     m_model->setLastCheckUpdateTime(checkTime);
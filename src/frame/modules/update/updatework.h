@@ -29,6 +29,8 @@
 #include "updatemodel.h"
 
 #include <QObject>
+#include <QHash>
+#include <QSharedPointer>
 #include <com_deepin_lastore_updater.h>
 #include <com_deepin_lastore_job.h>
 #include <com_deepin_lastore_jobmanager.h>
@@ -61,6 +63,8 @@ struct CheckUpdateJobRet {
     QString jobDescription;
 };
 
+class MirrorProber;
+
 class UpdateWorker : public QObject
 {
     Q_OBJECT
@@ -72,7 +76,6 @@ public:
     void setOnBattery(bool onBattery);
     void setBatteryPercentage(const BatteryPercentageInfo &info);
     void setSystemBatteryPercentage(const double &value);
-    void getLicenseState();
 
 Q_SIGNALS:
     void requestInit();
@@ -108,6 +111,7 @@ public Q_SLOTS:
     void recoveryStartRestore();
     void onNotifyDownloadInfoChanged();
     void licenseStateChangeSlot();
+    void onLicenseStateChanged(quint32 state);
     void refreshHistoryAppsInfo();
     void refreshLastTimeAndCheckCircle();
     void setUpdateNotify(const bool notify);
@@ -120,11 +124,32 @@ private Q_SLOTS:
     void onDownloadStatusChanged(const QString &status);
     void onUpgradeStatusChanged(const QString &status);
     void checkDiskSpace(const QString &jobDescription);
-    DownloadInfo *calculateDownloadInfo(const AppUpdateInfoList &list);
     void onIconThemeChanged(const QString &theme);
 
 private:
-    AppUpdateInfo getInfo(const AppUpdateInfo &packageInfo, const QString& currentVersion, const QString& lastVersion) const;
+    // 更新日志中的系统更新说明和各应用的更新说明
+    struct ChangeLog {
+        QString systemLog;
+        QString systemVersion;
+        QHash<QString, QString> appLogs;
+        bool valid = false;
+    };
+    // 一次下载信息刷新的中间结果，可更新列表和更新日志并行获取，都到达后再合并
+    struct PendingAppInfo {
+        AppUpdateInfoList appInfos;
+        QStringList updatableApps;
+        QStringList updatablePackages;
+        ChangeLog changeLog;
+        bool listsReady = false;
+        bool changeLogReady = false;
+    };
+
+    static ChangeLog loadChangeLog(const QString &language);
+    AppUpdateInfo getInfo(const AppUpdateInfo &packageInfo, const QString& currentVersion, const QString& lastVersion, const ChangeLog &changeLog) const;
+    void mergeAppUpdateInfo(const QSharedPointer<PendingAppInfo> &pending);
+    void calculateDownloadInfo(DownloadInfo *info);
+    void setDownloadInfo(DownloadInfo *result);
+    void refreshAppUpdateInfo();
     void distUpgradeDownloadUpdates();
     void distUpgradeInstallUpdates();
     void setAppUpdateInfo(const AppUpdateInfoList &list);
@@ -150,6 +175,7 @@ private:
     SmartMirrorInter *m_smartMirrorInter;
     RecoveryInter *m_abRecoveryInter;
     Appearance *m_iconTheme;
+    MirrorProber *m_mirrorProber;
     bool m_onBattery;
     double m_batteryPercentage;
     double m_batterySystemPercentage;
@@ -161,8 +187,12 @@ private:
     double m_downloadProcess;
     bool m_bIsFirstGetDownloadProcess;
     qulonglong m_downloadSize;
+    // 本次刷新的下载大小是否已经返回
+    bool m_downloadSizeReady;
     QString m_iconThemeState;
     bool m_beginUpdatesJob;
+    // 每次刷新下载信息递增，用于丢弃过期的异步结果
+    int m_appInfoSerial;
 };
 }
 }
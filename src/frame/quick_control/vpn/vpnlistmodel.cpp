@@ -30,6 +30,7 @@
 #include <QDebug>
 #include <QSize>
 #include <QJsonObject>
+#include <QSet>
 #include <networkmodel.h>
 
 using dde::network::NetworkModel;
@@ -46,9 +47,13 @@ VpnListModel::VpnListModel(NetworkModel *model, QObject *parent)
 
     connect(m_refreshTimer, &QTimer::timeout, this, &VpnListModel::refreshActivedIndex);
     connect(m_networkModel, &NetworkModel::activeConnInfoChanged, this, &VpnListModel::onActiveConnInfoChanged);
-    connect(m_networkModel, &NetworkModel::connectionListChanged, [this] { emit layoutChanged(); });
+    connect(m_networkModel, &NetworkModel::connectionListChanged, [this] {
+        refreshVpnRows();
+        emit layoutChanged();
+    });
     connect(m_networkModel, &NetworkModel::vpnEnabledChanged, [this] { emit layoutChanged(); });
 
+    refreshVpnRows();
     onActiveConnInfoChanged(m_networkModel->activeConnInfos());
 }
 
@@ -88,28 +93,15 @@ QVariant VpnListModel::data(const QModelIndex &index, int role) const
 
 void VpnListModel::refreshActivedIndex()
 {
-    const auto vpns = m_networkModel->vpns();
-
-    auto vpnIndex = [&](const QString &uuid)
+    for (auto it = m_activeVpnStates.constBegin(); it != m_activeVpnStates.constEnd(); ++it)
     {
-        for (int i(0); i != vpns.size(); ++i)
-            if (vpns[i].value("Uuid").toString() == uuid)
-                return index(i, 0);
-        return QModelIndex();
-    };
-
-    for (const auto &info : m_activeVpns)
-    {
-        if (info.value("State").toInt() == 2)
+        if (it.value() == 2)
             continue;
 
-        const QString &connUuid = info.value("Uuid").toString();
-        const auto idx = vpnIndex(connUuid);
-
-        emit dataChanged(idx, idx);
+        const QModelIndex idx = vpnIndex(it.key());
+        if (idx.isValid())
+            emit dataChanged(idx, idx);
     }
-
-    emit layoutChanged();
 }
 
 void VpnListModel::setHoveredIndex(const QModelIndex &index)
@@ -124,7 +116,7 @@ void VpnListModel::setHoveredIndex(const QModelIndex &index)
 
 void VpnListModel::onActiveConnInfoChanged(const QList<QJsonObject> &infoList)
 {
-    m_activeVpns.clear();
+    QHash<QString, int> states;
     for (const auto &info : infoList)
     {
         const QString &type = info.value("ConnectionType").toString();
@@ -132,42 +124,67 @@ void VpnListModel::onActiveConnInfoChanged(const QList<QJsonObject> &infoList)
             continue;
 
         const QString &uuid = info.value("ConnectionUuid").toString();
-        m_activeVpns << m_networkModel->activeConnObjectByUuid(uuid);
+        states.insert(uuid, m_networkModel->activeConnObjectByUuid(uuid).value("State").toInt());
     }
 
+    // 只通知状态发生变化的行
+    QSet<QString> changed;
+    for (auto it = states.constBegin(); it != states.constEnd(); ++it)
+        if (m_activeVpnStates.value(it.key(), -1) != it.value())
+            changed.insert(it.key());
+    for (auto it = m_activeVpnStates.constBegin(); it != m_activeVpnStates.constEnd(); ++it)
+        if (!states.contains(it.key()))
+            changed.insert(it.key());
+
+    m_activeVpnStates = states;
+
     if (needRefresh())
         m_refreshTimer->start();
     else
         m_refreshTimer->stop();
 
-    emit layoutChanged();
+    for (const QString &uuid : changed)
+    {
+        const QModelIndex idx = vpnIndex(uuid);
+        if (idx.isValid())
+            emit dataChanged(idx, idx);
+    }
 }
 
 bool VpnListModel::needRefresh() const
 {
-    for (const auto &info : m_activeVpns)
+    for (int state : m_activeVpnStates)
     {
-        if (info.value("State").toInt() != 2)
+        if (state != 2)
             return true;
     }
 
     return false;
 }
 
-VpnListModel::VpnState VpnListModel::vpnState(const QString &uuid) const
+void VpnListModel::refreshVpnRows()
 {
-    if (!m_networkModel->activeConnections().contains(uuid))
-        return VpnState::NotActive;
+    m_vpnRows.clear();
 
-    for (const auto &info : m_activeVpns)
-    {
-        const QString &connUuid = info.value("Uuid").toString();
-        if (connUuid != uuid)
-            continue;
+    const auto vpns = m_networkModel->vpns();
+    for (int i(0); i != vpns.size(); ++i)
+        m_vpnRows.insert(vpns[i].value("Uuid").toString(), i);
+}
 
-        const int state = info.value("State").toInt();
-        return state == 2 ? VpnListModel::Actived : VpnListModel::Activing;
-    }
+QModelIndex VpnListModel::vpnIndex(const QString &uuid) const
+{
+    auto it = m_vpnRows.constFind(uuid);
+    if (it == m_vpnRows.constEnd() || !m_networkModel->vpnEnabled())
+        return QModelIndex();
+
+    return index(it.value(), 0);
+}
+
+VpnListModel::VpnState VpnListModel::vpnState(const QString &uuid) const
+{
+    auto it = m_activeVpnStates.constFind(uuid);
+    if (it == m_activeVpnStates.constEnd())
+        return VpnState::NotActive;
 
-    return VpnState::NotActive;
+    return it.value() == 2 ? VpnListModel::Actived : VpnListModel::Activing;
 }
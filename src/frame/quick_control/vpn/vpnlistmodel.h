@@ -29,6 +29,7 @@
 #include <QAbstractListModel>
 #include <QPixmap>
 #include <QJsonObject>
+#include <QHash>
 
 namespace dde {
 namespace network {
@@ -73,6 +74,8 @@ public slots:
 
 private:
     bool needRefresh() const;
+    void refreshVpnRows();
+    QModelIndex vpnIndex(const QString &uuid) const;
 
 private:
     VpnState vpnState(const QString &uuid) const;
@@ -82,7 +85,9 @@ private:
     const QPixmap m_cancelPixmap;
     QModelIndex m_hoveredIndex;
 
-    QList<QJsonObject> m_activeVpns;
+    // 以 UUID 为键的激活状态和行号
+    QHash<QString, int> m_activeVpnStates;
+    QHash<QString, int> m_vpnRows;
 
     dde::network::NetworkModel *m_networkModel;
     QTimer *m_refreshTimer;
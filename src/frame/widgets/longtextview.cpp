@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "widgets/longtextview.h"
+
+#include <QClipboard>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QStyle>
+#include <QTextLayout>
+#include <QTimer>
+#include <QtMath>
+
+#include <algorithm>
+
+namespace dcc {
+namespace widgets {
+
+// 空闲排版每批占用主线程的时间上限
+static const int IdleLayoutBudgetMs = 8;
+// 最多缓存多少种宽度下的段落高度
+static const int MaxCachedWidths = 16;
+
+LongTextView::LongTextView(QWidget *parent)
+    : QWidget(parent)
+    , m_layoutWidth(0)
+    , m_idleTimer(new QTimer(this))
+    , m_nextPending(0)
+    , m_selectionStart(0)
+    , m_selectionEnd(0)
+    , m_selectionAnchor(0)
+    , m_selecting(false)
+{
+    QSizePolicy policy(QSizePolicy::Preferred, QSizePolicy::Preferred);
+    policy.setHeightForWidth(true);
+    setSizePolicy(policy);
+    setFocusPolicy(Qt::ClickFocus);
+    setCursor(Qt::IBeamCursor);
+
+    m_idleTimer->setSingleShot(true);
+    m_idleTimer->setInterval(0);
+    connect(m_idleTimer, &QTimer::timeout, this, &LongTextView::layoutPending);
+}
+
+LongTextView::~LongTextView()
+{
+}
+
+void LongTextView::setText(const QString &text)
+{
+    if (m_text == text)
+        return;
+
+    m_text = text;
+    m_paragraphs.clear();
+    m_heightCache.clear();
+    m_selectionStart = m_selectionEnd = m_selectionAnchor = 0;
+
+    int start = 0;
+    while (!m_text.isEmpty() && start <= m_text.size()) {
+        int end = m_text.indexOf('\n', start);
+        if (end < 0)
+            end = m_text.size();
+
+        Paragraph paragraph { start, end - start, 0, 0 };
+        if (paragraph.length > 0 && m_text.at(end - 1) == '\r')
+            --paragraph.length;
+        for (int i = start; i < start + paragraph.length; ++i) {
+            if (m_text.at(i).unicode() >= 0x2E80)
+                ++paragraph.wideCount;
+            else
+                ++paragraph.narrowCount;
+        }
+
+        m_paragraphs << paragraph;
+        start = end + 1;
+    }
+
+    resetLayouts();
+    updateGeometry();
+    update();
+}
+
+QString LongTextView::selectedText() const
+{
+    return m_text.mid(m_selectionStart, m_selectionEnd - m_selectionStart);
+}
+
+void LongTextView::selectAll()
+{
+    setSelection(0, m_text.size());
+}
+
+void LongTextView::copy() const
+{
+    if (hasSelectedText())
+        QGuiApplication::clipboard()->setText(selectedText());
+}
+
+int LongTextView::heightForWidth(int width) const
+{
+    const QMargins margins = contentsMargins();
+    const int tw = textWidth(width);
+    if (tw == m_layoutWidth && !m_offsets.isEmpty())
+        return m_offsets.last() + margins.top() + margins.bottom();
+
+    int height = 0;
+    for (int i = 0; i < m_paragraphs.size(); ++i)
+        height += paragraphHeight(i, tw);
+
+    return height + margins.top() + margins.bottom();
+}
+
+QSize LongTextView::sizeHint() const
+{
+    const int width = fontMetrics().averageCharWidth() * 80;
+    return QSize(width, heightForWidth(width));
+}
+
+QSize LongTextView::minimumSizeHint() const
+{
+    return QSize(fontMetrics().averageCharWidth() * 10, fontMetrics().lineSpacing());
+}
+
+void LongTextView::paintEvent(QPaintEvent *event)
+{
+    if (m_paragraphs.isEmpty())
+        return;
+
+    const QRect cr = contentsRect();
+    const QRect rect = event->rect();
+    // 上下各多排版一屏，滚动时新露出的段落大多已经排好
+    const int margin = qMax(rect.height(), visibleRegion().boundingRect().height());
+    layoutRange(rect.top() - cr.top() - margin, rect.bottom() - cr.top() + margin);
+
+    QPainter painter(this);
+    painter.setPen(palette().color(foregroundRole()));
+
+    bool changed = false;
+    QVector<QTextLayout::FormatRange> selections;
+    for (int i = paragraphAt(rect.top() - cr.top()); i < m_paragraphs.size() && cr.top() + m_offsets.at(i) <= rect.bottom(); ++i) {
+        const Paragraph &paragraph = m_paragraphs.at(i);
+
+        selections.clear();
+        const int from = qMax(m_selectionStart, paragraph.start);
+        const int to = qMin(m_selectionEnd, paragraph.start + paragraph.length);
+        if (from < to) {
+            QTextLayout::FormatRange range;
+            range.start = from - paragraph.start;
+            range.length = to - from;
+            range.format.setBackground(palette().brush(QPalette::Highlight));
+            range.format.setForeground(palette().brush(QPalette::HighlightedText));
+            selections << range;
+        }
+
+        bool heightChanged = false;
+        ensureLayout(i, &heightChanged)->draw(&painter, QPointF(cr.left(), cr.top() + m_offsets.at(i)), selections);
+        changed |= heightChanged;
+    }
+
+    // 预排版之后偏移有变化时，个别段落可能仍按估算位置绘制，重绘一次修正
+    if (changed) {
+        updateOffsets();
+        updateGeometry();
+        update();
+    }
+}
+
+void LongTextView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+
+    if (textWidth(width()) != m_layoutWidth)
+        resetLayouts();
+}
+
+void LongTextView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    if (m_nextPending < m_paragraphs.size())
+        m_idleTimer->start();
+}
+
+void LongTextView::changeEvent(QEvent *event)
+{
+    QWidget::changeEvent(event);
+
+    switch (event->type()) {
+    case QEvent::FontChange:
+        m_heightCache.clear();
+        resetLayouts();
+        updateGeometry();
+        update();
+        break;
+    case QEvent::LayoutDirectionChange:
+        resetLayouts();
+        update();
+        break;
+    default:
+        break;
+    }
+}
+
+void LongTextView::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+        return QWidget::mousePressEvent(event);
+
+    m_selectionAnchor = positionAt(event->pos());
+    m_selecting = true;
+    setSelection(m_selectionAnchor, m_selectionAnchor);
+}
+
+void LongTextView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!m_selecting || !(event->buttons() & Qt::LeftButton))
+        return QWidget::mouseMoveEvent(event);
+
+    const int pos = positionAt(event->pos());
+    setSelection(qMin(m_selectionAnchor, pos), qMax(m_selectionAnchor, pos));
+}
+
+void LongTextView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || !m_selecting)
+        return QWidget::mouseReleaseEvent(event);
+
+    m_selecting = false;
+    QClipboard *clipboard = QGuiApplication::clipboard();
+    if (hasSelectedText() && clipboard->supportsSelection())
+        clipboard->setText(selectedText(), QClipboard::Selection);
+}
+
+void LongTextView::keyPressEvent(QKeyEvent *event)
+{
+    if (event->matches(QKeySequence::Copy)) {
+        copy();
+    } else if (event->matches(QKeySequence::SelectAll)) {
+        selectAll();
+    } else {
+        QWidget::keyPressEvent(event);
+    }
+}
+
+int LongTextView::textWidth(int width) const
+{
+    const QMargins margins = contentsMargins();
+    return qMax(1, width - margins.left() - margins.right());
+}
+
+int LongTextView::estimatedHeight(const Paragraph &paragraph, int textWidth) const
+{
+    const QFontMetrics fm = fontMetrics();
+    // 宽字符按字号高度估算，误差在排版后修正
+    const int advance = paragraph.narrowCount * fm.averageCharWidth() + paragraph.wideCount * fm.height();
+    const int lines = qMax(1, (advance + textWidth - 1) / textWidth);
+    return lines * fm.lineSpacing();
+}
+
+int LongTextView::paragraphHeight(int index, int textWidth) const
+{
+    auto it = m_heightCache.constFind(textWidth);
+    if (it != m_heightCache.constEnd() && it->at(index) >= 0)
+        return it->at(index);
+
+    return estimatedHeight(m_paragraphs.at(index), textWidth);
+}
+
+void LongTextView::updateOffsets()
+{
+    m_offsets.resize(m_paragraphs.size() + 1);
+    m_offsets[0] = 0;
+    for (int i = 0; i < m_paragraphs.size(); ++i)
+        m_offsets[i + 1] = m_offsets.at(i) + paragraphHeight(i, m_layoutWidth);
+}
+
+QTextLayout *LongTextView::ensureLayout(int index, bool *heightChanged)
+{
+    if (heightChanged)
+        *heightChanged = false;
+
+    QSharedPointer<QTextLayout> &layout = m_layouts[index];
+    if (layout)
+        return layout.data();
+
+    const Paragraph &paragraph = m_paragraphs.at(index);
+    layout.reset(new QTextLayout(m_text.mid(paragraph.start, paragraph.length), font()));
+
+    QTextOption option(QStyle::visualAlignment(layoutDirection(), Qt::AlignLeft));
+    option.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+    option.setTextDirection(layoutDirection());
+    layout->setTextOption(option);
+    layout->setCacheEnabled(true);
+
+    qreal y = 0;
+    layout->beginLayout();
+    for (QTextLine line = layout->createLine(); line.isValid(); line = layout->createLine()) {
+        line.setLineWidth(m_layoutWidth);
+        line.setPosition(QPointF(0, y));
+        y += line.height();
+    }
+    layout->endLayout();
+
+    const int height = qMax(qCeil(y), fontMetrics().lineSpacing());
+    QVector<int> &heights = m_heightCache[m_layoutWidth];
+    if (heights.size() != m_paragraphs.size())
+        heights.fill(-1, m_paragraphs.size());
+    heights[index] = height;
+
+    if (heightChanged)
+        *heightChanged = m_offsets.at(index + 1) - m_offsets.at(index) != height;
+
+    return layout.data();
+}
+
+void LongTextView::layoutRange(int top, int bottom)
+{
+    bool changed = false;
+    for (int i = paragraphAt(top); i < m_paragraphs.size() && m_offsets.at(i) <= bottom; ++i) {
+        bool heightChanged = false;
+        ensureLayout(i, &heightChanged);
+        changed |= heightChanged;
+    }
+
+    if (changed) {
+        updateOffsets();
+        updateGeometry();
+    }
+}
+
+void LongTextView::layoutPending()
+{
+    if (!isVisible())
+        return;
+
+    // 只为求得准确高度，排版结果不保留，可见段落在绘制时再排版
+    QElapsedTimer timer;
+    timer.start();
+    bool changed = false;
+    while (m_nextPending < m_paragraphs.size() && timer.elapsed() < IdleLayoutBudgetMs) {
+        const int index = m_nextPending++;
+        auto it = m_heightCache.constFind(m_layoutWidth);
+        if (m_layouts.at(index) || (it != m_heightCache.constEnd() && it->at(index) >= 0))
+            continue;
+
+        bool heightChanged = false;
+        ensureLayout(index, &heightChanged);
+        m_layouts[index].reset();
+        changed |= heightChanged;
+    }
+
+    if (changed) {
+        updateOffsets();
+        updateGeometry();
+        update();
+    }
+
+    if (m_nextPending < m_paragraphs.size())
+        m_idleTimer->start();
+}
+
+void LongTextView::resetLayouts()
+{
+    m_layoutWidth = textWidth(width());
+    m_layouts.clear();
+    m_layouts.resize(m_paragraphs.size());
+
+    if (m_heightCache.size() > MaxCachedWidths) {
+        const QVector<int> current = m_heightCache.value(m_layoutWidth);
+        m_heightCache.clear();
+        if (!current.isEmpty())
+            m_heightCache.insert(m_layoutWidth, current);
+    }
+
+    updateOffsets();
+
+    m_nextPending = 0;
+    if (isVisible())
+        m_idleTimer->start();
+}
+
+int LongTextView::paragraphAt(int y) const
+{
+    if (m_paragraphs.isEmpty())
+        return 0;
+
+    // m_offsets 单调递增，第一个大于 y 的偏移的前一项即为所在段落
+    const auto it = std::upper_bound(m_offsets.constBegin(), m_offsets.constEnd() - 1, y);
+    return qBound(0, static_cast<int>(it - m_offsets.constBegin()) - 1, m_paragraphs.size() - 1);
+}
+
+int LongTextView::positionAt(const QPoint &pos)
+{
+    if (m_paragraphs.isEmpty())
+        return 0;
+
+    const QRect cr = contentsRect();
+    const int y = pos.y() - cr.top();
+    if (y < 0)
+        return 0;
+    if (y >= m_offsets.last())
+        return m_text.size();
+
+    const int index = paragraphAt(y);
+    bool heightChanged = false;
+    QTextLayout *layout = ensureLayout(index, &heightChanged);
+    if (heightChanged) {
+        updateOffsets();
+        updateGeometry();
+    }
+
+    const Paragraph &paragraph = m_paragraphs.at(index);
+    const qreal localY = y - m_offsets.at(index);
+    QTextLine line = layout->lineAt(layout->lineCount() - 1);
+    for (int i = 0; i < layout->lineCount(); ++i) {
+        const QTextLine candidate = layout->lineAt(i);
+        if (localY < candidate.y() + candidate.height()) {
+            line = candidate;
+            break;
+        }
+    }
+
+    if (!line.isValid())
+        return paragraph.start;
+
+    return paragraph.start + line.xToCursor(pos.x() - cr.left());
+}
+
+void LongTextView::setSelection(int start, int end)
+{
+    if (m_selectionStart == start && m_selectionEnd == end)
+        return;
+
+    m_selectionStart = start;
+    m_selectionEnd = end;
+    update();
+}
+
+} // namespace widgets
+} // namespace dcc
@@ -41,10 +41,13 @@
 #include "widgets/multiselectlistview.h"
 #include "mainwindow.h"
 #include "insertplugin.h"
+#include "modulepreinitializer.h"
+#include "pagecache.h"
 #include "constant.h"
 #include "search/searchwidget.h"
 #include "dtitlebar.h"
 #include "utils.h"
+#include "widgets/utils.h"
 #include "interface/moduleinterface.h"
 
 #include <DBackgroundGroup>
@@ -108,6 +111,9 @@ MainWindow::MainWindow(QWidget *parent)
     , m_firstCount(-1)
     , m_widgetName("")
     , m_backwardBtn(nullptr)
+    , m_preInitializer(new ModulePreInitializer(this))
+    , m_pageCache(new PageCache(valueByQSettings<int>(DCC_CONFIG_FILES, "PageCache", "maxPages", 4),
+                                valueByQSettings<int>(DCC_CONFIG_FILES, "PageCache", "maxWidgets", 2000), this))
 {
     //Initialize view and layout structure
     DMainWindow::installEventFilter(this);
@@ -423,9 +429,6 @@ void MainWindow::initAllModule(const QString &m)
     resetNavList(isIcon);
 
     modulePreInitialize(m);
-    //设置 触控板，指点杆 是否存在
-    m_searchWidget->setRemoveableDeviceStatus(tr("Touchpad"), getRemoveableDeviceStatus(tr("Touchpad")));
-    m_searchWidget->setRemoveableDeviceStatus(tr("TrackPoint"), getRemoveableDeviceStatus(tr("TrackPoint")));
 
     QElapsedTimer et;
     et.start();
@@ -457,16 +460,20 @@ void MainWindow::updateModuleVisible()
 
 void MainWindow::modulePreInitialize(const QString &m)
 {
-    for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it) {
-        QElapsedTimer et;
-        et.start();
-        it->first->preInitialize(m == it->first->name());
-        qDebug() << QString("initialize %1 module using time: %2ms")
-                 .arg(it->first->name())
-                 .arg(et.elapsed());
-
-        setModuleVisible(it->first, it->first->isAvailable());
-    }
+    connect(m_preInitializer, &ModulePreInitializer::modulePreInitialized, this, [this](ModuleInterface *inter) {
+        setModuleVisible(inter, inter->isAvailable());
+
+        // 鼠标模块的初始化可能被推迟，完成后再设置 触控板，指点杆 是否存在
+        if (inter->name() == "mouse") {
+            m_searchWidget->setRemoveableDeviceStatus(tr("Touchpad"), getRemoveableDeviceStatus(tr("Touchpad")));
+            m_searchWidget->setRemoveableDeviceStatus(tr("TrackPoint"), getRemoveableDeviceStatus(tr("TrackPoint")));
+        }
+    });
+
+    QList<ModuleInterface *> modules;
+    for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it)
+        modules << it->first;
+    m_preInitializer->start(modules, m);
 }
 
 void MainWindow::popWidget()
@@ -482,8 +489,10 @@ void MainWindow::popWidget()
     QWidget *w = m_contentStack.pop().second;
 
     m_rightContentLayout->removeWidget(w);
-    w->setParent(nullptr);
-    w->deleteLater();
+    if (!m_pageCache->insert(w)) {
+        w->setParent(nullptr);
+        w->deleteLater();
+    }
 
     //delete replace widget : first delete replace widget(up code) , then pass pushWidget to set last widget
     if (m_lastThirdPage.second) {
@@ -621,6 +630,7 @@ bool MainWindow::isModuleAvailable(const QString &m)
     });
 
     if (res != m_modules.end()) {
+        m_preInitializer->ensurePreInitialized((*res).first);
         return (*res).first->isAvailable();
     }
 
@@ -1141,6 +1151,7 @@ void MainWindow::onFirstItemClick(const QModelIndex &index)
     popAllWidgets();
 
     if (!m_initList.contains(inter)) {
+        m_preInitializer->ensurePreInitialized(inter);
         inter->initialize();
         m_initList << inter;
     }
@@ -1233,7 +1244,22 @@ void MainWindow::setRemoveableDeviceStatus(QString type, bool state)
         m_searchWidget->setRemoveableDeviceStatus(type, state);
 }
 
+QJsonObject MainWindow::preInitializeStatistics() const
+{
+    return m_preInitializer->statistics();
+}
+
 bool MainWindow::getRemoveableDeviceStatus(QString type) const
 {
     return m_removeableDeviceList.contains(type);
 }
+
+void MainWindow::setPageCacheable(ModuleInterface *const inter, QWidget *const w, const QString &path)
+{
+    m_pageCache->setCacheable(w, inter->name() + "/" + path);
+}
+
+QWidget *MainWindow::takeCachedPage(ModuleInterface *const inter, const QString &path)
+{
+    return m_pageCache->take(inter->name() + "/" + path);
+}
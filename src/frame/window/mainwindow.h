@@ -32,6 +32,7 @@
 #include <QStack>
 #include <QPair>
 #include <QDBusContext>
+#include <QJsonObject>
 #include <QGSettings>
 
 DWIDGET_USE_NAMESPACE
@@ -59,6 +60,8 @@ extern const QString GSettinsWindowHeight;
 
 namespace DCC_NAMESPACE {
 class ModuleInterface;
+class ModulePreInitializer;
+class PageCache;
 class FourthColWidget : public QWidget
 {
     Q_OBJECT
@@ -92,9 +95,12 @@ public:
     void setModuleSubscriptVisible(const QString &module, bool bIsDisplay) override;
     void setRemoveableDeviceStatus(QString type, bool state) override;
     bool getRemoveableDeviceStatus(QString type) const override;
+    void setPageCacheable(ModuleInterface *const inter, QWidget *const w, const QString &path) override;
+    QWidget *takeCachedPage(ModuleInterface *const inter, const QString &path) override;
 
 public:
     bool isModuleAvailable(const QString &m);
+    QJsonObject preInitializeStatistics() const;
     void toggle();
     void popWidget();
     void initAllModule(const QString &m = "");
@@ -151,6 +157,8 @@ private:
     QString m_widgetName;
     QString m_moduleName;
     DIconButton *m_backwardBtn;
+    ModulePreInitializer *m_preInitializer;
+    PageCache *m_pageCache;
     struct CornerItemGroup {
         QString m_name;
         int m_index;
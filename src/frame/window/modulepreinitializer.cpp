@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "modulepreinitializer.h"
+#include "interface/moduleinterface.h"
+
+#include <QTimer>
+#include <QJsonArray>
+#include <QDebug>
+
+using namespace DCC_NAMESPACE;
+
+ModulePreInitializer::ModulePreInitializer(QObject *parent)
+    : QObject(parent)
+    , m_scheduled(false)
+{
+}
+
+void ModulePreInitializer::start(const QList<ModuleInterface *> &modules, const QString &priorityModule)
+{
+    m_clock.start();
+    m_pending = modules;
+
+    for (ModuleInterface *module : modules) {
+        if (module->name() == priorityModule) {
+            m_pending.removeOne(module);
+            preInitialize(module, true);
+            break;
+        }
+    }
+
+    scheduleNext();
+}
+
+void ModulePreInitializer::ensurePreInitialized(ModuleInterface *module)
+{
+    // 队列中剩余的模块仍由 processNext 处理，结束信号也由它发出
+    if (m_pending.removeOne(module))
+        preInitialize(module, false);
+}
+
+void ModulePreInitializer::preInitialize(ModuleInterface *module, bool sync)
+{
+    const qint64 startMs = m_clock.elapsed();
+    QElapsedTimer et;
+    et.start();
+    module->preInitialize(sync);
+
+    const qint64 elapsedMs = et.elapsed();
+    m_timings.append({module->name(), startMs, elapsedMs});
+    Q_EMIT modulePreInitialized(module, elapsedMs);
+}
+
+QJsonObject ModulePreInitializer::statistics() const
+{
+    QJsonArray modules;
+    qint64 total = 0;
+    for (const Timing &timing : m_timings) {
+        QJsonObject item;
+        item["name"] = timing.name;
+        item["startMs"] = timing.startMs;
+        item["elapsedMs"] = timing.elapsedMs;
+        modules.append(item);
+        total += timing.elapsedMs;
+    }
+
+    QJsonObject result;
+    result["finished"] = isFinished();
+    result["totalMs"] = total;
+    result["modules"] = modules;
+    return result;
+}
+
+void ModulePreInitializer::scheduleNext()
+{
+    if (m_scheduled)
+        return;
+
+    m_scheduled = true;
+    QTimer::singleShot(0, this, &ModulePreInitializer::processNext);
+}
+
+void ModulePreInitializer::processNext()
+{
+    m_scheduled = false;
+    if (!m_pending.isEmpty())
+        preInitialize(m_pending.takeFirst(), false);
+
+    if (!m_pending.isEmpty()) {
+        scheduleNext();
+        return;
+    }
+
+    qint64 total = 0;
+    for (const Timing &timing : m_timings)
+        total += timing.elapsedMs;
+    qDebug() << QString("preinitialize %1 modules using time: %2ms, finished after %3ms")
+             .arg(m_timings.size()).arg(total).arg(m_clock.elapsed());
+
+    Q_EMIT finished();
+}
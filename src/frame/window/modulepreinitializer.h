@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MODULEPREINITIALIZER_H
+#define MODULEPREINITIALIZER_H
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QJsonObject>
+
+namespace DCC_NAMESPACE {
+
+class ModuleInterface;
+
+/**
+ * @brief ModulePreInitializer 启动时调度各模块的 preInitialize
+ *
+ * 指定的模块（-m 或 ShowPage 传入）最先同步完成，其余模块每次事件循环只处理一个，
+ * 避免在窗口显示前连续阻塞；在调度完成前被访问的模块会通过 ensurePreInitialized 提前处理。
+ */
+class ModulePreInitializer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Timing {
+        QString name;
+        qint64 startMs;     // 相对调度开始的时间
+        qint64 elapsedMs;   // preInitialize 耗时
+    };
+
+    explicit ModulePreInitializer(QObject *parent = nullptr);
+
+    /**
+     * @brief start 开始调度
+     * @param modules 按导航顺序排列的模块
+     * @param priorityModule 优先处理的模块名，该模块以同步方式初始化
+     */
+    void start(const QList<ModuleInterface *> &modules, const QString &priorityModule = QString());
+
+    /**
+     * @brief ensurePreInitialized 模块尚未初始化时立即初始化
+     */
+    void ensurePreInitialized(ModuleInterface *module);
+
+    bool isFinished() const { return m_pending.isEmpty(); }
+    const QList<Timing> &timings() const { return m_timings; }
+    /**
+     * @brief statistics 以 JSON 形式返回各模块的初始化耗时，按完成顺序排列
+     */
+    QJsonObject statistics() const;
+
+Q_SIGNALS:
+    void modulePreInitialized(ModuleInterface *module, qint64 elapsedMs);
+    void finished();
+
+private:
+    void preInitialize(ModuleInterface *module, bool sync);
+    void scheduleNext();
+    void processNext();
+
+private:
+    QList<ModuleInterface *> m_pending;
+    QList<Timing> m_timings;
+    QElapsedTimer m_clock;
+    bool m_scheduled;
+};
+
+}
+
+#endif // MODULEPREINITIALIZER_H
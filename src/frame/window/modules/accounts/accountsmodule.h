@@ -58,7 +58,7 @@ public:
     QStringList availPage() const override;
 
 Q_SIGNALS:
-    void requestLoadUserList();
+    void requestLoadUserList(int lastVisibleRow);
 
 public Q_SLOTS:
     void onShowAccountsDetailWidget(dcc::accounts::User *account);
@@ -92,13 +92,9 @@ AccountsWidget::AccountsWidget(QWidget *parent)
 
     connect(m_userlistView, &QListView::clicked, this, &AccountsWidget::onItemClicked);
     connect(m_userlistView, &DListView::activated, m_userlistView, &QListView::clicked);
-    connect(m_userlistView->verticalScrollBar(), &QScrollBar::valueChanged, this, [ = ](int value) {
-        static int valueTemp = 0;
-        if (value > valueTemp) {
-            requestLoadUserList();
-        }
-        valueTemp = value;
-    });
+    // 按可见区域按需加载用户，列表增长后可能仍未填满视口，需要继续请求
+    connect(m_userlistView->verticalScrollBar(), &QScrollBar::valueChanged, this, &AccountsWidget::requestVisibleUsers);
+    connect(m_userItemModel, &QStandardItemModel::rowsInserted, this, &AccountsWidget::requestVisibleUsers, Qt::QueuedConnection);
     connect(m_createBtn, &QPushButton::clicked, this, &AccountsWidget::requestCreateAccount);
 }
 
@@ -248,6 +244,28 @@ void AccountsWidget::removeUser(User *user)
     m_isShowFirstUserInfo ? showDefaultAccountInfo() : showLastAccountInfo();
 }
 
+void AccountsWidget::requestVisibleUsers()
+{
+    const QRect viewRect = m_userlistView->viewport()->rect();
+    const QModelIndex lastIndex = m_userlistView->indexAt(QPoint(viewRect.left() + 1, viewRect.bottom() - 1));
+    if (lastIndex.isValid()) {
+        Q_EMIT requestLoadUserList(lastIndex.row());
+        return;
+    }
+
+    // 视口底部是空白，列表还没有填满视口，按视口能容纳的行数请求，
+    // 不能用已有的行数推算，否则每次插入新行都会把加载目标继续往后推
+    const QModelIndex firstIndex = m_userlistView->indexAt(QPoint(viewRect.left() + 1, viewRect.top() + 1));
+    if (!firstIndex.isValid())
+        return;
+
+    const int rowHeight = m_userlistView->visualRect(firstIndex).height() + m_userlistView->spacing();
+    if (rowHeight <= 0)
+        return;
+
+    Q_EMIT requestLoadUserList(firstIndex.row() + viewRect.height() / rowHeight);
+}
+
 void AccountsWidget::onItemClicked(const QModelIndex &index)
 {
     m_saveClickedRow = index.row();
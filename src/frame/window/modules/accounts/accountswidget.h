@@ -87,7 +87,10 @@ Q_SIGNALS:
     void requestCreateAccount();
     void requestShowLastClickedUserInfo(bool t = false);
     void requestBack();
-    void requestLoadUserList();
+    void requestLoadUserList(int lastVisibleRow);
+
+private:
+    void requestVisibleUsers();
 
 private:
     DTK_WIDGET_NAMESPACE::DFloatingButton *m_createBtn;
@@ -22,6 +22,7 @@
 #include "avatarlistwidget.h"
 #include "modules/accounts/user.h"
 #include "avataritemdelegate.h"
+#include "modules/common/imageloader.h"
 
 #include <QWidget>
 #include <QListView>
@@ -44,6 +45,7 @@ const int MaxAvatarSize = 14;
 DWIDGET_USE_NAMESPACE
 using namespace dcc::accounts;
 using namespace DCC_NAMESPACE::accounts;
+using dcc::ImageLoader;
 
 AvatarListWidget::AvatarListWidget(User *usr, QWidget *parent)
     : DListView(parent)
@@ -110,9 +112,9 @@ void AvatarListWidget::refreshCustomAvatar(const QString& str)
         item = m_avatarItemModel->item(MaxAvatarSize);
     }
 
-    item->setData(QVariant::fromValue(QPixmap(customPicPath)), Qt::DecorationRole);
     item->setData(QVariant::fromValue(customPicPath), AvatarListWidget::SaveAvatarRole);
     item->setData(m_avatarSize, Qt::SizeHintRole);
+    loadItemAvatar(item, customPicPath);
 
     if (m_currentSelectIndex.isValid() && m_currentSelectIndex != item->index()) {
         m_avatarItemModel->setData(m_currentSelectIndex, Qt::Unchecked, Qt::CheckStateRole);
@@ -207,23 +209,39 @@ void AvatarListWidget::addItemFromDefaultDir()
 
         DStandardItem *item = new DStandardItem();
         item->setAccessibleText(iconpath);
-        auto ratio = devicePixelRatioF();
 
         auto pxPath = iconpath;
-        if (ratio > 1.0) {
+        if (devicePixelRatioF() > 1.0) {
             pxPath.replace("icons/", "icons/bigger/");
         }
-        auto px = QPixmap(pxPath).scaled(QSize(74, 74) * ratio,
-                                           Qt::KeepAspectRatio, Qt::FastTransformation);
-        px.setDevicePixelRatio(ratio);
 
-        item->setData(QVariant::fromValue(px), Qt::DecorationRole);
         item->setData(QVariant::fromValue(iconpath), AvatarListWidget::SaveAvatarRole);
         item->setData(m_avatarSize, Qt::SizeHintRole);
         m_avatarItemModel->appendRow(item);
+        loadItemAvatar(item, pxPath);
     }
 }
 
+void AvatarListWidget::loadItemAvatar(QStandardItem *item, const QString &path)
+{
+    // 解码完成前用透明图占位，空图会被绘制成添加按钮
+    QPixmap placeholder(1, 1);
+    placeholder.fill(Qt::transparent);
+    item->setData(QVariant::fromValue(placeholder), Qt::DecorationRole);
+
+    const QPersistentModelIndex index = item->index();
+    ImageLoader::instance()->load(path, QSize(74, 74), devicePixelRatioF(), this, [this, index, path](const QPixmap &pixmap) {
+        // 加载期间条目可能已被移除或换成其他图片
+        if (!index.isValid())
+            return;
+
+        QStandardItem *item = m_avatarItemModel->itemFromIndex(index);
+        const QString current = item->data(SaveAvatarRole).toString();
+        if (path == current || path == QString(current).replace("icons/", "icons/bigger/"))
+            item->setData(QVariant::fromValue(pixmap), Qt::DecorationRole);
+    });
+}
+
 void AvatarListWidget::addLastItem()
 {
     DStandardItem *item = new DStandardItem();
@@ -36,6 +36,7 @@ class QVBoxLayout;
 class QLabel;
 class QListView;
 class QStandardItemModel;
+class QStandardItem;
 class QModelIndex;
 QT_END_NAMESPACE
 
@@ -76,6 +77,7 @@ private Q_SLOTS:
 private:
     void initWidgets();
     QString getUserAddedCustomPicPath(const QString &usrName);
+    void loadItemAvatar(QStandardItem *item, const QString &path);
 
 private:
     dcc::accounts::User *m_curUser{nullptr};
@@ -59,6 +59,7 @@ AdapterWidget::AdapterWidget(const dcc::bluetooth::Adapter *adapter, dcc::blueto
     , m_model(model)
     , m_discoverySwitch(new SwitchWidget(tr("Allow other Bluetooth devices to find this device")))
     , m_lastPowerCheck(false)
+    , m_pendingDevicesTimer(new QTimer(this))
     , m_bluetoothInter("com.deepin.daemon.Bluetooth", "/com/deepin/daemon/Bluetooth", QDBusConnection::sessionBus(), this)
 {
     initMember();
@@ -72,9 +73,9 @@ AdapterWidget::AdapterWidget(const dcc::bluetooth::Adapter *adapter, dcc::blueto
 
 AdapterWidget::~AdapterWidget()
 {
-    qDeleteAll(m_deviceLists);
+    qDeleteAll(m_deviceItems);
     m_myDevices.clear();
-    m_deviceLists.clear();
+    m_deviceItems.clear();
 }
 
 bool AdapterWidget::getSwitchState()
@@ -85,6 +86,10 @@ bool AdapterWidget::getSwitchState()
 void AdapterWidget::initMember()
 {
     m_showUnnamedDevices = m_bluetoothInter.displaySwitch();
+
+    m_pendingDevicesTimer->setSingleShot(true);
+    m_pendingDevicesTimer->setInterval(16);
+    connect(m_pendingDevicesTimer, &QTimer::timeout, this, &AdapterWidget::flushPendingDevices);
 }
 
 void AdapterWidget::initUI()
@@ -200,22 +205,12 @@ void AdapterWidget::initConnect()
 
     connect(m_myDeviceListView, &DListView::clicked, this, [this](const QModelIndex & idx) {
         m_otherDeviceListView->clearSelection();
-        const QStandardItemModel *deviceModel = dynamic_cast<const QStandardItemModel *>(idx.model());
-        if (!deviceModel) {
-            return;
-        }
-        BtStandardItem *item = dynamic_cast<BtStandardItem *>(deviceModel->item(idx.row()));
-        if (!item) {
-            return;
-        }
-        for (auto it : m_myDevices) {
-            if (it && it->device() && it->getStandardItem() == item) {
-                if (it->device()->state() != Device::StateConnected) {
-                    it->requestConnectDevice(it->device(), m_adapter);
-                }
-                Q_EMIT requestShowDetail(m_adapter, it->device());
-                break;
+        DeviceSettingsItem *it = deviceItemFromIndex(idx);
+        if (it && it->device()) {
+            if (it->device()->state() != Device::StateConnected) {
+                it->requestConnectDevice(it->device(), m_adapter);
             }
+            Q_EMIT requestShowDetail(m_adapter, it->device());
         }
     });
 
@@ -223,19 +218,9 @@ void AdapterWidget::initConnect()
 
     connect(m_otherDeviceListView, &DListView::clicked, this, [this](const QModelIndex & idx) {
         m_myDeviceListView->clearSelection();
-        const QStandardItemModel *deviceModel = dynamic_cast<const QStandardItemModel *>(idx.model());
-        if (!deviceModel) {
-            return;
-        }
-        BtStandardItem *item = dynamic_cast<BtStandardItem *>(deviceModel->item(idx.row()));
-        if (!item) {
-            return;
-        }
-        for (auto it : m_deviceLists) {
-            if (it && it->device() && it->getStandardItem() == item) {
-                it->requestConnectDevice(it->device(), m_adapter);
-                break;
-            }
+        DeviceSettingsItem *it = deviceItemFromIndex(idx);
+        if (it && it->device()) {
+            it->requestConnectDevice(it->device(), m_adapter);
         }
     });
 
@@ -266,9 +251,7 @@ void AdapterWidget::initConnect()
                 m_bluetoothInter.setDisplaySwitch(false);
             }
             // 将蓝牙名称为空的设备过滤掉
-            for (int i = 0; i < m_deviceLists.size(); i++) {
-                DeviceSettingsItem *pDeviceItem = m_deviceLists[i];
-
+            for (DeviceSettingsItem *pDeviceItem : m_deviceItems) {
                 if (pDeviceItem && pDeviceItem->device() && pDeviceItem->device()->paired())
                     continue;
 
@@ -285,8 +268,7 @@ void AdapterWidget::initConnect()
                 m_bluetoothInter.setDisplaySwitch(true);
             }
             // 显示所有蓝牙设备
-            for (int i = 0; i < m_deviceLists.size(); i++) {
-                DeviceSettingsItem *pDeviceItem = m_deviceLists[i];
+            for (DeviceSettingsItem *pDeviceItem : m_deviceItems) {
                 if (pDeviceItem && pDeviceItem->device() && pDeviceItem->device()->paired())
                     continue;
 
@@ -330,6 +312,9 @@ void AdapterWidget::setAdapter(const Adapter *adapter)
             addDevice(device);
         }
     }
+    // 已有设备立即加入列表，后续扫描到的设备再合并刷新
+    m_pendingDevicesTimer->stop();
+    flushPendingDevices();
     connect(adapter, &Adapter::discoverableChanged, m_discoverySwitch, [ = ] {
         m_discoverySwitch->setChecked(adapter->discoverabled());
     });
@@ -387,11 +372,7 @@ void AdapterWidget::categoryDevice(DeviceSettingsItem *deviceItem, const bool pa
             m_myDeviceModel->insertRow(0, dListItem);
         } else {
             BtStandardItem *dListItem = deviceItem->getStandardItem(m_otherDeviceListView);
-            if (m_showAnonymousCheckBox->checkState() == Qt::CheckState::Unchecked) {
-                if (deviceItem->device() && false == deviceItem->device()->name().isEmpty()) { // 只关注有名称的蓝牙设备,没有名称的忽略
-                    m_otherDeviceModel->insertRow(0, dListItem);
-                }
-            } else {
+            if (isDeviceShown(deviceItem->device())) {
                 m_otherDeviceModel->insertRow(0, dListItem);
             }
         }
@@ -405,10 +386,55 @@ void AdapterWidget::addDevice(const Device *device)
 {
     if (!device)
         return;
+
+    m_pendingDevices << device;
+    if (!m_pendingDevicesTimer->isActive())
+        m_pendingDevicesTimer->start();
+}
+
+void AdapterWidget::flushPendingDevices()
+{
+    const QList<QPointer<const Device>> devices = m_pendingDevices;
+    m_pendingDevices.clear();
+
+    // 批量插入期间暂停重绘，避免每个设备都触发一次列表布局和绘制
+    m_myDeviceListView->setUpdatesEnabled(false);
+    m_otherDeviceListView->setUpdatesEnabled(false);
+    for (const QPointer<const Device> &device : devices) {
+        if (device && !m_deviceItems.contains(device->id()))
+            createDeviceItem(device);
+    }
+    m_myDeviceListView->setUpdatesEnabled(true);
+    m_otherDeviceListView->setUpdatesEnabled(true);
+}
+
+bool AdapterWidget::isDeviceShown(const Device *device) const
+{
+    // 只关注有名称的蓝牙设备,没有名称的忽略
+    return device && (m_showAnonymousCheckBox->checkState() != Qt::CheckState::Unchecked || !device->name().isEmpty());
+}
+
+DeviceSettingsItem *AdapterWidget::deviceItemFromIndex(const QModelIndex &index) const
+{
+    return m_deviceItems.value(index.data(DeviceSettingsItem::DeviceIdRole).toString());
+}
+
+void AdapterWidget::createDeviceItem(const Device *device)
+{
     QPointer<DeviceSettingsItem> deviceItem = new DeviceSettingsItem(device, style());
+    m_deviceItems.insert(device->id(), deviceItem);
     categoryDevice(deviceItem, device->paired());
 
     connect(deviceItem, &DeviceSettingsItem::requestConnectDevice, this, &AdapterWidget::requestConnectDevice);
+    // 设备名称出现后，之前被过滤掉的匿名设备需要显示出来
+    connect(device, &Device::nameChanged, this, [this, deviceItem] {
+        if (!deviceItem || !deviceItem->device() || deviceItem->device()->paired())
+            return;
+
+        BtStandardItem *item = deviceItem->getStandardItem();
+        if (!m_otherDeviceModel->indexFromItem(item).isValid() && isDeviceShown(deviceItem->device()))
+            m_otherDeviceModel->insertRow(0, item);
+    });
     connect(device, &Device::pairedChanged, this, [this, deviceItem](const bool paired) {
         if (deviceItem && deviceItem->device()) {
             if (paired) {
@@ -444,40 +470,31 @@ void AdapterWidget::addDevice(const Device *device)
     connect(deviceItem, &DeviceSettingsItem::requestShowDetail, this, [this](const Device * device) {
         Q_EMIT requestShowDetail(m_adapter, device);
     });
-
-    m_deviceLists << deviceItem;
 }
 
 void AdapterWidget::removeDevice(const QString &deviceId)
 {
-    bool isFind = false;
-    for (auto it : m_myDevices) {
-        if (it && it->device() && it->device()->id() == deviceId) {
-            BtStandardItem *item = it->getStandardItem();
-            QModelIndex myDeviceIndex = m_myDeviceModel->indexFromItem(item);
-            m_myDeviceModel->removeRow(myDeviceIndex.row());
-            m_myDevices.removeOne(it);
-            m_deviceLists.removeOne(it);
-            delete it;
-            it = nullptr;
-            Q_EMIT notifyRemoveDevice();
-            isFind = true;
-            break;
-        }
+    for (int i = m_pendingDevices.size() - 1; i >= 0; --i) {
+        if (!m_pendingDevices.at(i) || m_pendingDevices.at(i)->id() == deviceId)
+            m_pendingDevices.removeAt(i);
     }
-    if (!isFind) {
-        for (auto it : m_deviceLists) {
-            if (it && it->device() && it->device()->id() == deviceId) {
-                BtStandardItem *item = it->getStandardItem();
-                QModelIndex otherDeviceIndex = m_otherDeviceModel->indexFromItem(item);
-                m_otherDeviceModel->removeRow(otherDeviceIndex.row());
-                m_deviceLists.removeOne(it);
-                delete it;
-                it = nullptr;
-                Q_EMIT notifyRemoveDevice();
-                break;
-            }
+
+    DeviceSettingsItem *it = m_deviceItems.take(deviceId);
+    if (it) {
+        BtStandardItem *item = it->getStandardItem();
+        QModelIndex myDeviceIndex = m_myDeviceModel->indexFromItem(item);
+        QModelIndex otherDeviceIndex = m_otherDeviceModel->indexFromItem(item);
+        if (myDeviceIndex.isValid()) {
+            m_myDeviceModel->removeRow(myDeviceIndex.row());
+        } else if (otherDeviceIndex.isValid()) {
+            m_otherDeviceModel->removeRow(otherDeviceIndex.row());
+        } else {
+            // 被过滤掉的匿名设备不在列表中，条目需要单独释放
+            delete item;
         }
+        m_myDevices.removeOne(it);
+        delete it;
+        Q_EMIT notifyRemoveDevice();
     }
     if (m_myDevices.isEmpty()) {
         m_myDevicesGroup->hide();
@@ -31,6 +31,7 @@
 
 #include <QWidget>
 #include <QPointer>
+#include <QHash>
 #include <QTime>
 #include <QTimer>
 
@@ -84,6 +85,10 @@ private:
     void initUI();
     void initConnect();
     void categoryDevice(DeviceSettingsItem *deviceItem, const bool paired);
+    void createDeviceItem(const dcc::bluetooth::Device *device);
+    void flushPendingDevices();
+    DeviceSettingsItem *deviceItemFromIndex(const QModelIndex &index) const;
+    bool isDeviceShown(const dcc::bluetooth::Device *device) const;
 
 public Q_SLOTS:
     void toggleSwitch(const bool checked);
@@ -112,8 +117,12 @@ private:
     const dcc::bluetooth::Adapter *m_adapter;
     dcc::widgets::SwitchWidget *m_powerSwitch;
     DCheckBox *m_showAnonymousCheckBox;
-    QList<QPointer<DeviceSettingsItem>> m_deviceLists;
+    // 按设备路径索引的全部设备条目
+    QHash<QString, QPointer<DeviceSettingsItem>> m_deviceItems;
     QList<QPointer<DeviceSettingsItem>> m_myDevices;
+    // 等待批量加入列表的设备，扫描时设备成批出现，每帧只更新一次列表
+    QList<QPointer<const dcc::bluetooth::Device>> m_pendingDevices;
+    QTimer *m_pendingDevicesTimer;
     TitleLabel *m_myDevicesGroup;
     DTK_WIDGET_NAMESPACE::DListView *m_myDeviceListView;
     QStandardItemModel *m_myDeviceModel;
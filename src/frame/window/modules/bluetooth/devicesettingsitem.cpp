@@ -55,6 +55,7 @@ DeviceSettingsItem::DeviceSettingsItem(const Device *device, QStyle *style)
             m_deviceItem->setIcon(QIcon(darkIcon + QString("other_dark.svg")));
     }
     m_deviceItem->setText(m_device->alias().isEmpty() ? m_device->name() : m_device->alias());
+    m_deviceItem->setData(m_device->id(), DeviceIdRole);
     m_deviceItem->setActionList(Qt::RightEdge, m_dActionList);
 }
 
@@ -109,24 +110,9 @@ void DeviceSettingsItem::loadingStop()
 void DeviceSettingsItem::onUpdateLoading()
 {
     if (m_parentDListView) {
-        QModelIndex index;
-        BtStandardItem *item = nullptr;
-        for (int i = 0; i < m_parentDListView->count(); ++i) {
-            const QStandardItemModel *deviceModel = dynamic_cast<const QStandardItemModel *>(m_parentDListView->model());
-            if (!deviceModel) {
-                return;
-            }
-            item = dynamic_cast<BtStandardItem *>(deviceModel->item(i));
-            if (!item) {
-                continue;
-            }
-            if (m_deviceItem == item) {
-                index = m_parentDListView->model()->index(i, 0);
-                break;
-            }
-        }
+        const QModelIndex index = itemIndex();
         QRect itemrect = m_parentDListView->visualRect(index);
-        if (item && (itemrect.height() != 0 || index.row() == 1)) {
+        if (index.isValid() && (itemrect.height() != 0 || index.row() == 1)) {
             QPoint point(itemrect.x() + itemrect.width(), itemrect.y());
             m_loadingIndicator->move(point);
             loadingStart();
@@ -141,6 +127,15 @@ void DeviceSettingsItem::onUpdateLoading()
     }
 }
 
+QModelIndex DeviceSettingsItem::itemIndex() const
+{
+    // 条目不在当前列表中时返回无效索引
+    if (!m_deviceItem || !m_parentDListView || m_deviceItem->model() != m_parentDListView->model())
+        return QModelIndex();
+
+    return m_deviceItem->index();
+}
+
 void DeviceSettingsItem::setLoading(const bool loading)
 {
     if (loading) {
@@ -160,20 +155,10 @@ void DeviceSettingsItem::setDevice(const Device *device)
     connect(device, &Device::pairedChanged, this, &DeviceSettingsItem::onDevicePairedChanged);
 
     connect(m_textAction, &QAction::triggered, this, [this] {
-        for (int i = 0; i < m_parentDListView->count(); ++i) {
-            const QStandardItemModel *deviceModel = dynamic_cast<const QStandardItemModel *>(m_parentDListView->model());
-            if (!deviceModel) {
-                return;
-            }
-            BtStandardItem *item = dynamic_cast<BtStandardItem *>(deviceModel->item(i));
-            if (!item) {
-                return;
-            }
-            if (m_deviceItem == item) {
-                m_parentDListView->setCurrentIndex(m_parentDListView->model()->index(i, 0));
-                m_parentDListView->clicked(m_parentDListView->model()->index(i, 0));
-                break;
-            }
+        const QModelIndex index = itemIndex();
+        if (index.isValid()) {
+            m_parentDListView->setCurrentIndex(index);
+            m_parentDListView->clicked(index);
         }
     });
 
@@ -185,6 +170,11 @@ void DeviceSettingsItem::setDevice(const Device *device)
             m_deviceItem->setText(alias);
         }
     });
+    connect(device, &Device::nameChanged, this, [this](const QString &name) {
+        if (m_deviceItem && m_device->alias().isEmpty()) {
+            m_deviceItem->setText(name);
+        }
+    });
 
     onDeviceStateChanged(device->state(), device->connectState());
     onDevicePairedChanged(device->paired());
@@ -225,6 +215,7 @@ BtStandardItem *DeviceSettingsItem::createStandardItem(DListView *parent)
             m_deviceItem->setIcon(QIcon(darkIcon + QString("other_dark.svg")));
     }
     m_deviceItem->setText(m_device->alias().isEmpty() ? m_device->name() : m_device->alias());
+    m_deviceItem->setData(m_device->id(), DeviceIdRole);
     m_deviceItem->setActionList(Qt::RightEdge, m_dActionList);
 
     return m_deviceItem;
@@ -58,6 +58,10 @@ class DeviceSettingsItem : public QObject
 {
     Q_OBJECT
 public:
+    enum ItemRole {
+        DeviceIdRole = Dtk::UserRole + 1
+    };
+
     explicit DeviceSettingsItem(const dcc::bluetooth::Device *device, QStyle *style);
     virtual ~DeviceSettingsItem();
     BtStandardItem *getStandardItem(DTK_WIDGET_NAMESPACE::DListView *parent = nullptr);
@@ -71,6 +75,7 @@ private:
     void initItemActionList();
     void loadingStart();
     void loadingStop();
+    QModelIndex itemIndex() const;
 
 Q_SIGNALS:
     void requestConnectDevice(const dcc::bluetooth::Device *device, const dcc::bluetooth::Adapter *adapter) const;
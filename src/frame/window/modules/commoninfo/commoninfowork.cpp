@@ -27,6 +27,8 @@
 
 #include "widgets/basiclistdelegate.h"
 #include "widgets/utils.h"
+#include "modules/common/imageloader.h"
+#include "modules/common/licensestate.h"
 
 #include <signal.h>
 #include <QStandardPaths>
@@ -35,6 +37,9 @@
 
 using namespace DCC_NAMESPACE;
 using namespace commoninfo;
+using dcc::ImageLoader;
+
+static const QSize BackgroundPreviewSize(1024, 576);
 
 const QString UeProgramInterface("com.deepin.userexperience.Daemon");
 const QString UeProgramObjPath("/com/deepin/userexperience/Daemon");
@@ -58,12 +63,9 @@ CommonInfoWork::CommonInfoWork(CommonInfoModel *model, QObject *parent)
                                                 "/com/deepin/deepinid",
                                                 QDBusConnection::sessionBus(), this);
 
-    m_activeInfo = new QDBusInterface("com.deepin.license",
-                                      "/com/deepin/license/Info",
-                                      "com.deepin.license.Info",
-                                      QDBusConnection::systemBus(),this);
-
-    licenseStateChangeSlot();
+    dcc::LicenseState::instance()->subscribe(this, [this](quint32 state) {
+        m_commomModel->setActivation(dcc::LicenseState::isActivated(state));
+    });
 
     m_dBusUeProgram = new UeProgramDbus(UeProgramInterface, UeProgramObjPath, QDBusConnection::systemBus(), this);
 
@@ -126,7 +128,6 @@ CommonInfoWork::CommonInfoWork(CommonInfoModel *model, QObject *parent)
     }, Qt::QueuedConnection);
 
     connect(m_dBusGrubTheme, &GrubThemeDbus::BackgroundChanged, this, &CommonInfoWork::onBackgroundChanged);
-    connect(m_activeInfo, SIGNAL(LicenseStateChange()),this, SLOT(licenseStateChangeSlot()));
 }
 
 CommonInfoWork::~CommonInfoWork()
@@ -380,52 +381,14 @@ void CommonInfoWork::getBackgroundFinished(QDBusPendingCallWatcher *w)
 {
     if (!w->isError()) {
         QDBusPendingReply<QString> reply = w->reply();
-#if 1
-        QPixmap pix = QPixmap(reply.value());
-        m_commomModel->setBackground(pix);
-#else
-        const qreal ratio = qApp->devicePixelRatio();
-        QPixmap pix = QPixmap(reply.value()).scaled(QSize(ItemWidth * ratio, ItemHeight * ratio),
-                                                    Qt::KeepAspectRatioByExpanding, Qt::FastTransformation);
-
-        const QRect r(0, 0, ItemWidth * ratio, ItemHeight * ratio);
-        const QSize size(ItemWidth * ratio, ItemHeight * ratio);
-
-        if (pix.width() > ItemWidth * ratio || pix.height() > ItemHeight * ratio)
-            pix = pix.copy(QRect(pix.rect().center() - r.center(), size));
-
-        pix.setDevicePixelRatio(ratio);
-        m_commomModel->setBackground(pix);
-#endif
+        // 预览区域远小于 grub 背景原图，直接按预览尺寸在线程池中解码
+        ImageLoader::instance()->load(reply.value(), BackgroundPreviewSize, qApp->devicePixelRatio(), m_commomModel,
+                                      [this](const QPixmap &pixmap) {
+            m_commomModel->setBackground(pixmap);
+        });
     } else {
         qDebug() << w->error().message();
     }
 
     w->deleteLater();
 }
-
-void CommonInfoWork::licenseStateChangeSlot()
-{
-    QFutureWatcher<void> *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<void>::finished, watcher, &QFutureWatcher<void>::deleteLater);
-
-    QFuture<void> future = QtConcurrent::run(this, &CommonInfoWork::getLicenseState);
-    watcher->setFuture(future);
-}
-
-void CommonInfoWork::getLicenseState()
-{
-    QDBusInterface licenseInfo("com.deepin.license",
-                               "/com/deepin/license/Info",
-                               "com.deepin.license.Info",
-                               QDBusConnection::systemBus());
-
-    if (!licenseInfo.isValid()) {
-        qWarning()<< "com.deepin.license error ,"<< licenseInfo.lastError().name();
-        return;
-    }
-
-    quint32 reply = licenseInfo.property("AuthorizationState").toUInt();
-    qDebug() << "authorize result:" << reply;
-    m_commomModel->setActivation(reply == 1 || reply == 3);
-}
@@ -52,7 +52,6 @@ public:
 
     void loadGrubSettings();
     bool defaultUeProgram();
-    void getLicenseState();
 
 public Q_SLOTS:
     void setBootDelay(bool value);
@@ -64,7 +63,6 @@ public Q_SLOTS:
     void setUeProgram(bool enabled, DCC_NAMESPACE::MainWindow *pMainWindow);
     void setEnableDeveloperMode(bool enabled, DCC_NAMESPACE::MainWindow *pMainWindow);
     void login();
-    void licenseStateChangeSlot();
 
 private:
     void getEntryTitles();
@@ -77,7 +75,6 @@ private:
     UeProgramDbus *m_dBusUeProgram; // for user experience program
     QProcess *m_process = nullptr;
     GrubDevelopMode *m_dBusdeepinIdInter;
-    QDBusInterface *m_activeInfo;
     QString m_title;
     QString m_content;
 };
@@ -24,7 +24,7 @@
 #include <QPainter>
 #include <QPainterPath>
 #include <QIcon>
-#include <QTimer>
+#include <QTime>
 
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::datetime;
@@ -34,10 +34,10 @@ Clock::Clock(QWidget *parent)
     , m_drawTicks(true)
     , m_autoNightMode(true)
     , n_bIsUseBlackPlat(true)
+    , m_isBlack(false)
+    , m_plateHour(-1)
+    , m_pixmapRatio(0)
 {
-    m_hour = getPixmap(":/datetime/icons/dcc_noun_hour.svg", pointSize);
-    m_min = getPixmap(":/datetime/icons/dcc_noun_minute.svg", pointSize);
-    m_sec = getPixmap(":/datetime/icons/dcc_noun_second.svg", pointSize);
 }
 
 Clock::~Clock()
@@ -61,56 +61,64 @@ void Clock::paintEvent(QPaintEvent *event)
 {
     Q_UNUSED(event)
 
-    QDateTime datetime(QDateTime::currentDateTime());
-    const QTime time(datetime.time());
-    QPainter painter(this);
-    painter.setRenderHints(QPainter::HighQualityAntialiasing | QPainter::SmoothPixmapTransform);
+    const QTime time(QTime::currentTime());
+    const qreal ratio = devicePixelRatioF();
+
+    // 屏幕缩放变化后重新生成所有图片
+    if (!qFuzzyCompare(ratio, m_pixmapRatio)) {
+        m_pixmapRatio = ratio;
+        m_hour = getPixmap(":/datetime/icons/dcc_noun_hour.svg", pointSize);
+        m_min = getPixmap(":/datetime/icons/dcc_noun_minute.svg", pointSize);
+        m_sec = getPixmap(":/datetime/icons/dcc_noun_second.svg", pointSize);
+        m_plat = QPixmap();
+        m_plateHour = -1;
+    }
 
-    do {
+    // 昼夜只会在整点切换，其余时间不必重新判断
+    if (time.hour() != m_plateHour) {
+        m_plateHour = time.hour();
         const bool nightMode = !(time.hour() >= 6  && time.hour() < 18);
-        if (nightMode == m_isBlack && !m_plat.isNull())
-            break;
-        if (nightMode) {
-            m_plat = getPixmap(":/datetime/icons/dcc_clock_black.svg", clockSize);
-            m_isBlack = true;
-        } else {
-            m_plat = getPixmap(":/datetime/icons/dcc_clock_white.svg", clockSize);
-            m_isBlack = false;
+        if (nightMode != m_isBlack || m_plat.isNull()) {
+            m_isBlack = nightMode;
+            m_plat = getPixmap(m_isBlack ? ":/datetime/icons/dcc_clock_black.svg"
+                                         : ":/datetime/icons/dcc_clock_white.svg", clockSize);
+            m_plateLayer = QPixmap();
         }
-    } while(false);
+    }
+
+    // 表盘是静态的，缓存成与控件同尺寸的图层，每秒只需直接贴图
+    if (m_plateLayer.isNull() || m_plateLayer.size() != size() * ratio) {
+        m_plateLayer = QPixmap(size() * ratio);
+        m_plateLayer.setDevicePixelRatio(ratio);
+        m_plateLayer.fill(Qt::transparent);
+
+        QPainter platePainter(&m_plateLayer);
+        platePainter.setRenderHints(QPainter::SmoothPixmapTransform);
+        platePainter.drawPixmap(QPointF((width() - clockSize.width()) / 2.0, (height() - clockSize.height()) / 2.0), m_plat);
+    }
 
-    // draw plate
-    painter.save();
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, m_plateLayer);
+
+    painter.setRenderHints(QPainter::SmoothPixmapTransform);
     painter.translate(width() / 2.0, height() / 2.0);
-    painter.drawPixmap(QPointF(-clockSize.width() / 2.0, -clockSize.height() / 2.0), m_plat);
-    painter.restore();
+
+    auto drawHand = [&painter](qreal angle, const QPixmap &hand) {
+        painter.save();
+        painter.rotate(angle);
+        painter.drawPixmap(QPointF(-pointSize.width() / 2.0, -pointSize.height() / 2.0), hand);
+        painter.restore();
+    };
 
     int nHour = (time.hour() >= 12) ? (time.hour() - 12) : time.hour();
     int nStartAngle = 90;//The image from 0 start , but the clock need from -90 start
 
     // draw hour hand
-    const qreal hourAngle = qreal(nHour * 30 + time.minute() * 30 / 60 + time.second() * 30 / 60 / 60 - nStartAngle);
-    painter.save();
-    painter.translate(width() / 2.0, height() / 2.0);
-    painter.rotate(hourAngle);
-    painter.drawPixmap(QPointF(-pointSize.width() / 2.0, -pointSize.height() / 2.0), m_hour);
-    painter.restore();
-
+    drawHand(qreal(nHour * 30 + time.minute() * 30 / 60 + time.second() * 30 / 60 / 60 - nStartAngle), m_hour);
     // draw minute hand
-    const qreal minuteAngle = qreal(time.minute() * 6 + time.second() * 6 / 60 - nStartAngle);
-    painter.save();
-    painter.translate(width() / 2.0, height() / 2.0);
-    painter.rotate(minuteAngle);
-    painter.drawPixmap(QPointF(-pointSize.width() / 2.0, -pointSize.height() / 2.0), m_min);
-    painter.restore();
-
+    drawHand(qreal(time.minute() * 6 + time.second() * 6 / 60 - nStartAngle), m_min);
     // draw second hand
-    const qreal secondAngle = qreal(time.second() * 6 - nStartAngle);
-    painter.save();
-    painter.translate(width() / 2.0, height() / 2.0);
-    painter.rotate(secondAngle);
-    painter.drawPixmap(QPointF(-pointSize.width() / 2.0, -pointSize.height() / 2.0), m_sec);
-    painter.restore();
+    drawHand(qreal(time.second() * 6 - nStartAngle), m_sec);
 
     painter.end();
 }
@@ -56,7 +56,10 @@ private:
     bool n_bIsUseBlackPlat;
     bool m_isBlack;
     ZoneInfo m_timeZone;
+    int m_plateHour;
+    qreal m_pixmapRatio;
     QPixmap m_plat;
+    QPixmap m_plateLayer;
     QPixmap m_hour;
     QPixmap m_min;
     QPixmap m_sec;
@@ -21,11 +21,11 @@
 #include "clock.h"
 #include "clockitem.h"
 #include "widgets/labels/normallabel.h"
+#include "modules/datetime/clockticker.h"
 
 #include <DTipLabel>
 
 #include <QVBoxLayout>
-#include <QTimer>
 #include <QFontDatabase>
 #include <QDebug>
 
@@ -112,11 +112,9 @@ ClockItem::ClockItem(QWidget *parent, bool isDisplay)
 
     setLayout(layout);
 
-    QTimer *timer = new QTimer(this);
-    timer->setSingleShot(false);
-    connect(timer, &QTimer::timeout, this, &ClockItem::updateDateTime, Qt::DirectConnection);
-
-    timer->start(1000);
+    dcc::datetime::ClockTicker::instance()->subscribe(this, [this] {
+        updateDateTime();
+    });
 
     setWeekdayFormatType(m_timedateInter->weekdayFormat());
     setShortDateFormat(m_timedateInter->shortDateFormat());
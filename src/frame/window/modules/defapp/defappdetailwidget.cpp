@@ -40,6 +40,11 @@ using namespace DCC_NAMESPACE::defapp;
 
 DWIDGET_USE_NAMESPACE
 
+static QString itemKey(const dcc::defapp::App &app)
+{
+    return (app.isUser ? QStringLiteral("user:") : QStringLiteral("system:")) + app.Id;
+}
+
 DefappDetailWidget::DefappDetailWidget(dcc::defapp::DefAppWorker::DefaultAppsCategory category, QWidget *parent)
     : QWidget(parent)
     , m_centralLayout(new QVBoxLayout)
@@ -122,40 +127,44 @@ void DefappDetailWidget::setCategory(dcc::defapp::Category *const category)
 }
 
 QIcon DefappDetailWidget::getAppIcon(const QString &appIcon, const QSize &size) {
-    QIcon icon = QIcon::fromTheme(appIcon, QIcon::fromTheme("application-x-desktop"));
+    // 所有分类页共用，主题或缩放比例变化后键不同，自然不会命中旧图标
+    static QHash<QString, QIcon> iconCache;
 
     const qreal ratio = devicePixelRatioF();
+    const QString key = QString("%1/%2/%3x%4@%5").arg(QIcon::themeName(), appIcon)
+            .arg(size.width()).arg(size.height()).arg(ratio);
+    auto it = iconCache.constFind(key);
+    if (it != iconCache.constEnd())
+        return it.value();
+
+    QIcon icon = QIcon::fromTheme(appIcon, QIcon::fromTheme("application-x-desktop"));
     QPixmap pixmap = icon.pixmap(size * ratio).scaled(size * ratio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     pixmap.setDevicePixelRatio(ratio);
 
-    return pixmap;
+    return iconCache.insert(key, QIcon(pixmap)).value();
 }
 
 void DefappDetailWidget::addItem(const dcc::defapp::App &item)
 {
     qDebug() << Q_FUNC_INFO << item.Id << ", isUser :" << item.isUser;
     appendItemData(item);
-    updateListView(m_category->getDefault());
+    if (DStandardItem *modelItem = m_items.value(itemKey(item)))
+        updateItem(modelItem, m_category->getDefault());
 }
 
 void DefappDetailWidget::removeItem(const dcc::defapp::App &item)
 {
     qDebug() << "DefappDetailWidget::removeItem id " << item.Id;
-    //update model
-    int cnt = m_model->rowCount();
-    for (int row = 0; row < cnt; row++) {
-        QString id = m_model->data(m_model->index(row, 0), DefAppIdRole).toString();
-        if (id == item.Id) {
-            m_model->removeRow(row);
-            if (item.isUser) {
-                m_userAppCnt--;
-            } else {
-                m_systemAppCnt--;
-            }
-            break;
-        }
+    DStandardItem *modelItem = m_items.take(itemKey(item));
+    if (!modelItem)
+        return;
+
+    m_model->removeRow(modelItem->row());
+    if (item.isUser) {
+        m_userAppCnt--;
+    } else {
+        m_systemAppCnt--;
     }
-    updateListView(m_category->getDefault());
 }
 
 void DefappDetailWidget::showInvalidText(DStandardItem *modelItem, const QString &name, const QString &iconName)
@@ -182,37 +191,42 @@ void DefappDetailWidget::updateListView(const dcc::defapp::App &defaultApp) {
     int cnt = m_model->rowCount();
     for (int row = 0; row < cnt; row++) {
         DStandardItem *modelItem = dynamic_cast<DStandardItem *>(m_model->item(row));
-        QString id = modelItem->data(DefAppIdRole).toString();
-        bool isUser = modelItem->data(DefAppIsUserRole).toBool();
-        bool canDelete = modelItem->data(DefAppCanDeleteRole).toBool();
-        QString name = modelItem->data(DefAppNameRole).toString();
-        QString iconName = modelItem->data(DefAppIconRole).toString();
-
-        if (id == defaultApp.Id) {
-            modelItem->setCheckState(Qt::Checked);
-            //remove user clear button
-            if (!isUser && !canDelete)
-                continue;
-
-            DViewItemActionList actions;
-            modelItem->setActionList(Qt::RightEdge, actions);
-            showInvalidText(modelItem, name, iconName);
-        } else {
-            modelItem->setCheckState(Qt::Unchecked);
-            //add user clear button
-            if (!isUser && !canDelete)
-                continue;
-
-            DViewItemActionList btnActList;
-            QPointer<DViewItemAction> delAction(new DViewItemAction(Qt::AlignVCenter | Qt::AlignRight, QSize(21, 21), QSize(19, 19), true));
-
-            delAction->setIcon(DStyleHelper(style()).standardIcon(DStyle::SP_CloseButton, nullptr, this));
-            connect(delAction, &QAction::triggered, this, &DefappDetailWidget::onDelBtnClicked);
-            btnActList << delAction;
-            modelItem->setActionList(Qt::RightEdge, btnActList);
-            m_actionMap.insert(delAction, id);
-            showInvalidText(modelItem, name, iconName);
-        }
+        updateItem(modelItem, defaultApp);
+    }
+}
+
+void DefappDetailWidget::updateItem(DStandardItem *modelItem, const dcc::defapp::App &defaultApp)
+{
+    QString id = modelItem->data(DefAppIdRole).toString();
+    bool isUser = modelItem->data(DefAppIsUserRole).toBool();
+    bool canDelete = modelItem->data(DefAppCanDeleteRole).toBool();
+    QString name = modelItem->data(DefAppNameRole).toString();
+    QString iconName = modelItem->data(DefAppIconRole).toString();
+
+    if (id == defaultApp.Id) {
+        modelItem->setCheckState(Qt::Checked);
+        //remove user clear button
+        if (!isUser && !canDelete)
+            return;
+
+        DViewItemActionList actions;
+        modelItem->setActionList(Qt::RightEdge, actions);
+        showInvalidText(modelItem, name, iconName);
+    } else {
+        modelItem->setCheckState(Qt::Unchecked);
+        //add user clear button
+        if (!isUser && !canDelete)
+            return;
+
+        DViewItemActionList btnActList;
+        QPointer<DViewItemAction> delAction(new DViewItemAction(Qt::AlignVCenter | Qt::AlignRight, QSize(21, 21), QSize(19, 19), true));
+
+        delAction->setIcon(DStyleHelper(style()).standardIcon(DStyle::SP_CloseButton, nullptr, this));
+        connect(delAction, &QAction::triggered, this, &DefappDetailWidget::onDelBtnClicked);
+        btnActList << delAction;
+        modelItem->setActionList(Qt::RightEdge, btnActList);
+        m_actionMap.insert(delAction, id);
+        showInvalidText(modelItem, name, iconName);
     }
 }
 
@@ -293,22 +307,14 @@ void DefappDetailWidget::onClearAll()
 {
     int cnt = m_model->rowCount();
     m_model->removeRows(0, cnt);
+    m_items.clear();
     m_systemAppCnt = 0;
     m_userAppCnt = 0;
 }
 
 dcc::defapp::App DefappDetailWidget::getAppById(const QString &appId)
 {
-    auto res = std::find_if(m_category->getappItem().cbegin(), m_category->getappItem().cend(), [ = ] (const dcc::defapp::App &item)->bool{
-        return item.Id == appId;
-    });
-
-    if (res != m_category->getappItem().cend()) {
-        return *res;
-    }
-    dcc::defapp::App app;
-    app.Id = nullptr;
-    return app;
+    return m_category->appById(appId);
 }
 
 void DefappDetailWidget::appendItemData(const dcc::defapp::App &app)
@@ -339,6 +345,7 @@ void DefappDetailWidget::appendItemData(const dcc::defapp::App &app)
         m_systemAppCnt++;
     }
     m_model->insertRow(index, item);
+    m_items.insert(itemKey(app), item);
 }
 
 bool DefappDetailWidget::isDesktopOrBinaryFile(const QString &fileName)
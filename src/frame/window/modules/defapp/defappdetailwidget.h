@@ -27,6 +27,7 @@
 
 #include <QWidget>
 #include <QMap>
+#include <QHash>
 
 namespace dcc {
 namespace defapp {
@@ -64,6 +65,7 @@ public:
 
 private:
     void updateListView(const dcc::defapp::App &defaultApp);
+    void updateItem(DTK_WIDGET_NAMESPACE::DStandardItem *modelItem, const dcc::defapp::App &defaultApp);
     QIcon getAppIcon(const QString &appIcon, const QSize &size);
     dcc::defapp::App getAppById(const QString &appId);
     void appendItemData(const dcc::defapp::App &app);
@@ -106,6 +108,8 @@ private:
     int m_categoryValue;
     dcc::defapp::Category *m_category;
     QMap<DTK_WIDGET_NAMESPACE::DViewItemAction *, QString> m_actionMap;
+    // 以 itemKey() 为键的列表项，增删时不需要遍历模型
+    QHash<QString, DTK_WIDGET_NAMESPACE::DStandardItem *> m_items;
     int m_systemAppCnt;
     int m_userAppCnt;
 };
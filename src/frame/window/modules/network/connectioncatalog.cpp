@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "connectioncatalog.h"
+
+#include <networkmanagerqt/settings.h>
+
+#include <QCoreApplication>
+
+using namespace DCC_NAMESPACE::network;
+
+ConnectionCatalog::ConnectionCatalog(QObject *parent)
+    : QObject(parent)
+{
+    NetworkManager::SettingsNotifier *notifier = NetworkManager::settingsNotifier();
+    connect(notifier, &NetworkManager::SettingsNotifier::connectionAdded, this, &ConnectionCatalog::addConnection);
+    connect(notifier, &NetworkManager::SettingsNotifier::connectionRemoved, this, &ConnectionCatalog::removeConnection);
+
+    for (const NetworkManager::Connection::Ptr &conn : NetworkManager::listConnections())
+        addConnection(conn->path());
+}
+
+ConnectionCatalog *ConnectionCatalog::instance()
+{
+    static ConnectionCatalog *catalog = new ConnectionCatalog(qApp);
+    return catalog;
+}
+
+NetworkManager::Connection::Ptr ConnectionCatalog::connectionByUuid(const QString &uuid) const
+{
+    auto it = m_entries.constFind(m_pathByUuid.value(uuid));
+    if (it == m_entries.constEnd())
+        return NetworkManager::Connection::Ptr();
+
+    return it->connection;
+}
+
+QString ConnectionCatalog::idByUuid(const QString &uuid) const
+{
+    return m_entries.value(m_pathByUuid.value(uuid)).id;
+}
+
+bool ConnectionCatalog::containsId(const QString &id, NetworkManager::ConnectionSettings::ConnectionType type, const QString &exceptUuid) const
+{
+    // 同名的连接通常只有一两个，逐个比较类型即可
+    for (const QString &path : m_pathsById.value(id)) {
+        const Entry &entry = m_entries[path];
+        if (entry.uuid == exceptUuid)
+            continue;
+        if (type == NetworkManager::ConnectionSettings::Unknown || entry.type == type)
+            return true;
+    }
+
+    return false;
+}
+
+int ConnectionCatalog::nextSuffix(const QString &pattern, NetworkManager::ConnectionSettings::ConnectionType type) const
+{
+    int suffix = 1;
+    while (containsId(pattern.arg(suffix), type))
+        ++suffix;
+
+    return suffix;
+}
+
+QString ConnectionCatalog::uniqueId(const QString &id, const QString &exceptUuid) const
+{
+    if (!containsId(id, NetworkManager::ConnectionSettings::Unknown, exceptUuid))
+        return id;
+
+    int suffix = 1;
+    while (containsId(QString("%1(%2)").arg(id).arg(suffix), NetworkManager::ConnectionSettings::Unknown, exceptUuid))
+        ++suffix;
+
+    return QString("%1(%2)").arg(id).arg(suffix);
+}
+
+void ConnectionCatalog::addConnection(const QString &path)
+{
+    if (m_entries.contains(path))
+        return;
+
+    NetworkManager::Connection::Ptr conn = NetworkManager::findConnection(path);
+    if (!conn)
+        return;
+
+    const NetworkManager::ConnectionSettings::Ptr settings = conn->settings();
+    Entry entry { conn, settings->uuid(), settings->id(), settings->connectionType() };
+    m_entries.insert(path, entry);
+    m_pathByUuid.insert(entry.uuid, path);
+    indexId(entry.id, path);
+
+    // 连接被修改后 NetworkManager 只通知该连接自身
+    connect(conn.data(), &NetworkManager::Connection::updated, this, [this, path] {
+        updateConnection(path);
+    });
+
+    Q_EMIT connectionAdded(entry.uuid);
+}
+
+void ConnectionCatalog::removeConnection(const QString &path)
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end())
+        return;
+
+    const Entry entry = it.value();
+    m_entries.erase(it);
+    if (m_pathByUuid.value(entry.uuid) == path)
+        m_pathByUuid.remove(entry.uuid);
+    unindexId(entry.id, path);
+    entry.connection->disconnect(this);
+
+    Q_EMIT connectionRemoved(entry.uuid);
+}
+
+void ConnectionCatalog::updateConnection(const QString &path)
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end())
+        return;
+
+    const QString id = it->connection->name();
+    if (id == it->id)
+        return;
+
+    unindexId(it->id, path);
+    it->id = id;
+    indexId(id, path);
+}
+
+void ConnectionCatalog::indexId(const QString &id, const QString &path)
+{
+    m_pathsById[id].insert(path);
+}
+
+void ConnectionCatalog::unindexId(const QString &id, const QString &path)
+{
+    auto it = m_pathsById.find(id);
+    if (it == m_pathsById.end())
+        return;
+
+    it->remove(path);
+    if (it->isEmpty())
+        m_pathsById.erase(it);
+}
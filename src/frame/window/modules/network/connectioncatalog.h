@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONNECTIONCATALOG_H
+#define CONNECTIONCATALOG_H
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+
+#include <networkmanagerqt/connection.h>
+#include <networkmanagerqt/connectionsettings.h>
+
+namespace DCC_NAMESPACE {
+namespace network {
+
+/**
+ * @brief ConnectionCatalog 已保存连接的索引
+ *
+ * 启动时读取一次连接列表，之后只根据 NetworkManager 的新增、删除和更新信号增量维护，
+ * 按 UUID 和名称建立哈希索引，供查重、名称序号分配等使用。
+ */
+class ConnectionCatalog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ConnectionCatalog *instance();
+
+    NetworkManager::Connection::Ptr connectionByUuid(const QString &uuid) const;
+    bool containsUuid(const QString &uuid) const { return m_pathByUuid.contains(uuid); }
+    QString idByUuid(const QString &uuid) const;
+
+    /**
+     * @brief containsId 是否存在名为 id 的连接
+     * @param type 连接类型，Unknown 表示不区分类型
+     * @param exceptUuid 忽略该 UUID 的连接，用于编辑已有连接时排除自身
+     */
+    bool containsId(const QString &id, NetworkManager::ConnectionSettings::ConnectionType type = NetworkManager::ConnectionSettings::Unknown,
+                    const QString &exceptUuid = QString()) const;
+
+    /**
+     * @brief nextSuffix 返回 pattern.arg(n) 未被同类型连接使用的最小序号 n，pattern 中含有 %1
+     */
+    int nextSuffix(const QString &pattern, NetworkManager::ConnectionSettings::ConnectionType type) const;
+
+    /**
+     * @brief uniqueId 名称未被其它连接使用时原样返回，否则返回 "id(n)" 中最小的可用名称
+     */
+    QString uniqueId(const QString &id, const QString &exceptUuid = QString()) const;
+
+Q_SIGNALS:
+    void connectionAdded(const QString &uuid);
+    void connectionRemoved(const QString &uuid);
+
+private:
+    explicit ConnectionCatalog(QObject *parent = nullptr);
+
+    void addConnection(const QString &path);
+    void removeConnection(const QString &path);
+    void updateConnection(const QString &path);
+    void indexId(const QString &id, const QString &path);
+    void unindexId(const QString &id, const QString &path);
+
+private:
+    struct Entry {
+        NetworkManager::Connection::Ptr connection;
+        QString uuid;
+        QString id;
+        NetworkManager::ConnectionSettings::ConnectionType type;
+    };
+
+    QHash<QString, Entry> m_entries;
+    QHash<QString, QString> m_pathByUuid;
+    QHash<QString, QSet<QString>> m_pathsById;
+};
+
+}
+}
+
+#endif // CONNECTIONCATALOG_H
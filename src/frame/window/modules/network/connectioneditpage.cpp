@@ -20,6 +20,7 @@
  */
 
 #include "connectioneditpage.h"
+#include "connectioncatalog.h"
 #include "widgets/translucentframe.h"
 #include "settings/wiredsettings.h"
 #include "settings/wirelesssettings.h"
@@ -32,6 +33,11 @@
 #include <networkmanagerqt/vpnsetting.h>
 
 #include <DDialog>
+#include <DPasswordEdit>
+#include <DTipLabel>
+
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 
 using namespace dcc::widgets;
 using namespace DCC_NAMESPACE::network;
@@ -57,11 +63,16 @@ ConnectionEditPage::ConnectionEditPage(ConnectionType connType,
     , m_removeBtn(nullptr)
     , m_buttonTuple(new ButtonTuple(ButtonTuple::Save))
     , m_buttonTuple_conn(new ButtonTuple(ButtonTuple::Delete))
+    , m_errorTip(nullptr)
     , m_subPage(nullptr)
     , m_connType(static_cast<NetworkManager::ConnectionSettings::ConnectionType>(connType))
     , m_isNewConnection(false)
     , m_connectionUuid(connUuid)
     , m_isHotSpot(isHotSpot)
+    , m_saveState(SaveState::Idle)
+    , m_saveSerial(0)
+    , m_secretsRequested(false)
+    , m_secretsLoaded(false)
 {
     DevicePath = devPath;
 
@@ -72,14 +83,13 @@ ConnectionEditPage::ConnectionEditPage(ConnectionType connType,
         createConnSettings();
         m_isNewConnection = true;
     } else {
-        m_connection = findConnectionByUuid(m_connectionUuid);
+        m_connection = ConnectionCatalog::instance()->connectionByUuid(m_connectionUuid);
         if (!m_connection) {
             qDebug() << "can't find connection by uuid";
             return;
         }
         m_connectionSettings = m_connection->settings();
         m_isNewConnection = false;
-        initConnectionSecrets();
     }
 
     initHeaderButtons();
@@ -125,6 +135,14 @@ void ConnectionEditPage::initUI()
 //    btnTupleLayout->setMargin(0);
     btnTupleLayout->setSpacing(0);
     btnTupleLayout->setContentsMargins(10, 10, 10, 10);
+
+    // 保存失败时页面保留，在按钮上方显示错误信息
+    DTipLabel *errorTip = new DTipLabel(QString(), this);
+    errorTip->setForegroundRole(DPalette::TextWarning);
+    errorTip->setWordWrap(true);
+    errorTip->setVisible(false);
+    m_errorTip = errorTip;
+    btnTupleLayout->addWidget(m_errorTip);
     btnTupleLayout->addWidget(m_buttonTuple);
     qobject_cast<QVBoxLayout *>(layout())->addLayout(btnTupleLayout);
 
@@ -204,9 +222,10 @@ void ConnectionEditPage::onDeviceRemoved()
 void ConnectionEditPage::initConnection()
 {
     connect(m_buttonTuple->rightButton(), &QPushButton::clicked, this, &ConnectionEditPage::saveConnSettings);
-    connect(m_buttonTuple->leftButton(), &QPushButton::clicked, this, &ConnectionEditPage::back);
-    connect(this, &ConnectionEditPage::saveSettingsDone, this, &ConnectionEditPage::prepareConnection);
-    connect(this, &ConnectionEditPage::prepareConnectionDone, this, &ConnectionEditPage::updateConnection);
+    connect(m_buttonTuple->leftButton(), &QPushButton::clicked, this, [this] {
+        cancelSave();
+        Q_EMIT back();
+    });
 
     if (m_frame) {
         connect(this, &ConnectionEditPage::back, std::bind(&dccV20::FrameProxyInterface::popWidget, m_frame, nullptr));
@@ -234,45 +253,53 @@ void ConnectionEditPage::initConnection()
     });
 }
 
-NMVariantMapMap ConnectionEditPage::secretsMapMapBySettingType(NetworkManager::Setting::SettingType settingType)
+void ConnectionEditPage::onRequestNextPage(dcc::ContentWidget *const page)
 {
-    QDBusPendingReply<NMVariantMapMap> reply;
-    reply = m_connection->secrets(m_connectionSettings->setting(settingType)->name());
+    m_subPage = page;
 
-    reply.waitForFinished();
-    if (reply.isError() || !reply.isValid()) {
-        qDebug() << "get secrets error for connection:" << reply.error();
-    }
+    Q_EMIT requestNextPage(page);
+}
+
+void ConnectionEditPage::showEvent(QShowEvent *event)
+{
+    ContentWidget::showEvent(event);
 
-    return reply.value();
+    if (!m_secretsRequested && !m_isNewConnection && m_connection)
+        watchSecretFields();
 }
 
-template <typename T>
-void ConnectionEditPage::setSecretsFromMapMap(NetworkManager::Setting::SettingType settingType, NMVariantMapMap secretsMapMap)
+bool ConnectionEditPage::eventFilter(QObject *watched, QEvent *event)
 {
-    QSharedPointer<T> setting = m_connectionSettings->setting(settingType).staticCast<T>();
-    setting->secretsFromMap(secretsMapMap.value(setting->name()));
+    if (event->type() == QEvent::Show && !m_secretsRequested && qobject_cast<DPasswordEdit *>(watched))
+        requestConnectionSecrets();
+
+    return ContentWidget::eventFilter(watched, event);
 }
 
-void ConnectionEditPage::onRequestNextPage(dcc::ContentWidget *const page)
+void ConnectionEditPage::watchSecretFields()
 {
-    m_subPage = page;
+    if (!m_settingsWidget)
+        return;
 
-    Q_EMIT requestNextPage(page);
+    // 密码只在输入框真正显示时才向 NetworkManager 获取，例如切换到需要密码的认证方式后
+    for (DPasswordEdit *edit : m_settingsWidget->findChildren<DPasswordEdit *>()) {
+        if (edit->isVisible()) {
+            requestConnectionSecrets();
+            return;
+        }
+        edit->installEventFilter(this);
+    }
 }
 
-void ConnectionEditPage::initConnectionSecrets()
+NetworkManager::Setting::Ptr ConnectionEditPage::secretSetting() const
 {
     NetworkManager::Setting::SettingType sType;
-    NMVariantMapMap sSecretsMapMap;
 
     switch (m_connType) {
     case NetworkManager::ConnectionSettings::ConnectionType::Wired: {
         sType = NetworkManager::Setting::SettingType::Security8021x;
-        if (!m_connectionSettings->setting(sType).staticCast<NetworkManager::Security8021xSetting>()->eapMethods().isEmpty()) {
-            sSecretsMapMap = secretsMapMapBySettingType(sType);
-            setSecretsFromMapMap<NetworkManager::Security8021xSetting>(sType, sSecretsMapMap);
-        }
+        if (m_connectionSettings->setting(sType).staticCast<NetworkManager::Security8021xSetting>()->eapMethods().isEmpty())
+            return NetworkManager::Setting::Ptr();
         break;
     }
     case NetworkManager::ConnectionSettings::ConnectionType::Wireless: {
@@ -282,91 +309,197 @@ void ConnectionEditPage::initConnectionSecrets()
             m_connectionSettings->setting(sType).staticCast<NetworkManager::WirelessSecuritySetting>()->keyMgmt();
         if (keyMgmt == NetworkManager::WirelessSecuritySetting::KeyMgmt::WpaNone
                 || keyMgmt == NetworkManager::WirelessSecuritySetting::KeyMgmt::Unknown) {
-            break;
+            return NetworkManager::Setting::Ptr();
         }
 
         if (keyMgmt == NetworkManager::WirelessSecuritySetting::KeyMgmt::WpaEap) {
             sType = NetworkManager::Setting::SettingType::Security8021x;
         }
-        sSecretsMapMap = secretsMapMapBySettingType(sType);
-        setSecretsFromMapMap<NetworkManager::WirelessSecuritySetting>(sType, sSecretsMapMap);
         break;
     }
     case NetworkManager::ConnectionSettings::ConnectionType::Vpn: {
         sType = NetworkManager::Setting::SettingType::Vpn;
-        sSecretsMapMap = secretsMapMapBySettingType(sType);
-        setSecretsFromMapMap<NetworkManager::VpnSetting>(sType, sSecretsMapMap);
         break;
     }
     case NetworkManager::ConnectionSettings::ConnectionType::Pppoe: {
         sType = NetworkManager::Setting::SettingType::Pppoe;
-        sSecretsMapMap = secretsMapMapBySettingType(sType);
-        setSecretsFromMapMap<NetworkManager::PppoeSetting>(sType, sSecretsMapMap);
         break;
     }
     default:
-        break;
+        return NetworkManager::Setting::Ptr();
     }
+
+    return m_connectionSettings->setting(sType);
+}
+
+void ConnectionEditPage::requestConnectionSecrets()
+{
+    m_secretsRequested = true;
+
+    NetworkManager::Setting::Ptr setting = secretSetting();
+    if (!setting)
+        return;
+
+    // 密码取回前禁止编辑，取回后重建界面，避免用户的输入被覆盖
+    if (m_settingsWidget)
+        m_settingsWidget->setEnabled(false);
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_connection->secrets(setting->name()), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, setting] {
+        watcher->deleteLater();
+
+        QDBusPendingReply<NMVariantMapMap> reply = *watcher;
+        if (reply.isError() || !reply.isValid()) {
+            qDebug() << "get secrets error for connection:" << reply.error();
+            if (m_settingsWidget)
+                m_settingsWidget->setEnabled(true);
+            return;
+        }
+
+        setting->secretsFromMap(reply.value().value(setting->name()));
+        m_secretsLoaded = true;
+        if (m_settingsWidget)
+            resetSettingsWidget();
+    });
+}
+
+void ConnectionEditPage::resetSettingsWidget()
+{
+    m_settingsLayout->removeWidget(m_settingsWidget);
+    m_settingsWidget->deleteLater();
+    m_settingsWidget = nullptr;
+
+    initSettingsWidget();
 }
 
 void ConnectionEditPage::saveConnSettings()
 {
+    if (m_saveState != SaveState::Idle)
+        return;
+
+    if (!m_isNewConnection && !m_secretsLoaded && m_connection) {
+        fetchSecretsBeforeSave();
+        return;
+    }
+
     if (!m_settingsWidget->allInputValid()) {
         return;
     }
 
+    ++m_saveSerial;
+    m_errorTip->setVisible(false);
+    setSaveState(SaveState::Deactivating);
+
+    // 配置先写入 m_connectionSettings，等待期间界面不再影响本次保存
+    m_settingsWidget->saveSettings();
+
+    // deactivate this device's ActiveConnection
+    QList<QDBusPendingCall> deactivateCalls;
     if (m_settingsWidget->isAutoConnect()) {
-        // deactivate this device's ActiveConnection
-        QDBusPendingReply<> reply;
         for (auto aConn : activeConnections()) {
-            for (auto devPath : aConn->devices()) {
-                if (devPath == DevicePath) {
-                    reply = deactivateConnection(aConn->path());
-                    reply.waitForFinished();
-                    if (reply.isError()) {
-                        qDebug() << "error occurred while deactivate connection" << reply.error();
-                    }
-                }
-            }
+            if (aConn->devices().contains(DevicePath))
+                deactivateCalls << deactivateConnection(aConn->path());
         }
     }
 
+    if (deactivateCalls.isEmpty()) {
+        prepareConnection();
+        return;
+    }
+
+    QSharedPointer<int> pending(new int(deactivateCalls.size()));
+    for (const QDBusPendingCall &call : deactivateCalls) {
+        watchSaveCall(call, [this, pending](QDBusPendingCallWatcher *watcher) {
+            if (watcher->isError()) {
+                qDebug() << "error occurred while deactivate connection" << watcher->error();
+            }
+            if (--*pending == 0)
+                prepareConnection();
+        });
+    }
+}
+
+void ConnectionEditPage::fetchSecretsBeforeSave()
+{
+    // 界面上的修改先写入配置，重建界面后不会丢失
     m_settingsWidget->saveSettings();
 
-    Q_EMIT saveSettingsDone();
+    NetworkManager::Setting::Ptr setting = secretSetting();
+    if (!setting) {
+        m_secretsLoaded = true;
+        saveConnSettings();
+        return;
+    }
+
+    ++m_saveSerial;
+    m_errorTip->setVisible(false);
+    setSaveState(SaveState::FetchingSecrets);
+    watchSaveCall(m_connection->secrets(setting->name()), [this, setting](QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<NMVariantMapMap> reply = *watcher;
+        if (reply.isError() || !reply.isValid()) {
+            // 没有保存密码时也会返回错误，按界面上的内容保存
+            qDebug() << "get secrets error before saving:" << reply.error();
+        } else {
+            // 界面上填写过的密码优先，其余使用已保存的密码
+            QVariantMap secrets = reply.value().value(setting->name());
+            const QVariantMap edited = setting->secretsToMap();
+            for (auto it = edited.constBegin(); it != edited.constEnd(); ++it) {
+                if (!it.value().toString().isEmpty())
+                    secrets.insert(it.key(), it.value());
+            }
+            setting->secretsFromMap(secrets);
+        }
+
+        m_secretsLoaded = true;
+        m_secretsRequested = true;
+        setSaveState(SaveState::Idle);
+        resetSettingsWidget();
+        saveConnSettings();
+    });
 }
 
 void ConnectionEditPage::prepareConnection()
 {
-    if (!m_connection) {
-        qDebug() << "preparing connection...";
-        QDBusPendingReply<QDBusObjectPath> reply = addConnection(m_connectionSettings->toMap());
-        reply.waitForFinished();
-        const QString &connPath = reply.value().path();
-        m_connection = findConnection(connPath);
+    if (m_connection) {
+        updateConnection();
+        return;
+    }
+
+    qDebug() << "preparing connection...";
+    setSaveState(SaveState::Adding);
+    watchSaveCall(addConnection(m_connectionSettings->toMap()), [this](QDBusPendingCallWatcher *watcher) {
+        QDBusPendingReply<QDBusObjectPath> reply = *watcher;
+        if (reply.isError()) {
+            failSave(tr("Failed to save settings: %1").arg(reply.error().message()));
+            return;
+        }
+
+        m_connection = findConnection(reply.value().path());
         if (!m_connection) {
-            qDebug() << "create connection failed..." << reply.error();
-            Q_EMIT back();
+            failSave(tr("Failed to save settings: %1").arg(QString("can't find connection %1").arg(reply.value().path())));
             return;
         }
-    }
 
-    Q_EMIT prepareConnectionDone();
+        updateConnection();
+    });
 }
 
 void ConnectionEditPage::updateConnection()
 {
-    QDBusPendingReply<> reply;
-
     // update function saves the settings on the hard disk
-    reply = m_connection->update(m_connectionSettings->toMap());
-    reply.waitForFinished();
-    if (reply.isError()) {
-        qDebug() << "error occurred while updating the connection" << reply.error();
-        Q_EMIT back();
-        return;
-    }
+    setSaveState(SaveState::Updating);
+    watchSaveCall(m_connection->update(m_connectionSettings->toMap()), [this](QDBusPendingCallWatcher *watcher) {
+        if (watcher->isError()) {
+            failSave(tr("Failed to save settings: %1").arg(watcher->error().message()));
+            return;
+        }
+
+        activateSavedConnection();
+    });
+}
 
+void ConnectionEditPage::activateSavedConnection()
+{
     if (m_settingsWidget->isAutoConnect()) {
         if (static_cast<int>(m_connType) == static_cast<int>(ConnectionEditPage::WiredConnection)) {
             Q_EMIT activateWiredConnection(m_connection->path(), m_connectionUuid);
@@ -374,17 +507,67 @@ void ConnectionEditPage::updateConnection()
             if (static_cast<int>(m_connType) == static_cast<int>(ConnectionEditPage::WirelessConnection)) {
                 Q_EMIT activateWirelessConnection(m_connectionSettings->id(), m_connectionUuid);
             }
-            reply = activateConnection(m_connection->path(), DevicePath, "");
-            reply.waitForFinished();
-            if (reply.isError()) {
-                qDebug() << "error occurred while activate connection" << reply.error();
-            }
+
+            // 激活请求被接受后返回，连接过程不再阻塞页面
+            setSaveState(SaveState::Activating);
+            watchSaveCall(activateConnection(m_connection->path(), DevicePath, ""), [this](QDBusPendingCallWatcher *watcher) {
+                if (watcher->isError()) {
+                    failSave(tr("Settings saved, but failed to connect: %1").arg(watcher->error().message()));
+                    return;
+                }
+
+                setSaveState(SaveState::Idle);
+                Q_EMIT back();
+            });
+            return;
         }
     }
 
+    setSaveState(SaveState::Idle);
     Q_EMIT back();
 }
 
+void ConnectionEditPage::setSaveState(SaveState state)
+{
+    m_saveState = state;
+
+    // 保存过程中只能取消
+    m_buttonTuple->rightButton()->setEnabled(state == SaveState::Idle);
+    if (m_settingsWidget)
+        m_settingsWidget->setEnabled(state == SaveState::Idle);
+}
+
+void ConnectionEditPage::cancelSave()
+{
+    if (m_saveState == SaveState::Idle)
+        return;
+
+    qDebug() << "connection saving canceled, state:" << static_cast<int>(m_saveState);
+    ++m_saveSerial;
+    setSaveState(SaveState::Idle);
+}
+
+void ConnectionEditPage::failSave(const QString &message)
+{
+    qWarning() << "save connection failed, state:" << static_cast<int>(m_saveState) << message;
+    setSaveState(SaveState::Idle);
+
+    m_errorTip->setText(message);
+    m_errorTip->setVisible(true);
+    Q_EMIT saveFailed(message);
+}
+
+void ConnectionEditPage::watchSaveCall(const QDBusPendingCall &call, std::function<void(QDBusPendingCallWatcher *)> callback)
+{
+    const int serial = m_saveSerial;
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, serial, callback] {
+        watcher->deleteLater();
+        if (serial == m_saveSerial)
+            callback(watcher);
+    });
+}
+
 void ConnectionEditPage::createConnSettings()
 {
     m_connectionSettings = QSharedPointer<NetworkManager::ConnectionSettings>(
@@ -418,7 +601,7 @@ void ConnectionEditPage::createConnSettings()
         m_connectionSettings->setId(connName.arg(connectionSuffixNum(connName)));
     }
     m_connectionUuid = m_connectionSettings->createNewUuid();
-    while (findConnectionByUuid(m_connectionUuid) != nullptr) {
+    while (ConnectionCatalog::instance()->containsUuid(m_connectionUuid)) {
         qint64 second = QDateTime::currentDateTime().toSecsSinceEpoch();
         m_connectionUuid.replace(24, QString::number(second).length(), QString::number(second));
     }
@@ -431,26 +614,7 @@ int ConnectionEditPage::connectionSuffixNum(const QString &matchConnName)
         return 0;
     }
 
-    NetworkManager::Connection::List connList = listConnections();
-    QStringList connNameList;
-    int connSuffixNum = 1;
-
-    for (auto conn : connList) {
-        if (conn->settings()->connectionType() == m_connType) {
-            connNameList.append(conn->name());
-        }
-    }
-
-    for (int i = 1; i <= connNameList.size(); ++i) {
-        if (!connNameList.contains(matchConnName.arg(i))) {
-            connSuffixNum = i;
-            break;
-        } else if (i == connNameList.size()) {
-            connSuffixNum = i + 1;
-        }
-    }
-
-    return connSuffixNum;
+    return ConnectionCatalog::instance()->nextSuffix(matchConnName, m_connType);
 }
 
 void ConnectionEditPage::addHeaderButton(QPushButton *button)
@@ -29,6 +29,7 @@
 #include "interface/moduleinterface.h"
 #include "interface/namespace.h"
 
+#include <QDBusPendingCall>
 #include <QPointer>
 #include <QPushButton>
 #include <QVBoxLayout>
@@ -36,6 +37,11 @@
 #include <networkmanagerqt/connection.h>
 #include <networkmanagerqt/connectionsettings.h>
 
+#include <functional>
+
+class QDBusPendingCallWatcher;
+class QLabel;
+
 namespace DCC_NAMESPACE {
 namespace network {
 
@@ -72,12 +78,14 @@ Q_SIGNALS:
     void requestWiredDeviceEnabled(const QString &devPath, const bool enabled) const;
     void activateWiredConnection(const QString &connString, const QString &uuid);
     void activateWirelessConnection(const QString &ssid, const QString &uuid);
-    // private signals
-    void saveSettingsDone();
-    void prepareConnectionDone();
     void disconnect(const QString &uuid);
+    // 保存或激活失败时页面保留并显示错误，message 含 NetworkManager 返回的错误信息
+    void saveFailed(const QString &message);
 
 protected:
+    void showEvent(QShowEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
     int connectionSuffixNum(const QString &matchConnName);
     void addHeaderButton(QPushButton *button);
 
@@ -85,16 +93,27 @@ private:
     void initUI();
     void initHeaderButtons();
     void initConnection();
-    void initConnectionSecrets();
+    void createConnSettings();
+
+    // 保存流程：断开设备上的连接 -> 新建连接 -> 写入配置，每一步都是异步调用，最后发起激活；
+    // 已有连接的密码还没有取回时先取回密码再保存
+    enum class SaveState { Idle, FetchingSecrets, Deactivating, Adding, Updating, Activating };
     void saveConnSettings();
+    void fetchSecretsBeforeSave();
     void prepareConnection();
     void updateConnection();
-    void createConnSettings();
-
-    NMVariantMapMap secretsMapMapBySettingType(NetworkManager::Setting::SettingType settingType);
-    // T means a NetworkManager::Setting subclass, like NetworkManager::WirelessSecuritySetting
-    template <typename T>
-    void setSecretsFromMapMap(NetworkManager::Setting::SettingType settingType, NMVariantMapMap secretsMapMap);
+    void activateSavedConnection();
+    void setSaveState(SaveState state);
+    void cancelSave();
+    void failSave(const QString &message);
+    // 回调只在本次保存未被取消时执行
+    void watchSaveCall(const QDBusPendingCall &call, std::function<void(QDBusPendingCallWatcher *)> callback);
+
+    NetworkManager::Setting::Ptr secretSetting() const;
+    // 密码输入框首次显示时才获取密码
+    void watchSecretFields();
+    void requestConnectionSecrets();
+    void resetSettingsWidget();
 
 protected Q_SLOTS:
     void onRequestNextPage(ContentWidget *const page);
@@ -115,6 +134,7 @@ private:
     QPushButton *m_removeBtn;
     dcc::widgets::ButtonTuple *m_buttonTuple;
     dcc::widgets::ButtonTuple *m_buttonTuple_conn;
+    QLabel *m_errorTip;
 
     QPointer<ContentWidget> m_subPage;
 
@@ -123,6 +143,12 @@ private:
     bool m_isNewConnection;
     QString m_connectionUuid;
     bool m_isHotSpot;
+
+    SaveState m_saveState;
+    int m_saveSerial;
+    bool m_secretsRequested;
+    // 密码已合并到 m_connectionSettings，保存时不会把未显示的密码写成空值
+    bool m_secretsLoaded;
 };
 
 } /* network */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "loadingitemdelegate.h"
+
+#include <QAbstractItemView>
+#include <QPainter>
+#include <QTimer>
+
+using namespace DCC_NAMESPACE::network;
+DWIDGET_USE_NAMESPACE
+
+static const int SpinnerSize = 20;
+static const int SpinnerRightMargin = 10;
+static const int SpinnerStep = 12;
+
+LoadingItemDelegate::LoadingItemDelegate(QAbstractItemView *parent)
+    : DStyledItemDelegate(parent)
+    , m_view(parent)
+    , m_timer(new QTimer(this))
+    , m_angle(0)
+{
+    m_timer->setInterval(1000 / 30);
+    connect(m_timer, &QTimer::timeout, this, &LoadingItemDelegate::onTimeout);
+}
+
+void LoadingItemDelegate::setLoading(const QModelIndex &index, bool loading)
+{
+    if (!index.isValid() || isLoading(index) == loading)
+        return;
+
+    if (loading)
+        m_loadingIndexes.append(index);
+    else
+        m_loadingIndexes.removeAll(index);
+
+    m_view->update(index);
+
+    if (m_loadingIndexes.isEmpty())
+        m_timer->stop();
+    else if (!m_timer->isActive())
+        m_timer->start();
+}
+
+bool LoadingItemDelegate::isLoading(const QModelIndex &index) const
+{
+    return m_loadingIndexes.contains(index);
+}
+
+void LoadingItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    DStyledItemDelegate::paint(painter, option, index);
+
+    if (!isLoading(index))
+        return;
+
+    QRect rect(0, 0, SpinnerSize, SpinnerSize);
+    rect.moveCenter(QPoint(option.rect.right() - SpinnerRightMargin - SpinnerSize / 2, option.rect.center().y()));
+
+    QPen pen(option.palette.color(QPalette::Highlight), 2);
+    pen.setCapStyle(Qt::RoundCap);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(pen);
+    painter->drawArc(rect.adjusted(2, 2, -2, -2), -m_angle * 16, 270 * 16);
+    painter->restore();
+}
+
+void LoadingItemDelegate::onTimeout()
+{
+    m_angle = (m_angle + SpinnerStep) % 360;
+
+    // 行被删除后持久索引失效，顺便清理
+    for (auto it = m_loadingIndexes.begin(); it != m_loadingIndexes.end();) {
+        if (it->isValid()) {
+            m_view->update(*it);
+            ++it;
+        } else {
+            it = m_loadingIndexes.erase(it);
+        }
+    }
+
+    if (m_loadingIndexes.isEmpty())
+        m_timer->stop();
+}
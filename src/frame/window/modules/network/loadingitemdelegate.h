@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOADINGITEMDELEGATE_H
+#define LOADINGITEMDELEGATE_H
+
+#include "interface/namespace.h"
+
+#include <DStyledItemDelegate>
+
+#include <QPersistentModelIndex>
+
+class QTimer;
+
+namespace DCC_NAMESPACE {
+namespace network {
+
+/**
+ * @brief LoadingItemDelegate 在行的右侧绘制加载动画
+ *
+ * 所有行共用一个定时器，只重绘处于加载状态的行，代替每行一个 DSpinner 控件。
+ */
+class LoadingItemDelegate : public DTK_WIDGET_NAMESPACE::DStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit LoadingItemDelegate(QAbstractItemView *parent);
+
+    void setLoading(const QModelIndex &index, bool loading);
+    bool isLoading(const QModelIndex &index) const;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    void onTimeout();
+
+private:
+    QAbstractItemView *m_view;
+    QTimer *m_timer;
+    int m_angle;
+    QList<QPersistentModelIndex> m_loadingIndexes;
+};
+
+}
+}
+
+#endif // LOADINGITEMDELEGATE_H
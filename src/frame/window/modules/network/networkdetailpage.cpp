@@ -24,6 +24,7 @@
  */
 
 #include "networkdetailpage.h"
+#include "connectioncatalog.h"
 #include "widgets/settingshead.h"
 #include "widgets/settingsgroup.h"
 #include "widgets/settingsheaderitem.h"
@@ -41,7 +42,6 @@
 #include <QDebug>
 #include <QJsonArray>
 #include <DFontSizeManager>
-#include <QDBusInterface>
 #include <QDBusPendingCallWatcher>
 #include <QDBusPendingCall>
 #include <QDBusPendingReply>
@@ -88,6 +88,7 @@ namespace network {
 
 NetworkDetailPage::NetworkDetailPage(QWidget *parent)
     : ContentWidget(parent)
+    , m_infoSerial(0)
 {
     m_groupsLayout = new QVBoxLayout;
     m_groupsLayout->setSpacing(0);
@@ -100,170 +101,241 @@ NetworkDetailPage::NetworkDetailPage(QWidget *parent)
     setTitle(tr("Network Details"));
     layout()->setMargin(0);
     setContent(mainWidget);
+
+    m_networkInter = dcc::DBusProxyRegistry::instance()->proxy(QDBusConnection::sessionBus(),
+                                                               "com.deepin.daemon.Network",
+                                                               "/com/deepin/daemon/Network",
+                                                               "com.deepin.daemon.Network");
+    // 连接或设备信息变化（如 DHCP 续约、链路变化）时重新获取，界面只更新变化的字段
+    connect(m_networkInter.data(), &dcc::DBusObjectProxy::propertyChanged, this, [this](const QString &name) {
+        if (name == "ActiveConnections" || name == "Devices")
+            updateNetworkInfo();
+    });
 }
 
 void NetworkDetailPage::updateNetworkInfo()
 {
-   QDBusInterface *networkInter = new QDBusInterface("com.deepin.daemon.Network",
-                                                     "/com/deepin/daemon/Network",
-                                                     "com.deepin.daemon.Network",
-                                                     QDBusConnection::sessionBus(), this);
-   QDBusPendingCall async = networkInter->asyncCall("GetActiveConnectionInfo");
-   QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(async, this);
-   connect(w, &QDBusPendingCallWatcher::finished, this, [this, w](){
-       QDBusPendingReply<QString> reply = *w;
-       if (reply.isError()) {
-           qDebug() << "GetActiveConnectionInfo error";
-           return;
-       }
-       QList<QJsonObject> activeinfos;
-       QJsonArray activeConns = QJsonDocument::fromJson(reply.value().toUtf8()).array();
-       for (const auto info : activeConns)
-       {
-           const auto &connInfo = info.toObject();
-           activeinfos << connInfo;
-       }
-       onActiveInfoChanged(activeinfos);
-       w->deleteLater();
-   });
+    const int serial = ++m_infoSerial;
+    QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(m_networkInter->asyncCall("GetActiveConnectionInfo"), this);
+    connect(w, &QDBusPendingCallWatcher::finished, this, [this, w, serial] {
+        w->deleteLater();
+
+        // 只处理最后一次请求的结果
+        if (serial != m_infoSerial)
+            return;
+
+        QDBusPendingReply<QString> reply = *w;
+        if (reply.isError()) {
+            qDebug() << "GetActiveConnectionInfo error";
+            return;
+        }
+        QList<QJsonObject> activeinfos;
+        QJsonArray activeConns = QJsonDocument::fromJson(reply.value().toUtf8()).array();
+        for (const auto info : activeConns)
+        {
+            const auto &connInfo = info.toObject();
+            activeinfos << connInfo;
+        }
+        onActiveInfoChanged(activeinfos);
+    });
 }
 
 void NetworkDetailPage::onActiveInfoChanged(const QList<QJsonObject> &infos)
 {
-    auto appendInfo = [](SettingsGroup *g, const QString &t, const QString &v) {
-        TitleValueItem *i = new TitleValueItem;
-        i->setTitle(t);
-        i->setValue(v);
-        g->appendItem(i);
-        if (t == "IPv6") {
-            i->setWordWrap(false);
+    QStringList keys;
+    for (const auto &info : infos) {
+        QString key = info.value("DeviceInterface").toString();
+        if (key.isEmpty())
+            key = info.value("ConnectionUuid").toString();
+        // 同一设备上有多个连接时（如热点）用序号区分
+        while (keys.contains(key))
+            key += "#";
+        keys << key;
+
+        auto it = m_groups.find(key);
+        if (it == m_groups.end()) {
+            DetailGroup group;
+            group.group = new SettingsGroup;
+            group.head = new SettingsHead;
+            group.head->setEditEnable(false);
+            group.head->setContentsMargins(20, 0, 0, 0);
+            group.group->appendItem(group.head, SettingsGroup::NoneBackground);
+            it = m_groups.insert(key, group);
         }
-    };
 
-    // clear old infos
-    while (QLayoutItem *item = m_groupsLayout->takeAt(0)) {
-        if (item->widget()) {
-            item->widget()->deleteLater();
+        const bool isHotspot = info.value("ConnectionType").toString() == "wireless-hotspot";
+        const QString title = isHotspot ? tr("Hotspot") : info.value("ConnectionName").toString();
+        if (it->title != title) {
+            it->title = title;
+            it->head->setTitle(title);
         }
-        delete item;
+
+        updateGroup(*it, detailRows(info));
     }
 
-    int infoCount = infos.count();
-    for (const auto &info : infos) {
-        SettingsGroup *grp = new SettingsGroup;
-        const QString type = info.value("ConnectionType").toString();
-        const bool isHotspot = type == "wireless-hotspot";
-        const bool isWireless = type == "wireless";
-        const QJsonObject &hotspotInfo = info.value("Hotspot").toObject();
-
-        // 设置活跃网络标题
-        SettingsHead *head = new SettingsHead;
-        head->setEditEnable(false);
-        head->setContentsMargins(20,0,0,0);
-
-        if (isHotspot) {
-            head->setTitle(tr("Hotspot"));
-            grp->appendItem(head, SettingsGroup::NoneBackground);
-
-            const QString ssid = hotspotInfo.value("Ssid").toString();
-            appendInfo(grp, tr("SSID"), ssid);
+    for (auto it = m_groups.begin(); it != m_groups.end();) {
+        if (keys.contains(it.key())) {
+            ++it;
         } else {
-            const QString name = info.value("ConnectionName").toString();
-            head->setTitle(name);
-            grp->appendItem(head, SettingsGroup::NoneBackground);
+            it->group->deleteLater();
+            it = m_groups.erase(it);
         }
+    }
 
-        if (isWireless) {
-            // protocol
-            const QString &protocol = info.value("Protocol").toString();
-            if (!protocol.isEmpty())
-                appendInfo(grp, tr("Protocol"), protocol);
-
-            // security type
-            const QString &securityType = info.value("Security").toString();
-            appendInfo(grp, tr("Security Type"), securityType);
-
-            // band
-            const QString &band = hotspotInfo.value("Band").toString();
-            QString bandInfo = band == "a" ? "5G" : (band == "bg" ? "2.4G" : "automatic");
-            appendInfo(grp, tr("Band"), bandInfo);
-
-            // channel
-            const QString &channel = QString::number(hotspotInfo.value("Channel").toInt());
-            if (!channel.isEmpty())
-                appendInfo(grp, tr("Channel"), channel);
-        }
+    // 分组的增删和顺序变化才需要重新排列
+    if (keys != m_groupOrder) {
+        m_groupOrder = keys;
+
+        while (QLayoutItem *item = m_groupsLayout->takeAt(0))
+            delete item;
 
-        // encrypt method
-        if (isHotspot) {
-            const QString securityType = info.value("Security").toString();
-            appendInfo(grp, tr("Security Type"), securityType);
+        for (int i = 0; i < keys.size(); ++i) {
+            if (i > 0)
+                m_groupsLayout->addSpacing(30);
+            m_groupsLayout->addWidget(m_groups.value(keys.at(i)).group);
         }
-        // device interface
-        const auto device = info.value("DeviceInterface").toString();
-        if (!device.isEmpty())
-            appendInfo(grp, tr("Interface"), device);
-        // mac info
-        const QString mac = info.value("HwAddress").toString();
-        if (!mac.isEmpty())
-            appendInfo(grp, tr("MAC"), mac);
+        m_groupsLayout->addStretch();
+    }
+}
+
+NetworkDetailPage::DetailRows NetworkDetailPage::detailRows(const QJsonObject &info)
+{
+    DetailRows rows;
+    auto appendInfo = [&rows](const QString &t, const QString &v) {
+        rows << qMakePair(t, v);
+    };
+
+    const QString type = info.value("ConnectionType").toString();
+    const bool isHotspot = type == "wireless-hotspot";
+    const bool isWireless = type == "wireless";
+    const QJsonObject &hotspotInfo = info.value("Hotspot").toObject();
+
+    if (isHotspot) {
+        const QString ssid = hotspotInfo.value("Ssid").toString();
+        appendInfo(tr("SSID"), ssid);
+    }
+
+    if (isWireless) {
+        // protocol
+        const QString &protocol = info.value("Protocol").toString();
+        if (!protocol.isEmpty())
+            appendInfo(tr("Protocol"), protocol);
+
+        // security type
+        const QString &securityType = info.value("Security").toString();
+        appendInfo(tr("Security Type"), securityType);
+
         // band
-        if (isHotspot) {
-            const QString band = hotspotInfo.value("Band").toString();
-            appendInfo(grp, tr("Band"), band);
-        } else {
-            // ipv4 info
-            const auto ipv4 = info.value("Ip4").toObject();
-            if (!ipv4.isEmpty()) {
-                // ipv4 address
-                const auto ip4Addr = ipv4.value("Address").toString();
-                if (!ip4Addr.isEmpty())
-                    appendInfo(grp, tr("IPv4"), ip4Addr);
-                // ipv4 gateway
-                const auto gateway = ipv4.value("Gateways").toArray();
-                if (!gateway.isEmpty())
-                    appendInfo(grp, tr("Gateway"), gateway.first().toString());
-                // ipv4 primary dns
-                const auto ip4PrimaryDns = ipv4.value("Dnses").toArray();
-                if (!ip4PrimaryDns.isEmpty())
-                    appendInfo(grp, tr("Primary DNS"), ip4PrimaryDns.first().toString());
-                // ipv4 netmask
-                const auto ip4Netmask = ipv4.value("Mask").toString();
-                if (!ip4Netmask.isEmpty())
-                    appendInfo(grp, tr("Netmask"), ip4Netmask);
-            }
-            // ipv6 info
-            const auto ipv6 = info.value("Ip6").toObject();
-            if (!ipv6.isEmpty()) {
-                appendInfo(grp, tr("IPv6"), compressedIpv6Addr(ipv6Infomation(info, NetworkDetailPage::Ip)));
-                appendInfo(grp, tr("Gateway"), compressedIpv6Addr(ipv6Infomation(info, NetworkDetailPage::Gateway)));
-
-                // ipv6 primary dns
-                const auto ip6PrimaryDns = ipv6.value("Dnses").toArray();
-                if (!ip6PrimaryDns.isEmpty())
-                    appendInfo(grp, tr("Primary DNS"), compressedIpv6Addr(ip6PrimaryDns.first().toString()));
-                // ipv6 netmask
-                const auto ip6Prefix = ipv6.value("Prefix").toString();
-                if (!ip6Prefix.isEmpty())
-                    appendInfo(grp, tr("Prefix"), ip6Prefix);
-            }
-            // speed info
-            const QString speed = info.value("Speed").toString();
-            if (!speed.isEmpty())
-                appendInfo(grp, tr("Speed"), speed);
+        const QString &band = hotspotInfo.value("Band").toString();
+        QString bandInfo = band == "a" ? "5G" : (band == "bg" ? "2.4G" : "automatic");
+        appendInfo(tr("Band"), bandInfo);
+
+        // channel
+        const QString &channel = QString::number(hotspotInfo.value("Channel").toInt());
+        if (!channel.isEmpty())
+            appendInfo(tr("Channel"), channel);
+    }
+
+    // encrypt method
+    if (isHotspot) {
+        const QString securityType = info.value("Security").toString();
+        appendInfo(tr("Security Type"), securityType);
+    }
+    // device interface
+    const auto device = info.value("DeviceInterface").toString();
+    if (!device.isEmpty())
+        appendInfo(tr("Interface"), device);
+    // mac info
+    const QString mac = info.value("HwAddress").toString();
+    if (!mac.isEmpty())
+        appendInfo(tr("MAC"), mac);
+    // band
+    if (isHotspot) {
+        const QString band = hotspotInfo.value("Band").toString();
+        appendInfo(tr("Band"), band);
+    } else {
+        // ipv4 info
+        const auto ipv4 = info.value("Ip4").toObject();
+        if (!ipv4.isEmpty()) {
+            // ipv4 address
+            const auto ip4Addr = ipv4.value("Address").toString();
+            if (!ip4Addr.isEmpty())
+                appendInfo(tr("IPv4"), ip4Addr);
+            // ipv4 gateway
+            const auto gateway = ipv4.value("Gateways").toArray();
+            if (!gateway.isEmpty())
+                appendInfo(tr("Gateway"), gateway.first().toString());
+            // ipv4 primary dns
+            const auto ip4PrimaryDns = ipv4.value("Dnses").toArray();
+            if (!ip4PrimaryDns.isEmpty())
+                appendInfo(tr("Primary DNS"), ip4PrimaryDns.first().toString());
+            // ipv4 netmask
+            const auto ip4Netmask = ipv4.value("Mask").toString();
+            if (!ip4Netmask.isEmpty())
+                appendInfo(tr("Netmask"), ip4Netmask);
+        }
+        // ipv6 info
+        const auto ipv6 = info.value("Ip6").toObject();
+        if (!ipv6.isEmpty()) {
+            appendInfo(tr("IPv6"), compressedIpv6Addr(ipv6Infomation(info, NetworkDetailPage::Ip)));
+            appendInfo(tr("Gateway"), compressedIpv6Addr(ipv6Infomation(info, NetworkDetailPage::Gateway)));
+
+            // ipv6 primary dns
+            const auto ip6PrimaryDns = ipv6.value("Dnses").toArray();
+            if (!ip6PrimaryDns.isEmpty())
+                appendInfo(tr("Primary DNS"), compressedIpv6Addr(ip6PrimaryDns.first().toString()));
+            // ipv6 netmask
+            const auto ip6Prefix = ipv6.value("Prefix").toString();
+            if (!ip6Prefix.isEmpty())
+                appendInfo(tr("Prefix"), ip6Prefix);
         }
-        m_groupsLayout->addWidget(grp);
-        if (--infoCount > 0) {
-            m_groupsLayout->addSpacing(30);
+        // speed info
+        const QString speed = info.value("Speed").toString();
+        if (!speed.isEmpty())
+            appendInfo(tr("Speed"), speed);
+    }
+
+    return rows;
+}
+
+void NetworkDetailPage::updateGroup(DetailGroup &group, const DetailRows &rows)
+{
+    bool sameTitles = group.items.size() == rows.size();
+    for (int i = 0; sameTitles && i < rows.size(); ++i)
+        sameTitles = group.items.at(i)->property("detailTitle").toString() == rows.at(i).first;
+
+    // 字段没有增减时只更新发生变化的值
+    if (sameTitles) {
+        for (int i = 0; i < rows.size(); ++i) {
+            TitleValueItem *item = group.items.at(i);
+            if (item->value() != rows.at(i).second)
+                item->setValue(rows.at(i).second);
         }
+        return;
     }
 
-    m_groupsLayout->addStretch();
+    for (TitleValueItem *item : group.items) {
+        group.group->removeItem(item);
+        item->deleteLater();
+    }
+    group.items.clear();
+
+    for (const auto &row : rows) {
+        TitleValueItem *i = new TitleValueItem;
+        i->setTitle(row.first);
+        i->setValue(row.second);
+        i->setProperty("detailTitle", row.first);
+        if (row.first == "IPv6") {
+            i->setWordWrap(false);
+        }
+        group.group->appendItem(i);
+        group.items << i;
+    }
 }
 
 QString NetworkDetailPage::ipv6Infomation(QJsonObject connectinfo, NetworkDetailPage::InfoType type)
 {
-    NetworkManager::Connection::Ptr connection = findConnectionByUuid(connectinfo.value("ConnectionUuid").toString());
+    NetworkManager::Connection::Ptr connection = ConnectionCatalog::instance()->connectionByUuid(connectinfo.value("ConnectionUuid").toString());
     NetworkManager::ConnectionSettings::Ptr connectionSettings = connection->settings();
     NetworkManager::Ipv6Setting::Ptr ipv6Setting = connectionSettings->setting(Setting::Ipv6).staticCast<NetworkManager::Ipv6Setting>();
     QList<NetworkManager::IpAddress> addressInfos = ipv6Setting->addresses();
@@ -28,11 +28,24 @@
 
 #include "widgets/contentwidget.h"
 #include "interface/namespace.h"
+#include "modules/common/dbusproxyregistry.h"
 
 #include <networkmanagerqt/ipaddress.h>
 
+#include <QHash>
+#include <QJsonObject>
+#include <QPair>
+
 using namespace NetworkManager;
 
+namespace dcc {
+namespace widgets {
+class SettingsGroup;
+class SettingsHead;
+class TitleValueItem;
+}
+}
+
 namespace DCC_NAMESPACE {
 namespace network {
 
@@ -54,9 +67,26 @@ private Q_SLOTS:
     void onActiveInfoChanged(const QList<QJsonObject> &infos);
 
 private:
+    // 每个设备一个分组，刷新时复用已有的控件
+    struct DetailGroup {
+        dcc::widgets::SettingsGroup *group;
+        dcc::widgets::SettingsHead *head;
+        QString title;
+        QList<dcc::widgets::TitleValueItem *> items;
+    };
+    // 按显示顺序排列的 (标题, 值)
+    using DetailRows = QList<QPair<QString, QString>>;
+
     QString ipv6Infomation(QJsonObject connectinfos, InfoType type);
+    DetailRows detailRows(const QJsonObject &info);
+    void updateGroup(DetailGroup &group, const DetailRows &rows);
+
 private:
     QVBoxLayout *m_groupsLayout;
+    QSharedPointer<dcc::DBusObjectProxy> m_networkInter;
+    int m_infoSerial;
+    QHash<QString, DetailGroup> m_groups;
+    QStringList m_groupOrder;
 };
 }
 }
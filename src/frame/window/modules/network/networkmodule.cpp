@@ -180,17 +180,22 @@ void NetworkModule::initialize()
 
 void NetworkModule::active()
 {
-    m_networkWidget = new NetworkModuleWidget;
-    m_networkWidget->setVisible(false);
-    m_networkWidget->setModel(m_networkModel);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowDeviceDetail, this, &NetworkModule::showDeviceDetailPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowVpnPage, this, &NetworkModule::showVpnPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowPppPage, this, &NetworkModule::showPppPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowChainsPage, this, &NetworkModule::showChainsProxyPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowProxyPage, this, &NetworkModule::showProxyPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestHotspotPage, this, &NetworkModule::showHotspotPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestShowInfomation, this, &NetworkModule::showDetailPage);
-    connect(m_networkWidget, &NetworkModuleWidget::requestDeviceEnable, m_networkWorker, &NetworkWorker::setDeviceEnable);
+    // 列表页绑定在 model 上，离开后缓存复用，不必每次重建
+    m_networkWidget = qobject_cast<NetworkModuleWidget *>(m_frameProxy->takeCachedPage(this, "main"));
+    if (!m_networkWidget) {
+        m_networkWidget = new NetworkModuleWidget;
+        m_networkWidget->setVisible(false);
+        m_networkWidget->setModel(m_networkModel);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowDeviceDetail, this, &NetworkModule::showDeviceDetailPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowVpnPage, this, &NetworkModule::showVpnPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowPppPage, this, &NetworkModule::showPppPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowChainsPage, this, &NetworkModule::showChainsProxyPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowProxyPage, this, &NetworkModule::showProxyPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestHotspotPage, this, &NetworkModule::showHotspotPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestShowInfomation, this, &NetworkModule::showDetailPage);
+        connect(m_networkWidget, &NetworkModuleWidget::requestDeviceEnable, m_networkWorker, &NetworkWorker::setDeviceEnable);
+        m_frameProxy->setPageCacheable(this, m_networkWidget, "main");
+    }
     m_frameProxy->pushWidget(this, m_networkWidget);
     m_networkWidget->setVisible(true);
     m_networkWidget->initSetting(0, "");
@@ -198,7 +203,8 @@ void NetworkModule::active()
 
 int NetworkModule::load(const QString &path)
 {
-    if (!m_networkWidget) {
+    // 列表页离开后会被隐藏放入缓存，此时指针仍然有效，需要重新进入
+    if (!m_networkWidget || m_networkWidget->isHidden()) {
         active();
     }
 
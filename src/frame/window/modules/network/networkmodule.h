@@ -82,7 +82,7 @@ private:
     dde::network::NetworkModel *m_networkModel;
     dde::network::NetworkWorker *m_networkWorker;
     QPointer<WirelessPage> m_wirelessPage;
-    NetworkModuleWidget *m_networkWidget;
+    QPointer<NetworkModuleWidget> m_networkWidget;
     ConnectionEditPage *m_connEditPage;
     QTimer *m_initSettingTimer;
 
@@ -25,6 +25,7 @@
 
 #include "networkmodulewidget.h"
 #include "window/utils.h"
+#include "modules/common/systemcapabilities.h"
 #include "widgets/nextpagewidget.h"
 #include "widgets/settingsgroup.h"
 #include "widgets/switchwidget.h"
@@ -187,25 +188,21 @@ void NetworkModuleWidget::onProxyMethodChanged(const QString &proxyMethod)
 
 bool NetworkModuleWidget::handleNMEditor()
 {
-    m_strNetworkManageOutput = "";
-    QProcess *process = new QProcess(this);
     QPushButton *nmConnEditBtn = new QPushButton(tr("Configure by Network Manager"));
     m_centralLayout->addWidget(nmConnEditBtn);
     nmConnEditBtn->hide();
-    process->start("which nm-connection-editor");
-
-    connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished), this, [ = ] {
-        m_strNetworkManageOutput = process->readAll();
-        if (!m_strNetworkManageOutput.isEmpty()) {
-            nmConnEditBtn->show();
-            connect(nmConnEditBtn, &QPushButton::clicked, this, [ = ] {
-                if (!m_nmConnectionEditorProcess) {
-                    m_nmConnectionEditorProcess = new QProcess(this);
-                }
-                m_nmConnectionEditorProcess->start("nm-connection-editor");
-            });
-        }
-        process->deleteLater();
+
+    dcc::SystemCapabilities::instance()->queryExecutable("nm-connection-editor", nmConnEditBtn, [ = ](bool found) {
+        if (!found)
+            return;
+
+        nmConnEditBtn->show();
+        connect(nmConnEditBtn, &QPushButton::clicked, this, [ = ] {
+            if (!m_nmConnectionEditorProcess) {
+                m_nmConnectionEditorProcess = new QProcess(this);
+            }
+            m_nmConnectionEditorProcess->start("nm-connection-editor");
+        });
     });
     return true;
 }
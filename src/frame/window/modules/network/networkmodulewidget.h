@@ -106,7 +106,6 @@ private:
     QVBoxLayout *m_centralLayout;
     dcc::widgets::MultiSelectListView *m_lvnmpages;
     QStandardItemModel *m_modelpages;
-    QString m_strNetworkManageOutput;
     enum {
         SectionRole = Dtk::UserRole + 1,
         DeviceRole,
@@ -20,6 +20,7 @@
  */
 
 #include "genericsection.h"
+#include "window/modules/network/connectioncatalog.h"
 
 #include <networkmanagerqt/settings.h>
 
@@ -59,20 +60,14 @@ bool GenericSection::allInputValid()
         return false;
     } else {
         if (m_connType == NetworkManager::ConnectionSettings::Vpn) {
-            NetworkManager::Connection::List connList = listConnections();
-            QStringList connNameList;
             QString curUuid = "";
             if (!m_connSettings.isNull()) {
                 curUuid = m_connSettings->uuid();
             }
-            for (auto conn : connList) {
-                if (conn->settings()->connectionType() == m_connType) {
-                    if ((conn->name() == inputTxt) && (conn->uuid() != curUuid)) {
-                        m_connIdItem->setIsErr(true);
-                        m_connIdItem->dTextEdit()->showAlertMessage(tr("The name already exists"), m_connIdItem, 2000);
-                        return false;
-                    }
-                }
+            if (ConnectionCatalog::instance()->containsId(inputTxt, m_connType, curUuid)) {
+                m_connIdItem->setIsErr(true);
+                m_connIdItem->dTextEdit()->showAlertMessage(tr("The name already exists"), m_connIdItem, 2000);
+                return false;
             }
         }
     }
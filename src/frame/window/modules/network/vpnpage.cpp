@@ -26,6 +26,8 @@
 
 #include "vpnpage.h"
 #include "connectionvpneditpage.h"
+#include "connectioncatalog.h"
+#include "loadingitemdelegate.h"
 #include "widgets/contentwidget.h"
 #include "widgets/switchwidget.h"
 #include "widgets/titlelabel.h"
@@ -40,7 +42,6 @@
 #include <DHiDPIHelper>
 #include <ddialog.h>
 #include <networkmanagerqt/settings.h>
-#include <DSpinner>
 
 #include <QDebug>
 #include <QList>
@@ -48,10 +49,12 @@
 #include <QVBoxLayout>
 #include <QPushButton>
 #include <QJsonObject>
+#include <QDBusPendingCallWatcher>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QSet>
 #include <QStandardItemModel>
 
 DWIDGET_USE_NAMESPACE
@@ -81,9 +84,11 @@ VpnPage::VpnPage(QWidget *parent)
     : QWidget(parent)
     , m_lvprofiles(new DListView)
     , m_modelprofiles(new QStandardItemModel(this))
+    , m_loadingDelegate(new LoadingItemDelegate(m_lvprofiles))
 {
     m_lvprofiles->setAccessibleName("List_vpnList");
     m_lvprofiles->setModel(m_modelprofiles);
+    m_lvprofiles->setItemDelegate(m_loadingDelegate);
     m_lvprofiles->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_lvprofiles->setBackgroundType(DStyledItemDelegate::BackgroundType::ClipCornerBackground);
     m_lvprofiles->setSelectionMode(QAbstractItemView::NoSelection);
@@ -138,6 +143,10 @@ VpnPage::VpnPage(QWidget *parent)
     connect(createVpnBtn, &QPushButton::clicked, this, &VpnPage::createVPN);
     connect(importVpnBtn, &QPushButton::clicked, this, &VpnPage::importVPN);
     connect(m_lvprofiles, &DListView::clicked, this, &VpnPage::onVpnSelected);
+    connect(ConnectionCatalog::instance(), &ConnectionCatalog::connectionAdded, this, [this](const QString &uuid) {
+        if (uuid == m_editingConnUuid)
+            changeVpnId();
+    });
 }
 
 VpnPage::~VpnPage()
@@ -158,36 +167,79 @@ void VpnPage::setModel(NetworkModel *model)
 
     m_vpnSwitch->setChecked(m_model->vpnEnabled());
 
+    onActiveConnsInfoChanged(m_model->activeConnInfos());
     refreshVpnList(m_model->vpns());
 }
 
 void VpnPage::refreshVpnList(const QList<QJsonObject> &vpnList)
 {
-    m_modelprofiles->clear();
-
-    for (const auto &vpn : vpnList) {
+    // 按 UUID 复用已有的行，只增删和移动发生变化的行
+    QSet<QString> uuids;
+    for (int i = 0; i < vpnList.size(); ++i) {
+        const QJsonObject &vpn = vpnList.at(i);
         const QString uuid = vpn.value("Uuid").toString();
-        DStandardItem *it = new DStandardItem();
+        uuids.insert(uuid);
+
+        DStandardItem *it = m_vpnItems.value(uuid);
+        if (!it) {
+            it = createVpnItem(uuid);
+            m_vpnItems.insert(uuid, it);
+            m_modelprofiles->insertRow(i, it);
+            updateVpnItemState(uuid);
+        } else if (it->row() != i) {
+            // 移动会使加载动画的索引失效，需要重新设置状态
+            m_modelprofiles->insertRow(i, m_modelprofiles->takeRow(it->row()));
+            updateVpnItemState(uuid);
+        }
+
         it->setText(vpn.value("Id").toString());
         it->setData(QVariant::fromValue(vpn), VpnInfoRole);
+    }
 
-        DViewItemAction *editaction = new DViewItemAction(Qt::AlignCenter, QSize(), QSize(), true);
-        QStyleOption opt;
-        editaction->setIcon(DStyleHelper(style()).standardIcon(DStyle::SP_ArrowEnter, &opt, nullptr));
-        editaction->setClickAreaMargins(ArrowEnterClickMargin);
-
-        connect(editaction, &QAction::triggered, [this, uuid] {
-            this->onVpnDetailClicked(uuid);
-        });
-        it->setActionList(Qt::Edge::RightEdge, {editaction});
-
-        m_modelprofiles->appendRow(it);
+    for (auto it = m_vpnItems.begin(); it != m_vpnItems.end();) {
+        if (uuids.contains(it.key())) {
+            ++it;
+        } else {
+            m_modelprofiles->removeRow(it.value()->row());
+            it = m_vpnItems.erase(it);
+        }
     }
 
-    onActiveConnsInfoChanged(m_model->activeConnInfos());
     m_vpnSwitch->setVisible(m_modelprofiles->rowCount() > 0);
 }
 
+DStandardItem *VpnPage::createVpnItem(const QString &uuid)
+{
+    DStandardItem *it = new DStandardItem();
+
+    DViewItemAction *editaction = new DViewItemAction(Qt::AlignCenter, QSize(), QSize(), true);
+    QStyleOption opt;
+    editaction->setIcon(DStyleHelper(style()).standardIcon(DStyle::SP_ArrowEnter, &opt, nullptr));
+    editaction->setClickAreaMargins(ArrowEnterClickMargin);
+
+    connect(editaction, &QAction::triggered, [this, uuid] {
+        this->onVpnDetailClicked(uuid);
+    });
+    it->setActionList(Qt::Edge::RightEdge, {editaction});
+
+    return it;
+}
+
+void VpnPage::updateVpnItemState(const QString &uuid)
+{
+    DStandardItem *it = m_vpnItems.value(uuid);
+    if (!it)
+        return;
+
+    // 1: 正在连接 2: 已连接
+    const int state = m_vpnStates.value(uuid, 0);
+    const bool loading = state == 1;
+
+    it->setCheckState(state == 2 ? Qt::Checked : Qt::Unchecked);
+    it->actionList(Qt::RightEdge).first()->setVisible(!loading);
+    m_loadingDelegate->setLoading(it->index(), loading);
+}
+
 void VpnPage::onVpnDetailClicked(const QString &connectionUuid)
 {
     m_editPage = new ConnectionVpnEditPage(connectionUuid);
@@ -207,7 +259,7 @@ void VpnPage::onVpnSelected(const QModelIndex &idx)
 
 void VpnPage::onActiveConnsInfoChanged(const QList<QJsonObject> &infos)
 {
-    QMap<QString, int> activeVpnStates;
+    QHash<QString, int> activeVpnStates;
 
     for (const auto &info : infos) {
         const QString &type = info.value("ConnectionType").toString();
@@ -220,110 +272,45 @@ void VpnPage::onActiveConnsInfoChanged(const QList<QJsonObject> &infos)
         activeVpnStates.insert(uuid, state);
     }
 
-    for (int i = 0; i < m_modelprofiles->rowCount(); ++i) {
-        DStandardItem *it = dynamic_cast<DStandardItem *>(m_modelprofiles->item(i));
-        const QString &uuid = it->data(VpnInfoRole).value<QJsonObject>().value("Uuid").toString();
-        const bool exist = activeVpnStates.contains(uuid);
-
-        if (it->actionList(Qt::RightEdge).size() > 1) {
-            it->actionList(Qt::RightEdge).first()->widget()->deleteLater();
-            it->actionList(Qt::RightEdge).last()->deleteLater();
-        }
-        it->actionList(Qt::RightEdge).first()->deleteLater();
-
-        DViewItemActionList dActionList;
-        DViewItemAction *editaction = new DViewItemAction(Qt::AlignCenter, QSize(), QSize(), true);
-        QStyleOption opt;
-        editaction->setIcon(DStyleHelper(style()).standardIcon(DStyle::SP_ArrowEnter, &opt, nullptr));
-        editaction->setClickAreaMargins(ArrowEnterClickMargin);
-
-        connect(editaction, &QAction::triggered, [this, uuid] {
-            this->onVpnDetailClicked(uuid);
-        });
-
-        if (exist && activeVpnStates[uuid] == 2) {
-            it->setCheckState(Qt::Checked);
-        } else if (exist && activeVpnStates[uuid] == 1) {
-            it->setCheckState(Qt::Unchecked);
-
-            DViewItemAction *loadingAction = new DViewItemAction(Qt::AlignCenter | Qt::AlignRight, QSize(), QSize(), false);
-            DSpinner *loadingIndicator = new DSpinner(m_lvprofiles->viewport());
-            loadingIndicator->setFixedSize(20, 20);
-            loadingAction->setWidget(loadingIndicator);
-            loadingIndicator->start();
-            loadingIndicator->show();
-            dActionList.append(loadingAction);
-            editaction->setVisible(false);
-        } else {
-            it->setCheckState(Qt::Unchecked);
-        }
+    // 只更新状态发生变化的行
+    const QHash<QString, int> oldStates = m_vpnStates;
+    m_vpnStates = activeVpnStates;
 
-        dActionList.append(editaction);
-        it->setActionList(Qt::RightEdge, dActionList);
+    for (auto it = oldStates.constBegin(); it != oldStates.constEnd(); ++it) {
+        if (m_vpnStates.value(it.key(), 0) != it.value())
+            updateVpnItemState(it.key());
+    }
+    for (auto it = m_vpnStates.constBegin(); it != m_vpnStates.constEnd(); ++it) {
+        if (!oldStates.contains(it.key()))
+            updateVpnItemState(it.key());
     }
 }
 
 void VpnPage::changeVpnId()
 {
-    NetworkManager::Connection::List connList = NetworkManager::listConnections();
-    QString importName = "";
-    for (const auto &conn : connList) {
-        if (conn->settings()->connectionType() == NetworkManager::ConnectionSettings::Vpn) {
-            if (m_editingConnUuid == conn->uuid()) {
-                importName = conn->name();
-                break;
-            }
-        }
-    }
-    if (importName.isEmpty()) {
-        QTimer::singleShot(10, this, &VpnPage::changeVpnId);
+    ConnectionCatalog *catalog = ConnectionCatalog::instance();
+    // nmcli 返回时 NetworkManager 可能还未通知新连接，收到 connectionAdded 后会再次调用
+    if (m_editingConnUuid.isEmpty() || !catalog->containsUuid(m_editingConnUuid))
         return;
-    }
 
-    QString changeName = "";
-    bool hasSameName = false;
-    for (const auto &conn : connList) {
-        const QString vpnName = conn->name();
-        const QString vpnUuid = conn->uuid();
-        if ((vpnName == importName) && (vpnUuid != m_editingConnUuid)) {
-            changeName = importName + "(1)";
-            hasSameName = true;
-            break;
-        }
-    }
-    if (!hasSameName) {
-        return;
-    }
+    const QString uuid = m_editingConnUuid;
+    m_editingConnUuid.clear();
 
-    for (int index = 1; ; index++) {
-        hasSameName = false;
-        for (const auto &conn : connList) {
-            QString vpnName = conn->name();
-            if (vpnName == changeName) {
-                changeName = importName + "(%1)";
-                changeName = changeName.arg(index);
-                hasSameName = true;
-                break;
-            }
-        }
-        if (!hasSameName) {
-            break;
-        }
-    }
-    NetworkManager::Connection::Ptr uuidConn = NetworkManager::findConnectionByUuid(m_editingConnUuid);
-    if (uuidConn) {
-        NetworkManager::ConnectionSettings::Ptr connSettings = uuidConn->settings();
-        connSettings->setId(changeName);
-        // update function saves the settings on the hard disk
-        QDBusPendingReply<> reply = uuidConn->update(connSettings->toMap());
-        reply.waitForFinished();
-        if (reply.isError()) {
-            qDebug() << "error occurred while updating the connection" << reply.error();
-            return;
-        }
-        qDebug() << "find Connection By Uuid is success";
+    const QString importName = catalog->idByUuid(uuid);
+    const QString changeName = catalog->uniqueId(importName, uuid);
+    if (changeName == importName)
         return;
-    }
+
+    NetworkManager::Connection::Ptr uuidConn = catalog->connectionByUuid(uuid);
+    NetworkManager::ConnectionSettings::Ptr connSettings = uuidConn->settings();
+    connSettings->setId(changeName);
+    // update function saves the settings on the hard disk
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(uuidConn->update(connSettings->toMap()), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [watcher] {
+        if (watcher->isError())
+            qDebug() << "error occurred while updating the connection" << watcher->error();
+        watcher->deleteLater();
+    });
 }
 
 void VpnPage::importVPN()
@@ -368,7 +355,7 @@ void VpnPage::importVPN()
         m_editingConnUuid.replace("(", "");
         m_editingConnUuid.replace(")", "");
         qDebug() << "editing connection Uuid";
-        QTimer::singleShot(10, this, &VpnPage::changeVpnId);
+        changeVpnId();
     }
 }
 
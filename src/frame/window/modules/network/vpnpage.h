@@ -30,7 +30,9 @@
 #include "interface/namespace.h"
 
 #include <DListView>
+#include <DStandardItem>
 
+#include <QHash>
 #include <QPointer>
 
 namespace dde {
@@ -51,6 +53,7 @@ class LoadingNextPageWidget;
 namespace DCC_NAMESPACE {
 namespace network {
 class ConnectionVpnEditPage;
+class LoadingItemDelegate;
 class VpnPage : public QWidget
 {
     Q_OBJECT
@@ -78,6 +81,10 @@ private Q_SLOTS:
     void importVPN();
     void createVPN();
     void changeVpnId();
+private:
+    DTK_WIDGET_NAMESPACE::DStandardItem *createVpnItem(const QString &uuid);
+    void updateVpnItemState(const QString &uuid);
+
 private:
     dde::network::NetworkModel *m_model;
 
@@ -88,6 +95,10 @@ private:
 
     DTK_WIDGET_NAMESPACE::DListView *m_lvprofiles;
     QStandardItemModel *m_modelprofiles;
+    LoadingItemDelegate *m_loadingDelegate;
+    // 按 UUID 索引的行和连接状态，状态变化时只刷新对应的行
+    QHash<QString, DTK_WIDGET_NAMESPACE::DStandardItem *> m_vpnItems;
+    QHash<QString, int> m_vpnStates;
 
     static const int VpnInfoRole = Dtk::UserRole + 1;
 };
@@ -29,6 +29,7 @@
 #include "widgets/titlelabel.h"
 #include "widgets/titlevalueitem.h"
 #include "widgets/contentwidget.h"
+#include "modules/common/dbusproxyregistry.h"
 
 #include <DFontSizeManager>
 
@@ -243,11 +244,17 @@ void GeneralWidget::setModel(const PowerModel *model)
     m_swLowPowerAutoIntoSaveEnergyMode->setChecked(model->powerSavingModeAutoWhenQuantifyLow());
     connect(model, &PowerModel::powerSavingModeAutoWhenQuantifyLowChanged, m_swLowPowerAutoIntoSaveEnergyMode, &SwitchWidget::setChecked);
 
-    QDBusInterface Interface("com.deepin.daemon.Display",
-                             "/com/deepin/daemon/Display",
-                             "com.deepin.daemon.Display",
-                             QDBusConnection::sessionBus());
-    int maxBacklight = Interface.property("MaxBacklightBrightness").toInt();
+    if (!m_displayInter) {
+        m_displayInter = DBusProxyRegistry::instance()->proxy(QDBusConnection::sessionBus(),
+                                                              "com.deepin.daemon.Display",
+                                                              "/com/deepin/daemon/Display",
+                                                              "com.deepin.daemon.Display");
+        connect(m_displayInter.data(), &DBusObjectProxy::propertyChanged, this, [this](const QString &name, const QVariant &value) {
+            if (name == "MaxBacklightBrightness")
+                m_sldLowerBrightness->setVisible(value.toInt() >= 100 || value.toInt() == 0);
+        });
+    }
+    int maxBacklight = m_displayInter->cachedProperty("MaxBacklightBrightness").toInt();
     m_sldLowerBrightness->setVisible(maxBacklight >= 100 || maxBacklight == 0);
     m_sldLowerBrightness->slider()->setValue(model->powerSavingModeLowerBrightnessThreshold() / 10);
     connect(model, &PowerModel::powerSavingModeLowerBrightnessThresholdChanged, this,  [ = ](const uint dLevel) {
@@ -27,11 +27,13 @@
 #include <QWidget>
 #include <QVBoxLayout>
 #include <QLabel>
+#include <QSharedPointer>
 
 #include <DListView>
 
 class TitleLabel;
 namespace dcc {
+class DBusObjectProxy;
 namespace widgets {
 class SwitchWidget;
 class TitledSliderItem;
@@ -79,6 +81,7 @@ private:
     dcc::widgets::SwitchWidget *m_swLowPowerAutoIntoSaveEnergyMode;
     dcc::widgets::SwitchWidget *m_autoIntoSaveEnergyMode;
     dcc::widgets::TitledSliderItem *m_sldLowerBrightness = nullptr;
+    QSharedPointer<dcc::DBusObjectProxy> m_displayInter;
 
     /* Wakeup Settings */
     dcc::widgets::SwitchWidget *m_wakeComputerNeedPassword;
@@ -21,6 +21,7 @@
 
 #include "microphonepage.h"
 #include "modules/sound/soundmodel.h"
+#include "modules/sound/levelmeter.h"
 #include "window/utils.h"
 
 #include <com_deepin_daemon_audio_source.h>
@@ -107,19 +108,38 @@ MicrophonePage::MicrophonePage(QWidget *parent)
 MicrophonePage::~MicrophonePage()
 {
 #ifndef DCC_DISABLE_FEEDBACK
+    if (m_levelMeter)
+        m_levelMeter->disconnect(this);
     if (m_feedbackSlider)
-        m_feedbackSlider->disconnect(m_conn);
-    m_feedbackSlider->deleteLater();
+        m_feedbackSlider->deleteLater();
 #endif
 }
 
+void MicrophonePage::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    if (m_levelMeter)
+        m_levelMeter->start();
+}
+
+void MicrophonePage::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+
+    if (m_levelMeter)
+        m_levelMeter->stop();
+}
+
 /**当用户进入扬声器端口手动切换蓝牙输出端口后，再进入麦克风页面时
  * 会有默认输入端口路径为空或者指定路径下激活端口为空的情况，
  */
 void MicrophonePage::resetUi()
 {
-    QDBusInterface interface("com.deepin.daemon.Audio", "/com/deepin/daemon/Audio", "com.deepin.daemon.Audio", QDBusConnection::sessionBus(), this);
-    QDBusObjectPath defaultPath = interface.property("DefaultSource").value<QDBusObjectPath>();
+    if (!m_audioInter)
+        m_audioInter = dcc::DBusProxyRegistry::instance()->proxy(QDBusConnection::sessionBus(), "com.deepin.daemon.Audio",
+                                                                 "/com/deepin/daemon/Audio", "com.deepin.daemon.Audio");
+    QDBusObjectPath defaultPath = m_audioInter->cachedProperty("DefaultSource").value<QDBusObjectPath>();
     if (defaultPath.path() == "/") //路径为空
         m_inputSoundCbx->comboBox()->setCurrentIndex(-1);
     else {
@@ -340,9 +360,14 @@ void MicrophonePage::initSlider()
     slider2->setPageStep(1);
 
     connect(m_model, &SoundModel::isPortEnableChanged, m_noiseReductionsw, &ComboxWidget::setVisible);
-    m_conn = connect(m_model, &SoundModel::microphoneFeedbackChanged, [ = ](double vol2) {
+    m_levelMeter = new LevelMeter(this);
+    connect(m_levelMeter, &LevelMeter::levelChanged, this, [ = ](double vol2) {
         slider2->setSliderPosition(int(vol2 * 100));
     });
+    // 默认输入设备切换后重新打开采集流
+    connect(m_model, &SoundModel::defaultSourceChanged, m_levelMeter, &LevelMeter::restart);
+    if (isVisible())
+        m_levelMeter->start();
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &MicrophonePage::refreshIcon);
     connect(qApp, &DApplication::iconThemeChanged, this, &MicrophonePage::refreshIcon);
     m_layout->setSpacing(10);
@@ -24,6 +24,7 @@
 
 #include "interface/namespace.h"
 #include "modules/sound/soundmodel.h"
+#include "modules/common/dbusproxyregistry.h"
 
 #include <QStandardItemModel>
 #include <QWidget>
@@ -45,6 +46,7 @@ class Port;
 
 namespace sound {
 class SoundModel;
+class LevelMeter;
 }
 }
 
@@ -65,6 +67,10 @@ public:
 public:
     void setModel(dcc::sound::SoundModel *model);
 
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
 Q_SIGNALS:
     void requestSwitchMicrophone(bool on);
     void requestSetMicrophoneVolume(double vol);
@@ -90,7 +96,9 @@ private:
     dcc::widgets::SwitchWidget *m_sw{nullptr};
     dcc::widgets::TitledSliderItem *m_inputSlider{nullptr};
     dcc::widgets::TitledSliderItem *m_feedbackSlider{nullptr};
-    QMetaObject::Connection m_conn;
+    // 输入电平只在页面可见时采集
+    dcc::sound::LevelMeter *m_levelMeter{nullptr};
+    QSharedPointer<dcc::DBusObjectProxy> m_audioInter;
     //输入列表的下拉框列表
     dcc::widgets::ComboxWidget *m_inputSoundCbx;
     //噪音抑制
@@ -21,7 +21,7 @@
 
 #include "userlicensewidget.h"
 #include "widgets/translucentframe.h"
-#include "widgets/labels/tipslabel.h"
+#include "widgets/longtextview.h"
 #include "widgets/utils.h"
 #include "window/utils.h"
 #include "../../protocolfile.h"
@@ -41,8 +41,7 @@ UserLicenseWidget::UserLicenseWidget(QWidget *parent)
     TranslucentFrame *widget = new TranslucentFrame;
     QVBoxLayout *layout = new QVBoxLayout();
 
-    m_body = new TipsLabel;
-    m_body->setWordWrap(true);
+    m_body = new LongTextView;
 
     layout->setContentsMargins(10,10,11,10);
     layout->addWidget(m_body);
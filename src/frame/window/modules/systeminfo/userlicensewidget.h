@@ -28,7 +28,7 @@
 
 namespace  dcc {
 namespace widgets {
-class TipsLabel;
+class LongTextView;
 }
 }
 
@@ -45,7 +45,7 @@ Q_SIGNALS:
     void loadTextFinished();
 
 private:
-    dcc::widgets::TipsLabel *m_body;
+    dcc::widgets::LongTextView *m_body;
 };
 
 }
@@ -22,6 +22,7 @@
 #include "versionprotocolwidget.h"
 #include "widgets/translucentframe.h"
 #include "widgets/labels/tipslabel.h"
+#include "widgets/longtextview.h"
 #include "widgets/utils.h"
 #include "window/utils.h"
 
@@ -45,10 +46,8 @@ VersionProtocolWidget::VersionProtocolWidget(QWidget *parent)
     : ContentWidget(parent)
     , m_mainLayout(new QVBoxLayout)
     , m_title(new TipsLabel)
-    , m_body(new TipsLabel)
+    , m_body(new LongTextView)
 {
-    m_body->setWordWrap(true);
-
     TranslucentFrame *widget = new TranslucentFrame;
 
     m_mainLayout->setContentsMargins(10,10,11,10);
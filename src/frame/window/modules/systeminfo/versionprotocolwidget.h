@@ -34,6 +34,7 @@ QT_END_NAMESPACE
 namespace dcc {
 namespace widgets {
 class TipsLabel;
+class LongTextView;
 }
 }
 
@@ -52,7 +53,7 @@ Q_SIGNALS:
 private:
     QVBoxLayout *m_mainLayout;
     dcc::widgets::TipsLabel *m_title;
-    dcc::widgets::TipsLabel *m_body;
+    dcc::widgets::LongTextView *m_body;
 };
 
 }
@@ -72,22 +72,21 @@ int MirrorSourceItem::speed() const
 
 void MirrorSourceItem::setSpeed(const int time)
 {
-    if (m_speed != time) {
-        m_speed = time;
+    // setTesting 会覆盖显示的文字，速度没有变化时也要重新设置
+    m_speed = time;
 
-        QString sp = "";
-        if (time == 10000) {
-            sp = tr("Timeout");
-        } else if (time > 2000) {
-            sp = tr("Slow");
-        } else if (time > 200)
-            sp = tr("Medium");
-        else {
-            sp = tr("Fast");
-        }
-
-        setMirrorState(sp);
+    QString sp = "";
+    if (time == 10000) {
+        sp = tr("Timeout");
+    } else if (time > 2000) {
+        sp = tr("Slow");
+    } else if (time > 200)
+        sp = tr("Medium");
+    else {
+        sp = tr("Fast");
     }
+
+    setMirrorState(sp);
 }
 
 void MirrorSourceItem::setTesting()
@@ -68,6 +68,9 @@ UpdateCtrlWidget::UpdateCtrlWidget(UpdateModel *model, QWidget *parent)
     , m_authorizationPrompt(new TipsLabel)
     , m_checkUpdateBtn(new QPushButton)
     , m_lastCheckTimeTip(new TipsLabel)
+    , m_listFooter(new QWidget)
+    , m_listCheckBtn(new QPushButton(tr("Check Again")))
+    , m_listCheckTimeTip(new TipsLabel)
 {
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
@@ -142,6 +145,16 @@ UpdateCtrlWidget::UpdateCtrlWidget(UpdateModel *model, QWidget *parent)
     m_updateList->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     m_updateList->setContent(contentWidget);
 
+    // 更新应用列表的 重新检查按钮 和 更新时间标签 放到列表窗口内
+    QVBoxLayout *footerLayout = new QVBoxLayout(m_listFooter);
+    footerLayout->addSpacing(20);
+    m_listCheckBtn->setFixedSize(300, 36);
+    footerLayout->addWidget(m_listCheckBtn, 0, Qt::AlignHCenter);
+    m_listCheckTimeTip->setAlignment(Qt::AlignCenter);
+    footerLayout->addWidget(m_listCheckTimeTip);
+    m_summaryGroup->insertWidget(m_listFooter);
+    m_summaryGroup->getLayout()->addStretch();
+
     setModel(model);
 
     connect(m_progress, &DownloadProgressBar::clicked, this, &UpdateCtrlWidget::onProgressBarClicked);
@@ -150,6 +163,12 @@ UpdateCtrlWidget::UpdateCtrlWidget(UpdateModel *model, QWidget *parent)
     connect(m_checkUpdateBtn, &QPushButton::clicked, [this] {
         this->setFocus();
     });
+    // 点击后重新检查更新
+    connect(m_listCheckBtn, &QPushButton::clicked, m_model, &UpdateModel::beginCheckUpdate);
+    // 启动下载之后，按钮灰化，不再允许重新检查
+    connect(m_fullProcess, &DownloadProgressBar::clicked, m_listCheckBtn, [this] {
+        m_listCheckBtn->setEnabled(false);
+    });
 }
 
 UpdateCtrlWidget::~UpdateCtrlWidget()
@@ -170,57 +189,59 @@ void UpdateCtrlWidget::setShowInfo(const UiActiveState value)
     m_authorizationPrompt->setVisible(UpdatesStatus::UpdatesAvailable == m_model->status() && !activation);
 }
 
-void UpdateCtrlWidget::loadAppList(const QList<AppUpdateInfo> &infos)
+static bool isSameAppInfo(const AppUpdateInfo &a, const AppUpdateInfo &b)
 {
-//    qDebug() << infos.count();
+    return a.m_packageId == b.m_packageId
+           && a.m_name == b.m_name
+           && a.m_icon == b.m_icon
+           && a.m_currentVersion == b.m_currentVersion
+           && a.m_avilableVersion == b.m_avilableVersion
+           && a.m_changelog == b.m_changelog;
+}
 
-    QLayoutItem *item;
-    while ((item = m_summaryGroup->layout()->takeAt(0)) != nullptr) {
-        item->widget()->deleteLater();
-        delete item;
+void UpdateCtrlWidget::loadAppList(const QList<AppUpdateInfo> &infos)
+{
+    // 下载、暂停、安装等状态切换都会重新设置下载信息，这里只对比差异，
+    // 复用未变化的条目，避免每次都重建整个列表
+    m_summaryGroup->setUpdatesEnabled(false);
+
+    QHash<QString, UpdateItem *> items;
+    for (int i = 0; i < infos.size(); ++i) {
+        const AppUpdateInfo &info = infos.at(i);
+        if (items.contains(info.m_packageId))
+            continue;
+
+        UpdateItem *item = m_updateItems.take(info.m_packageId);
+        if (!item) {
+            item = new UpdateItem();
+            item->setAppInfo(info);
+            m_summaryGroup->insertItem(items.size(), item);
+        } else {
+            if (!isSameAppInfo(item->appInfo(), info))
+                item->setAppInfo(info);
+            m_summaryGroup->moveItem(item, items.size());
+        }
+        items.insert(info.m_packageId, item);
     }
 
-    for (const AppUpdateInfo &info : infos) {
-        UpdateItem *items = new UpdateItem();
-        items->setAppInfo(info);
-
-        m_summaryGroup->appendItem(items);
+    for (UpdateItem *item : m_updateItems) {
+        m_summaryGroup->removeItem(item);
+        item->deleteLater();
     }
-
-    // 更新应用列表的 重新检查按钮 和 更新时间标签 放到列表窗口内
-    QWidget *content = new QWidget;
-    QVBoxLayout *vLayout = new QVBoxLayout(content);
-    vLayout->addSpacing(20);
-    QPushButton *checkBtn = new QPushButton(tr("Check Again"));
-    checkBtn->setFixedSize(300, 36);
-    vLayout->addWidget(checkBtn, 0, Qt::AlignHCenter);
+    m_updateItems = items;
 
     // 只有还未进行下载状态，按钮可用，其他正在下载、暂停、安装、备份等都禁用
-    if (m_status != UpdatesStatus::UpdatesAvailable) {
-        checkBtn->setEnabled(false);
-    }
+    m_listCheckBtn->setEnabled(m_status == UpdatesStatus::UpdatesAvailable);
 
-    // 点击后重新检查更新
-    connect(checkBtn, &QPushButton::clicked, m_model, &UpdateModel::beginCheckUpdate);
-    // 启动下载之后，按钮灰化，不再允许重新检查
-    connect(m_fullProcess, &DownloadProgressBar::clicked, checkBtn, [=] {
-        checkBtn->setEnabled(false);
-    });
-
-    // 更新时间标签初始化
+    // 更新时间标签
     m_model->updateCheckUpdateTime();
-    TipsLabel *lastTimeTip = new TipsLabel;
-    lastTimeTip->setAlignment(Qt::AlignCenter);
-    lastTimeTip->setText(tr("Last checking time: ") + m_model->lastCheckUpdateTime());
-    vLayout->addWidget(lastTimeTip);
-    m_summaryGroup->insertWidget(content);
+    m_listCheckTimeTip->setText(tr("Last checking time: ") + m_model->lastCheckUpdateTime());
 
     //在只有一个更新的时候,为防止item过度的拉伸
-    if (infos.count() > 1) {
-        m_summaryGroup->getLayout()->addStretch();
-    } else {
-        m_summaryGroup->getLayout()->addStretch(1);
-    }
+    QVBoxLayout *layout = m_summaryGroup->getLayout();
+    layout->setStretch(layout->count() - 1, m_updateItems.size() > 1 ? 0 : 1);
+
+    m_summaryGroup->setUpdatesEnabled(true);
 }
 
 void UpdateCtrlWidget::onProgressBarClicked()
@@ -400,8 +421,10 @@ void UpdateCtrlWidget::setDownloadInfo(DownloadInfo *downloadInfo)
     if (!downloadInfo)
         return;
 
+    // 下载大小在列表之后返回，同一个 DownloadInfo 会原地更新
+    connect(downloadInfo, &DownloadInfo::downloadSizeChanged, this, &UpdateCtrlWidget::setDownloadSize, Qt::UniqueConnection);
+
     const QList<AppUpdateInfo> &apps = downloadInfo->appInfos();
-    const qulonglong downloadSize = downloadInfo->downloadSize();
 
     int appCount = apps.length();
     for (const AppUpdateInfo &info : apps) {
@@ -423,16 +446,20 @@ void UpdateCtrlWidget::setDownloadInfo(DownloadInfo *downloadInfo)
         }
     }
 
+    setDownloadSize(static_cast<qlonglong>(downloadInfo->downloadSize()));
+    loadAppList(apps);
+}
+
+void UpdateCtrlWidget::setDownloadSize(qlonglong downloadSize)
+{
     if (!downloadSize) {
         m_summary->setDetails(tr("Downloaded"));
     } else {
-        m_summary->setDetails(QString(tr("Size: %1").arg(formatCap(downloadSize))));
+        m_summary->setDetails(QString(tr("Size: %1").arg(formatCap(static_cast<qulonglong>(downloadSize)))));
 
         if ((static_cast<int>(downloadSize) / 1024) / 1024 >= m_qsettings->value("upgrade_waring_size", UpgradeWarningSize).toInt())
             m_upgradeWarningGroup->setVisible(true);
     }
-
-    loadAppList(apps);
 }
 
 void UpdateCtrlWidget::setProgressValue(const double value)
@@ -26,6 +26,7 @@
 #include "widgets/utils.h"
 
 #include <QWidget>
+#include <QHash>
 
 class AppUpdateInfo;
 class QPushButton;
@@ -41,6 +42,7 @@ class DownloadInfo;
 class SummaryItem;
 class DownloadProgressBar;
 class ResultItem;
+class UpdateItem;
 }
 
 namespace widgets {
@@ -79,6 +81,7 @@ private Q_SLOTS:
 private:
     void setStatus(const dcc::update::UpdatesStatus &status);
     void setDownloadInfo(dcc::update::DownloadInfo *downloadInfo);
+    void setDownloadSize(qlonglong downloadSize);
     void setProgressValue(const double value);
     void setLowBattery(const bool &lowBattery);
     void setUpdateProgress(const double value);
@@ -113,6 +116,12 @@ private:
 
     QPushButton *m_checkUpdateBtn;
     dcc::widgets::TipsLabel *m_lastCheckTimeTip;
+
+    // 更新列表中的条目，按包名索引，刷新时只增删变化的条目
+    QHash<QString, dcc::update::UpdateItem *> m_updateItems;
+    QWidget *m_listFooter;
+    QPushButton *m_listCheckBtn;
+    dcc::widgets::TipsLabel *m_listCheckTimeTip;
 };
 
 }// namespace datetime
@@ -21,6 +21,7 @@
 #include "updatemodule.h"
 #include "modules/update/updatemodel.h"
 #include "modules/update/updatework.h"
+#include "modules/common/licensestate.h"
 #include "updatewidget.h"
 #include "mirrorswidget.h"
 #include "modules/systeminfo/systeminfomodel.h"
@@ -123,6 +124,19 @@ void UpdateModule::preInitialize(bool sync, FrameProxyInterface::PushType pushty
     });
 #endif
 
+    // 授权状态在主线程创建和刷新，通过排队连接送到工作线程
+    if (DSysInfo::DeepinDesktop == DSysInfo::deepinType()) {
+        m_model->setSystemActivation(UiActiveState::Authorized);
+    } else {
+        LicenseState *licenseState = LicenseState::instance();
+        UpdateWorker *work = m_work.get();
+        connect(licenseState, &LicenseState::authorizationStateChanged, work, &UpdateWorker::onLicenseStateChanged, Qt::QueuedConnection);
+        if (licenseState->isValid()) {
+            const quint32 state = licenseState->authorizationState();
+            QMetaObject::invokeMethod(work, [work, state] { work->onLicenseStateChanged(state); }, Qt::QueuedConnection);
+        }
+    }
+
     Q_EMIT m_work->requestInit();
     Q_EMIT m_work->requestActive();
 }
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pagecache.h"
+
+#include <QWidget>
+
+using namespace DCC_NAMESPACE;
+
+PageCache::PageCache(int maxPages, int maxWidgets, QObject *parent)
+    : QObject(parent)
+    , m_maxPages(maxPages)
+    , m_maxWidgets(maxWidgets)
+    , m_totalCost(0)
+{
+}
+
+void PageCache::setCacheable(QWidget *page, const QString &key)
+{
+    if (!page || !isEnabled())
+        return;
+
+    if (!m_keys.contains(page)) {
+        connect(page, &QObject::destroyed, this, [this, page] {
+            m_keys.remove(page);
+        });
+    }
+
+    m_keys.insert(page, key);
+}
+
+bool PageCache::insert(QWidget *page)
+{
+    if (!m_keys.contains(page))
+        return false;
+
+    // 同一个键只保留最新的页面
+    const QString key = m_keys.value(page);
+    if (QWidget *old = take(key))
+        old->deleteLater();
+
+    page->setVisible(false);
+    page->setParent(qobject_cast<QWidget *>(parent()));
+
+    const Entry entry { key, page, estimateCost(page) };
+    m_entries.append(entry);
+    m_totalCost += entry.cost;
+    trim();
+
+    return true;
+}
+
+QWidget *PageCache::take(const QString &key)
+{
+    for (int i = m_entries.size() - 1; i >= 0; --i) {
+        if (m_entries.at(i).key != key)
+            continue;
+
+        const Entry entry = m_entries.takeAt(i);
+        m_totalCost -= entry.cost;
+        return entry.page;
+    }
+
+    return nullptr;
+}
+
+void PageCache::trim()
+{
+    while (!m_entries.isEmpty() && (m_entries.size() > m_maxPages || m_totalCost > m_maxWidgets)) {
+        const Entry entry = m_entries.takeFirst();
+        m_totalCost -= entry.cost;
+        if (entry.page)
+            entry.page->deleteLater();
+    }
+}
+
+int PageCache::estimateCost(QWidget *page)
+{
+    return page->findChildren<QWidget *>().size() + 1;
+}
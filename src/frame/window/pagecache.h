@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2011 ~ 2021 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PAGECACHE_H
+#define PAGECACHE_H
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPointer>
+
+class QWidget;
+
+namespace DCC_NAMESPACE {
+
+/**
+ * @brief PageCache 已弹出页面的 LRU 缓存
+ *
+ * 只缓存模块通过 setCacheable 声明过的页面，页面以“模块名/页面路径”为键，
+ * 弹出时隐藏保留，再次进入时取回复用。页面占用按控件树中的控件数量估算，
+ * 超过页数或控件数上限时销毁最久未使用的页面。
+ */
+class PageCache : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @param maxPages 最多缓存的页面数
+     * @param maxWidgets 所有缓存页面的控件总数上限
+     */
+    explicit PageCache(int maxPages, int maxWidgets, QObject *parent = nullptr);
+
+    bool isEnabled() const { return m_maxPages > 0 && m_maxWidgets > 0; }
+
+    void setCacheable(QWidget *page, const QString &key);
+    bool isCacheable(QWidget *page) const { return m_keys.contains(page); }
+
+    /**
+     * @brief insert 缓存已从界面移除的页面，页面不可缓存时返回 false，由调用方销毁
+     */
+    bool insert(QWidget *page);
+
+    /**
+     * @brief take 取出缓存的页面，没有时返回 nullptr
+     */
+    QWidget *take(const QString &key);
+
+private:
+    struct Entry {
+        QString key;
+        QPointer<QWidget> page;
+        int cost;
+    };
+
+    void trim();
+    static int estimateCost(QWidget *page);
+
+private:
+    int m_maxPages;
+    int m_maxWidgets;
+    int m_totalCost;
+    QHash<QWidget *, QString> m_keys;
+    // 按最近使用排序，末尾为最新
+    QList<Entry> m_entries;
+};
+
+}
+
+#endif // PAGECACHE_H
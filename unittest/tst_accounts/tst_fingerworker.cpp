@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include "fingermodel.h"
+#include "fingerworker.h"
+
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMessage>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTest>
+#include <QThread>
+
+using namespace dcc::accounts;
+
+const QString FakeService("com.deepin.daemon.Authenticate");
+const QString FakePath("/com/deepin/daemon/Authenticate/Fingerprint");
+
+// 模拟的指纹服务，占用设备的请求在 replyClaim 之前不会返回
+class FakeFingerprint : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.deepin.daemon.Authenticate.Fingerprint")
+    Q_PROPERTY(QString DefaultDevice READ defaultDevice)
+
+public:
+    QString defaultDevice() const { return QStringLiteral("fake"); }
+
+    QStringList calls() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_calls;
+    }
+
+    bool replyClaim(const QString &id)
+    {
+        QMutexLocker locker(&m_mutex);
+        for (int i = 0; i < m_pendingClaims.size(); ++i) {
+            const QDBusMessage msg = m_pendingClaims.at(i);
+            if (msg.arguments().value(0).toString() != id)
+                continue;
+
+            m_pendingClaims.removeAt(i);
+            return QDBusConnection::connectToBus(QDBusConnection::SystemBus, FakeService).send(msg.createReply());
+        }
+        return false;
+    }
+
+public Q_SLOTS:
+    void PreAuthEnroll()
+    {
+        record("PreAuthEnroll");
+    }
+
+    void Claim(const QString &id, bool claimed)
+    {
+        record(QString("Claim %1 %2").arg(id, claimed ? "true" : "false"));
+        if (!claimed)
+            return;
+
+        setDelayedReply(true);
+        QMutexLocker locker(&m_mutex);
+        m_pendingClaims << message();
+    }
+
+    void Enroll(const QString &finger)
+    {
+        record("Enroll " + finger);
+    }
+
+    void StopEnroll()
+    {
+        record("StopEnroll");
+    }
+
+private:
+    void record(const QString &call)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_calls << call;
+    }
+
+private:
+    mutable QMutex m_mutex;
+    QStringList m_calls;
+    QList<QDBusMessage> m_pendingClaims;
+};
+
+class Tst_FingerWorker : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        // 服务放在单独的线程和连接上，FingerWorker 构造时的同步属性读取不会阻塞它
+        fake = new FakeFingerprint;
+        fake->moveToThread(&thread);
+        thread.start();
+
+        QDBusConnection conn = QDBusConnection::connectToBus(QDBusConnection::SystemBus, FakeService);
+        ASSERT_TRUE(conn.isConnected());
+        ASSERT_TRUE(conn.registerObject(FakePath, fake, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties));
+        ASSERT_TRUE(conn.registerService(FakeService));
+
+        model = new FingerModel;
+        worker = new FingerWorker(model);
+    }
+
+    void TearDown() override
+    {
+        delete worker;
+        delete model;
+
+        QDBusConnection conn = QDBusConnection::connectToBus(QDBusConnection::SystemBus, FakeService);
+        conn.unregisterService(FakeService);
+        conn.unregisterObject(FakePath);
+        QDBusConnection::disconnectFromBus(FakeService);
+
+        thread.quit();
+        thread.wait();
+        delete fake;
+    }
+
+    bool waitForCall(const QString &call)
+    {
+        return QTest::qWaitFor([this, call] { return fake->calls().contains(call); }, 3000);
+    }
+
+public:
+    QThread thread;
+    FakeFingerprint *fake = nullptr;
+    FingerModel *model = nullptr;
+    FingerWorker *worker = nullptr;
+};
+
+TEST_F(Tst_FingerWorker, lateClaimAfterCancel)
+{
+    worker->tryEnroll("alice", "finger1");
+    ASSERT_TRUE(waitForCall("Claim alice true"));
+    EXPECT_EQ(worker->enrollStage(), FingerWorker::Stage_Claiming);
+
+    worker->stopEnroll("alice");
+    EXPECT_EQ(worker->enrollStage(), FingerWorker::Stage_Idle);
+
+    // 占用请求迟到返回后释放设备，录入不会继续
+    ASSERT_TRUE(fake->replyClaim("alice"));
+    ASSERT_TRUE(waitForCall("Claim alice false"));
+    QTest::qWait(100);
+    EXPECT_FALSE(fake->calls().contains("Enroll finger1"));
+    EXPECT_EQ(worker->enrollStage(), FingerWorker::Stage_Idle);
+}
+
+TEST_F(Tst_FingerWorker, lateClaimDuringNextEnroll)
+{
+    worker->tryEnroll("alice", "finger1");
+    ASSERT_TRUE(waitForCall("Claim alice true"));
+    worker->stopEnroll("alice");
+
+    worker->tryEnroll("bob", "finger2");
+    ASSERT_TRUE(waitForCall("Claim bob true"));
+
+    // 过期的回复只释放发起占用的 alice，bob 的录入状态不变
+    ASSERT_TRUE(fake->replyClaim("alice"));
+    ASSERT_TRUE(waitForCall("Claim alice false"));
+    QTest::qWait(100);
+    EXPECT_FALSE(fake->calls().contains("Claim bob false"));
+    EXPECT_EQ(worker->enrollStage(), FingerWorker::Stage_Claiming);
+
+    ASSERT_TRUE(fake->replyClaim("bob"));
+    ASSERT_TRUE(waitForCall("Enroll finger2"));
+    EXPECT_EQ(worker->enrollStage(), FingerWorker::Stage_Enrolling);
+    EXPECT_FALSE(fake->calls().contains("Enroll finger1"));
+}
+
+#include "tst_fingerworker.moc"
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "dbustelemetry.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSignalSpy>
+#include <QStandardPaths>
+
+using namespace dcc;
+
+class Tst_DBusTelemetry : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        telemetry = DBusTelemetry::instance();
+        telemetry->reset();
+        threshold = telemetry->stallThreshold();
+    }
+
+    void TearDown() override
+    {
+        telemetry->setStallThreshold(threshold);
+        telemetry->reset();
+    }
+
+    QJsonObject methodStats(const QString &method) const
+    {
+        return telemetry->statistics().value("methods").toObject().value(method).toObject();
+    }
+
+public:
+    DBusTelemetry *telemetry = nullptr;
+    int threshold = 0;
+};
+
+TEST_F(Tst_DBusTelemetry, recordBucketsByElapsedTime)
+{
+    // 桶的上限为 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 毫秒，最后一桶收纳更慢的调用
+    telemetry->record("test.Method", 500, false);
+    telemetry->record("test.Method", 1000, false);
+    telemetry->record("test.Method", 1999, false);
+    telemetry->record("test.Method", 5000, false);
+    telemetry->record("test.Method", 999999, false);
+    telemetry->record("test.Method", 1000000, false);
+    telemetry->record("test.Method", 5000000, false);
+
+    const QJsonObject stats = methodStats("test.Method");
+    EXPECT_EQ(stats.value("count").toInt(), 7);
+    EXPECT_EQ(stats.value("sync").toInt(), 0);
+    EXPECT_EQ(stats.value("stalls").toInt(), 0);
+    EXPECT_DOUBLE_EQ(stats.value("maxMs").toDouble(), 5000.0);
+    EXPECT_DOUBLE_EQ(stats.value("totalMs").toDouble(), 7008.498);
+
+    const QJsonArray histogram = stats.value("histogram").toArray();
+    ASSERT_EQ(histogram.size(), 11);
+    const QVector<int> expected { 1, 2, 0, 1, 0, 0, 0, 0, 0, 1, 2 };
+    for (int i = 0; i < expected.size(); ++i)
+        EXPECT_EQ(histogram.at(i).toInt(), expected.at(i)) << "bucket " << i;
+
+    // 不同方法分开统计
+    telemetry->record("test.Other", 20000, false);
+    EXPECT_EQ(methodStats("test.Other").value("histogram").toArray().at(5).toInt(), 1);
+    EXPECT_EQ(methodStats("test.Method").value("count").toInt(), 7);
+}
+
+TEST_F(Tst_DBusTelemetry, syncStallOnGuiThread)
+{
+    telemetry->setStallThreshold(50);
+    QSignalSpy spy(telemetry, &DBusTelemetry::stalled);
+
+    telemetry->record("test.Sync", 49999, true);
+    telemetry->record("test.Sync", 50000, true);
+    // 异步调用不会卡住界面
+    telemetry->record("test.Sync", 80000, false);
+
+    const QJsonObject stats = methodStats("test.Sync");
+    EXPECT_EQ(stats.value("count").toInt(), 3);
+    EXPECT_EQ(stats.value("sync").toInt(), 2);
+    EXPECT_EQ(stats.value("stalls").toInt(), 1);
+
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().at(0).toString(), QString("test.Sync"));
+    EXPECT_EQ(spy.first().at(1).toLongLong(), 50);
+}
+
+TEST_F(Tst_DBusTelemetry, dumpToFileRejectsPaths)
+{
+    telemetry->record("test.Dump", 1000, false);
+
+    // 文件名可能来自 D-Bus 调用方，不能写到缓存目录之外或写成隐藏文件
+    EXPECT_TRUE(telemetry->dumpToFile("../dbus-telemetry.json").isEmpty());
+    EXPECT_TRUE(telemetry->dumpToFile("/tmp/dbus-telemetry.json").isEmpty());
+    EXPECT_TRUE(telemetry->dumpToFile("sub/dbus-telemetry.json").isEmpty());
+    EXPECT_TRUE(telemetry->dumpToFile(".dbus-telemetry.json").isEmpty());
+    EXPECT_TRUE(telemetry->dumpToFile("..").isEmpty());
+}
+
+TEST_F(Tst_DBusTelemetry, dumpToFileWritesCache)
+{
+    telemetry->record("test.Dump", 1000, false);
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    const QString defaultPath = telemetry->dumpToFile();
+    EXPECT_EQ(defaultPath, cacheDir + "/dbus-telemetry.json");
+
+    const QString path = telemetry->dumpToFile("telemetry-test.json");
+    ASSERT_EQ(path, cacheDir + "/telemetry-test.json");
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    EXPECT_EQ(json.value("methods").toObject().value("test.Dump").toObject().value("count").toInt(), 1);
+
+    QFile::remove(defaultPath);
+    QFile::remove(path);
+}
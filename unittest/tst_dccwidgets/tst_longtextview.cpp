@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+
+#include "../../include/widgets/longtextview.h"
+
+using namespace dcc::widgets;
+
+class Tst_LongTextView : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new LongTextView();
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+public:
+    LongTextView *obj = nullptr;
+};
+
+TEST_F(Tst_LongTextView, coverage)
+{
+    EXPECT_EQ(obj->heightForWidth(300), 0);
+
+    QString text;
+    for (int i = 0; i < 200; ++i)
+        text += QString("paragraph %1 of a long license text\n").arg(i);
+    obj->setText(text);
+
+    EXPECT_TRUE(obj->hasHeightForWidth());
+    EXPECT_GT(obj->heightForWidth(300), 0);
+    EXPECT_GE(obj->heightForWidth(100), obj->heightForWidth(600));
+
+    obj->resize(300, obj->heightForWidth(300));
+    EXPECT_GT(obj->sizeHint().height(), 0);
+
+    EXPECT_FALSE(obj->hasSelectedText());
+    obj->selectAll();
+    EXPECT_EQ(obj->selectedText(), text);
+
+    obj->setText("aaa");
+    EXPECT_FALSE(obj->hasSelectedText());
+    EXPECT_EQ(obj->text(), QString("aaa"));
+}
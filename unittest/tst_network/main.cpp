@@ -0,0 +1,14 @@
+#include <QApplication>
+#include <gtest/gtest.h>
+
+int main(int argc, char **argv)
+{
+    // 模拟的 NetworkManager 注册在会话总线上，需要在 dbus-run-session 下运行
+    qputenv("DBUS_SYSTEM_BUS_ADDRESS", qgetenv("DBUS_SESSION_BUS_ADDRESS"));
+
+    QApplication app(argc, argv);
+
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return  RUN_ALL_TESTS();
+}
@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include "connectioneditpage.h"
+#include "connectioncatalog.h"
+
+#include <networkmanagerqt/generictypes.h>
+
+#include <DTipLabel>
+
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMetaType>
+#include <QDBusObjectPath>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPushButton>
+#include <QSignalSpy>
+#include <QTest>
+#include <QThread>
+
+using namespace DCC_NAMESPACE::network;
+DWIDGET_USE_NAMESPACE
+
+const QString FakeService("org.freedesktop.NetworkManager");
+const QString FakeSettingsPath("/org/freedesktop/NetworkManager/Settings");
+const QString FakeConnectionPath("/org/freedesktop/NetworkManager/Settings/1");
+const QString FakeUuid("0b5b3ec2-3ad0-4b5c-9d0e-2a4b6f1c7e01");
+
+// 模拟的 NetworkManager 连接配置，记录调用顺序，Update 可以按需返回错误
+class FakeConnection : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.NetworkManager.Settings.Connection")
+    Q_PROPERTY(bool Unsaved READ unsaved)
+
+public:
+    bool unsaved() const { return false; }
+
+    QStringList calls() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_calls;
+    }
+
+    NMVariantMapMap updatedSettings() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_updated;
+    }
+
+    void reset(const QString &updateError = QString())
+    {
+        QMutexLocker locker(&m_mutex);
+        m_calls.clear();
+        m_updated.clear();
+        m_updateError = updateError;
+    }
+
+public Q_SLOTS:
+    NMVariantMapMap GetSettings()
+    {
+        // 已保存的 PPPoE 连接，密码不随配置返回
+        NMVariantMapMap settings;
+        settings["connection"] = QVariantMap {
+            { "id", "PPPoE" },
+            { "uuid", FakeUuid },
+            { "type", "pppoe" },
+            { "autoconnect", false },
+        };
+        settings["pppoe"] = QVariantMap { { "username", "user" } };
+        settings["ipv4"] = QVariantMap { { "method", "auto" } };
+        return settings;
+    }
+
+    NMVariantMapMap GetSecrets(const QString &setting)
+    {
+        record("GetSecrets " + setting);
+
+        NMVariantMapMap secrets;
+        if (setting == "pppoe")
+            secrets["pppoe"] = QVariantMap { { "password", "secret" } };
+        return secrets;
+    }
+
+    void Update(const NMVariantMapMap &settings)
+    {
+        record("Update");
+
+        QMutexLocker locker(&m_mutex);
+        m_updated = settings;
+        if (!m_updateError.isEmpty())
+            sendErrorReply("org.freedesktop.NetworkManager.Settings.Connection.PermissionDenied", m_updateError);
+    }
+
+private:
+    void record(const QString &call)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_calls << call;
+    }
+
+private:
+    mutable QMutex m_mutex;
+    QStringList m_calls;
+    NMVariantMapMap m_updated;
+    QString m_updateError;
+};
+
+class FakeSettings : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.freedesktop.NetworkManager.Settings")
+    Q_PROPERTY(QList<QDBusObjectPath> Connections READ connections)
+    Q_PROPERTY(bool CanModify READ canModify)
+    Q_PROPERTY(QString Hostname READ hostname)
+
+public:
+    QList<QDBusObjectPath> connections() const { return { QDBusObjectPath(FakeConnectionPath) }; }
+    bool canModify() const { return true; }
+    QString hostname() const { return QStringLiteral("fake"); }
+
+public Q_SLOTS:
+    QList<QDBusObjectPath> ListConnections()
+    {
+        return connections();
+    }
+};
+
+class Tst_ConnectionEditPage : public testing::Test
+{
+public:
+    static void SetUpTestCase()
+    {
+        qDBusRegisterMetaType<NMVariantMapMap>();
+        qDBusRegisterMetaType<QList<QDBusObjectPath>>();
+
+        // NetworkManagerQt 的缓存在测试之间共用，服务只注册一次；
+        // 服务放在单独的线程和连接上，Connection 构造时的同步调用不会阻塞它
+        fakeSettings = new FakeSettings;
+        fakeConnection = new FakeConnection;
+        fakeSettings->moveToThread(&thread);
+        fakeConnection->moveToThread(&thread);
+        thread.start();
+
+        QDBusConnection conn = QDBusConnection::connectToBus(QDBusConnection::SystemBus, FakeService);
+        conn.registerObject(FakeSettingsPath, fakeSettings, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties);
+        conn.registerObject(FakeConnectionPath, fakeConnection, QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllProperties);
+        conn.registerService(FakeService);
+    }
+
+    static void TearDownTestCase()
+    {
+        QDBusConnection conn = QDBusConnection::connectToBus(QDBusConnection::SystemBus, FakeService);
+        conn.unregisterService(FakeService);
+        conn.unregisterObject(FakeConnectionPath);
+        conn.unregisterObject(FakeSettingsPath);
+        QDBusConnection::disconnectFromBus(FakeService);
+
+        thread.quit();
+        thread.wait();
+        delete fakeConnection;
+        delete fakeSettings;
+    }
+
+    void SetUp() override
+    {
+        fakeConnection->reset();
+
+        ASSERT_TRUE(QTest::qWaitFor([] { return !ConnectionCatalog::instance()->connectionByUuid(FakeUuid).isNull(); }, 3000));
+        page = new ConnectionEditPage(ConnectionEditPage::PppoeConnection, QString(), FakeUuid);
+        page->initSettingsWidget();
+        page->setButtonTupleEnable(true);
+    }
+
+    void TearDown() override
+    {
+        delete page;
+        page = nullptr;
+    }
+
+    QPushButton *saveButton() const
+    {
+        for (QPushButton *button : page->findChildren<QPushButton *>()) {
+            if (button->text() == "Save")
+                return button;
+        }
+        return nullptr;
+    }
+
+    bool waitForCall(const QString &call)
+    {
+        return QTest::qWaitFor([call] { return fakeConnection->calls().contains(call); }, 3000);
+    }
+
+public:
+    static QThread thread;
+    static FakeSettings *fakeSettings;
+    static FakeConnection *fakeConnection;
+    ConnectionEditPage *page = nullptr;
+};
+
+QThread Tst_ConnectionEditPage::thread;
+FakeSettings *Tst_ConnectionEditPage::fakeSettings = nullptr;
+FakeConnection *Tst_ConnectionEditPage::fakeConnection = nullptr;
+
+TEST_F(Tst_ConnectionEditPage, saveFailedShowsErrorTip)
+{
+    fakeConnection->reset("fake update failure");
+
+    QSignalSpy failedSpy(page, &ConnectionEditPage::saveFailed);
+    QSignalSpy backSpy(page, &ConnectionEditPage::back);
+    ASSERT_TRUE(saveButton());
+    saveButton()->click();
+
+    // 保存失败时页面不返回，错误信息显示在按钮上方
+    ASSERT_TRUE(failedSpy.wait(3000));
+    const QString message = failedSpy.first().first().toString();
+    EXPECT_TRUE(message.contains("fake update failure"));
+    EXPECT_TRUE(backSpy.isEmpty());
+
+    bool tipShown = false;
+    for (DTipLabel *tip : page->findChildren<DTipLabel *>()) {
+        if (tip->text() == message && !tip->isHidden())
+            tipShown = true;
+    }
+    EXPECT_TRUE(tipShown);
+    EXPECT_TRUE(saveButton()->isEnabled());
+}
+
+TEST_F(Tst_ConnectionEditPage, saveMergesSecretsBeforeUpdate)
+{
+    QSignalSpy backSpy(page, &ConnectionEditPage::back);
+    ASSERT_TRUE(saveButton());
+    saveButton()->click();
+
+    // 页面没有显示过，保存前先取回密码，不会把密码写成空值
+    ASSERT_TRUE(backSpy.wait(3000));
+    const QStringList calls = fakeConnection->calls();
+    ASSERT_TRUE(calls.contains("GetSecrets pppoe"));
+    ASSERT_TRUE(calls.contains("Update"));
+    EXPECT_LT(calls.indexOf("GetSecrets pppoe"), calls.indexOf("Update"));
+
+    const QVariantMap pppoe = fakeConnection->updatedSettings().value("pppoe");
+    EXPECT_EQ(pppoe.value("username").toString(), QString("user"));
+    EXPECT_EQ(pppoe.value("password").toString(), QString("secret"));
+}
+
+TEST_F(Tst_ConnectionEditPage, secretsRequestedWhenPasswordShown)
+{
+    // 密码输入框显示之前不获取密码
+    QTest::qWait(100);
+    EXPECT_FALSE(fakeConnection->calls().contains("GetSecrets pppoe"));
+
+    page->show();
+    ASSERT_TRUE(waitForCall("GetSecrets pppoe"));
+    EXPECT_EQ(fakeConnection->calls().count("GetSecrets pppoe"), 1);
+}
+
+#include "tst_connectioneditpage.moc"
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include "levelmeter.h"
+
+#include <QAudioFormat>
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+
+using namespace dcc::sound;
+
+static QAudioFormat pcmFormat(QAudioFormat::SampleType type, int sampleSize)
+{
+    QAudioFormat format;
+    format.setSampleRate(16000);
+    format.setChannelCount(1);
+    format.setSampleSize(sampleSize);
+    format.setSampleType(type);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setCodec("audio/pcm");
+    return format;
+}
+
+// 生成 msec 毫秒峰值为 peak 的方波，16 位整数采样
+static QByteArray int16Samples(double peak, int msec)
+{
+    QByteArray data;
+    const qint16 value = static_cast<qint16>(peak * 32768);
+    for (int i = 0; i < 16 * msec; ++i) {
+        const qint16 sample = i % 2 ? value : static_cast<qint16>(-value);
+        data.append(reinterpret_cast<const char *>(&sample), sizeof(sample));
+    }
+    return data;
+}
+
+static QByteArray floatSamples(float peak, int msec)
+{
+    QByteArray data;
+    for (int i = 0; i < 16 * msec; ++i) {
+        const float sample = i % 2 ? peak : -peak;
+        data.append(reinterpret_cast<const char *>(&sample), sizeof(sample));
+    }
+    return data;
+}
+
+class Tst_LevelMeter : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new LevelMeter();
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+    // 等待电平回落到 0，返回期间通知的所有电平；decayMs 为开始回落到归零经过的时间
+    QList<double> levelsUntilSilent(QSignalSpy &spy, qint64 *decayMs = nullptr)
+    {
+        QList<double> levels;
+        QElapsedTimer clock;
+        qint64 decayStart = -1;
+        clock.start();
+        while (levels.isEmpty() || levels.last() > 0) {
+            if (spy.isEmpty() && !spy.wait(3000))
+                break;
+            while (!spy.isEmpty()) {
+                const double level = spy.takeFirst().first().toDouble();
+                if (decayStart < 0 && !levels.isEmpty() && level < levels.last())
+                    decayStart = clock.elapsed();
+                levels << level;
+            }
+        }
+        if (decayMs)
+            *decayMs = decayStart < 0 ? -1 : clock.elapsed() - decayStart;
+        return levels;
+    }
+
+public:
+    LevelMeter *obj = nullptr;
+};
+
+TEST_F(Tst_LevelMeter, decay)
+{
+    QBuffer source;
+    source.setData(int16Samples(0.5, 200) + int16Samples(0, 1000));
+    obj->setSource(&source, pcmFormat(QAudioFormat::SignedInt, 16));
+
+    QSignalSpy spy(obj, &LevelMeter::levelChanged);
+    obj->start();
+    EXPECT_TRUE(obj->isActive());
+
+    qint64 decayMs = 0;
+    const QList<double> levels = levelsUntilSilent(spy, &decayMs);
+    ASSERT_GE(levels.size(), 3);
+    EXPECT_NEAR(levels.at(0), 0.5, 1e-3);
+    // 峰值持续期间电平不变，之后逐帧回落
+    EXPECT_LT(levels.at(1), 0.5);
+    for (int i = 1; i < levels.size(); ++i)
+        EXPECT_LT(levels.at(i), levels.at(i - 1));
+    EXPECT_EQ(levels.last(), 0.0);
+    // 衰减按时间计算，从 0.5 回落到阈值以下约 1 秒，与帧率无关
+    EXPECT_GT(decayMs, 700);
+    EXPECT_LT(decayMs, 2500);
+}
+
+TEST_F(Tst_LevelMeter, attack)
+{
+    QBuffer source;
+    source.setData(int16Samples(0.1, 200) + int16Samples(0.8, 200) + int16Samples(0, 1500));
+    obj->setSource(&source, pcmFormat(QAudioFormat::SignedInt, 16));
+
+    QSignalSpy spy(obj, &LevelMeter::levelChanged);
+    obj->start();
+
+    // 峰值升高时立即跟随，不经过中间值
+    const QList<double> levels = levelsUntilSilent(spy);
+    ASSERT_GE(levels.size(), 2);
+    EXPECT_NEAR(levels.at(0), 0.1, 1e-3);
+    EXPECT_NEAR(levels.at(1), 0.8, 1e-3);
+    EXPECT_NEAR(obj->level(), 0.0, 1e-9);
+}
+
+TEST_F(Tst_LevelMeter, floatSource)
+{
+    QBuffer source;
+    source.setData(floatSamples(0.25f, 200));
+    obj->setSource(&source, pcmFormat(QAudioFormat::Float, 32));
+
+    QSignalSpy spy(obj, &LevelMeter::levelChanged);
+    obj->start();
+    ASSERT_TRUE(spy.wait(3000));
+    EXPECT_NEAR(spy.first().first().toDouble(), 0.25, 1e-3);
+
+    obj->stop();
+    EXPECT_FALSE(obj->isActive());
+    EXPECT_EQ(obj->level(), 0.0);
+}
+
+TEST_F(Tst_LevelMeter, unsupportedFormat)
+{
+    QBuffer source;
+    source.setData(QByteArray(1600, '\x7f'));
+    obj->setSource(&source, pcmFormat(QAudioFormat::UnSignedInt, 8));
+
+    obj->start();
+    EXPECT_FALSE(obj->isActive());
+}
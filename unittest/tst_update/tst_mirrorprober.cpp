@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include "mirrorprober.h"
+#include "updatemodel.h"
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace dcc::update;
+
+// 监听队列长度为 0 且已被占满的本地端口，新连接的 SYN 会被内核丢弃，
+// 调用 acceptPending() 腾出队列后要等客户端重传 SYN（约 1 秒）才能建立连接
+class DelayedListener
+{
+public:
+    DelayedListener()
+    {
+        m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+        ::listen(m_fd, 0);
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(m_fd, reinterpret_cast<sockaddr *>(&addr), &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_filler.connectToHost(QHostAddress::LocalHost, m_port);
+        m_filler.waitForConnected(1000);
+    }
+
+    ~DelayedListener()
+    {
+        for (int fd : m_accepted)
+            ::close(fd);
+        ::close(m_fd);
+    }
+
+    quint16 port() const { return m_port; }
+
+    void acceptPending()
+    {
+        const int fd = ::accept(m_fd, nullptr, nullptr);
+        if (fd >= 0)
+            m_accepted << fd;
+    }
+
+private:
+    int m_fd;
+    quint16 m_port;
+    QTcpSocket m_filler;
+    QList<int> m_accepted;
+};
+
+static QString localUrl(quint16 port)
+{
+    return QString("http://127.0.0.1:%1/deepin").arg(port);
+}
+
+static quint16 closedPort()
+{
+    QTcpServer server;
+    server.listen(QHostAddress::LocalHost);
+    const quint16 port = server.serverPort();
+    server.close();
+    return port;
+}
+
+class Tst_MirrorProber : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new MirrorProber();
+        QObject::connect(obj, &MirrorProber::probed, [this](const QString &id, int latency) {
+            order << id;
+            results.insert(id, latency);
+        });
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+public:
+    MirrorProber *obj = nullptr;
+    QStringList order;
+    QMap<QString, int> results;
+};
+
+TEST_F(Tst_MirrorProber, ordering)
+{
+    QTcpServer fast;
+    ASSERT_TRUE(fast.listen(QHostAddress::LocalHost));
+    DelayedListener slow;
+
+    obj->setTimeout(3000);
+    QSignalSpy finished(obj, &MirrorProber::finished);
+    QTimer::singleShot(200, [&slow] { slow.acceptPending(); });
+    obj->probe({{"fast", localUrl(fast.serverPort())},
+                {"slow", localUrl(slow.port())},
+                {"closed", localUrl(closedPort())}});
+
+    ASSERT_TRUE(finished.wait(5000));
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_LT(order.indexOf("fast"), order.indexOf("slow"));
+    EXPECT_LT(results["fast"], results["slow"]);
+    EXPECT_GE(results["slow"], 500);
+    EXPECT_LT(results["slow"], MirrorTimeoutSpeed);
+    EXPECT_EQ(results["closed"], MirrorTimeoutSpeed);
+}
+
+TEST_F(Tst_MirrorProber, timeout)
+{
+    DelayedListener slow;
+
+    obj->setTimeout(300);
+    QSignalSpy finished(obj, &MirrorProber::finished);
+    QElapsedTimer elapsed;
+    elapsed.start();
+    obj->probe({{"slow", localUrl(slow.port())},
+                {"invalid", "deepin"}});
+
+    ASSERT_TRUE(finished.wait(5000));
+    EXPECT_LT(elapsed.elapsed(), 1000);
+    EXPECT_EQ(results["slow"], MirrorTimeoutSpeed);
+    EXPECT_EQ(results["invalid"], MirrorTimeoutSpeed);
+}
+
+TEST_F(Tst_MirrorProber, concurrency)
+{
+    QTcpServer fast;
+    ASSERT_TRUE(fast.listen(QHostAddress::LocalHost));
+    DelayedListener slow;
+
+    // 只有一个并发时，排在后面的镜像要等前一个超时后才开始探测
+    obj->setConcurrency(1);
+    obj->setTimeout(300);
+    QSignalSpy finished(obj, &MirrorProber::finished);
+    obj->probe({{"a-slow", localUrl(slow.port())},
+                {"b-fast", localUrl(fast.serverPort())}});
+
+    ASSERT_TRUE(finished.wait(5000));
+    EXPECT_EQ(order, QStringList({"a-slow", "b-fast"}));
+    EXPECT_EQ(results["a-slow"], MirrorTimeoutSpeed);
+    EXPECT_LT(results["b-fast"], MirrorTimeoutSpeed);
+}
+
+TEST(Tst_UpdateModel, mirrorSpeedCache)
+{
+    UpdateModel model;
+    model.updateMirrorSpeed("fast", 20);
+    model.updateMirrorSpeed("closed", MirrorTimeoutSpeed);
+
+    EXPECT_EQ(model.mirrorSpeedInfo().value("closed"), MirrorTimeoutSpeed);
+
+    // 超时的结果不缓存
+    const QMap<QString, int> cached = model.cachedMirrorSpeed(60 * 1000);
+    EXPECT_EQ(cached.size(), 1);
+    EXPECT_EQ(cached.value("fast"), 20);
+
+    // 超过有效期后不再返回
+    QThread::msleep(50);
+    EXPECT_TRUE(model.cachedMirrorSpeed(20).isEmpty());
+    EXPECT_EQ(model.cachedMirrorSpeed(60 * 1000).size(), 1);
+
+    // 重新测速超时后清除旧的缓存
+    model.updateMirrorSpeed("fast", MirrorTimeoutSpeed);
+    EXPECT_TRUE(model.cachedMirrorSpeed(60 * 1000).isEmpty());
+}